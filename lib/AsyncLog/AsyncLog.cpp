@@ -0,0 +1,183 @@
+#include "AsyncLog.h"
+
+// Static member initialization
+Print* AsyncLog::output = nullptr;
+LogRecord AsyncLog::ring[LOG_RING_RECORDS];
+uint16_t AsyncLog::head = 0;
+uint16_t AsyncLog::tail = 0;
+volatile uint32_t AsyncLog::droppedCount = 0;
+uint32_t AsyncLog::reportedDrops = 0;
+portMUX_TYPE AsyncLog::ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Start the drain task
+bool AsyncLog::begin(Print& out) {
+  output = &out;
+  return xTaskCreate(drainTask, "log_drain", LOG_DRAIN_TASK_STACK, nullptr,
+                     LOG_DRAIN_TASK_PRIORITY, nullptr) == pdPASS;
+}
+
+// Store one record; the critical section only covers the copy into the ring
+bool AsyncLog::write(uint8_t level, const char* format, const LogArg* args, uint8_t count) {
+  bool stored = false;
+
+  portENTER_CRITICAL(&ringMux);
+  uint16_t next = (tail + 1) % LOG_RING_RECORDS;
+  if (next == head) {
+    droppedCount++;
+  } else {
+    LogRecord& record = ring[tail];
+    record.format = format;
+    record.level = level;
+    record.argCount = count;
+    for (uint8_t i = 0; i < count; i++) {
+      record.values[i] = args[i].value;
+      record.types[i] = args[i].type;
+    }
+    tail = next;
+    stored = true;
+  }
+  portEXIT_CRITICAL(&ringMux);
+  return stored;
+}
+
+// Take the oldest record out of the ring
+bool AsyncLog::pop(LogRecord& record) {
+  bool found = false;
+  portENTER_CRITICAL(&ringMux);
+  if (head != tail) {
+    record = ring[head];
+    head = (head + 1) % LOG_RING_RECORDS;
+    found = true;
+  }
+  portEXIT_CRITICAL(&ringMux);
+  return found;
+}
+
+// Format and emit everything buffered
+void AsyncLog::flush() {
+  if (output == nullptr) return;
+
+  LogRecord record;
+  while (pop(record)) {
+    emit(record);
+  }
+
+  uint32_t drops = droppedCount;
+  if (drops != reportedDrops) {
+    output->printf("[log] %lu records dropped (ring full)\n", (unsigned long)(drops - reportedDrops));
+    reportedDrops = drops;
+  }
+}
+
+// Drain task: format records at low priority, away from the tasks that logged them
+void AsyncLog::drainTask(void* param) {
+  while (true) {
+    flush();
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_INTERVAL_MS));
+  }
+}
+
+// Format one record as a line: each conversion is formatted with snprintf
+// using the argument converted to what the conversion expects
+void AsyncLog::emit(const LogRecord& record) {
+  static const char LEVEL_TAGS[] = {' ', 'E', 'W', 'I', 'D'};
+  char line[192];
+  size_t used = 0;
+  uint8_t arg = 0;
+
+  if (record.level != LOG_LEVEL_INFO && record.level <= LOG_LEVEL_DEBUG) {
+    used += snprintf(line, sizeof(line), "[%c] ", LEVEL_TAGS[record.level]);
+  }
+
+  for (const char* p = record.format; *p && used < sizeof(line) - 1; p++) {
+    if (*p != '%') {
+      line[used++] = *p;
+      continue;
+    }
+    if (p[1] == '%') {
+      line[used++] = '%';
+      p++;
+      continue;
+    }
+
+    // Copy the conversion spec (flags, width, precision, conversion character)
+    char spec[16];
+    uint8_t len = 0;
+    spec[len++] = *p++;
+    while (*p && strchr("-+ #0123456789.l", *p) && len < sizeof(spec) - 3) spec[len++] = *p++;
+    if (!*p) break;
+    char conversion = *p;
+    spec[len++] = conversion;
+    spec[len] = '\0';
+
+    size_t room = sizeof(line) - used;
+    LogValue value;
+    value.u = 0;
+    LogArgType type = LOG_ARG_UINT;
+    if (arg < record.argCount) {
+      value = record.values[arg];
+      type = record.types[arg];
+    }
+    arg++;
+
+    // The argument as each kind of conversion expects it
+    int32_t asInt;
+    uint32_t asUnsigned;
+    float asFloat;
+    switch (type) {
+      case LOG_ARG_INT:
+        asInt = value.i;
+        asUnsigned = (uint32_t)value.i;
+        asFloat = (float)value.i;
+        break;
+      case LOG_ARG_FLOAT:
+        asInt = (int32_t)value.f;
+        asUnsigned = (uint32_t)asInt;
+        asFloat = value.f;
+        break;
+      default:
+        asInt = (int32_t)value.u;
+        asUnsigned = value.u;
+        asFloat = (float)value.u;
+        break;
+    }
+
+    // Drop any 'l' length modifier: values are passed as int/unsigned/double below
+    char* l = strchr(spec, 'l');
+    while (l) {
+      memmove(l, l + 1, strlen(l));
+      l = strchr(spec, 'l');
+    }
+
+    int written;
+    switch (conversion) {
+      case 'd':
+      case 'i':
+      case 'c':
+        written = snprintf(line + used, room, spec, (int)asInt);
+        break;
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+        written = snprintf(line + used, room, spec, (unsigned)asUnsigned);
+        break;
+      case 'f':
+      case 'e':
+      case 'g':
+        written = snprintf(line + used, room, spec, (double)asFloat);
+        break;
+      case 's':
+        written = snprintf(line + used, room, spec,
+                           type == LOG_ARG_STRING && value.s ? value.s : "?");
+        break;
+      default:
+        written = snprintf(line + used, room, "%s", spec);
+        break;
+    }
+    if (written > 0) used += min((size_t)written, room - 1);
+  }
+
+  line[used] = '\0';
+  output->println(line);
+}
@@ -0,0 +1,151 @@
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <Arduino.h>
+
+// ===== ASYNC LOG =====
+// Serial at 115200 baud moves ~11 characters per millisecond, so a few lines of
+// Serial.print() in a packet handler or animation step stall the caller for tens
+// of milliseconds. Log calls here only store a small binary record in a ring
+// buffer: the format string's address (the string stays in flash, so the pointer
+// is its ID) plus up to LOG_MAX_ARGS raw argument values. A low-priority drain
+// task formats the records and writes them to Serial. When the ring is full the
+// record is dropped and counted; a log call never blocks.
+//
+// Formats are printf-style; each conversion (%d %u %x %c %f %s, with flags,
+// width and precision) consumes one argument. %s arguments must point at strings
+// that outlive the record (literals, name tables) - the text is not copied.
+
+// ===== LOG LEVELS =====
+// Calls above LOG_LEVEL compile to nothing (set with -DLOG_LEVEL=...)
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// ===== CONFIGURATION =====
+
+#define LOG_MAX_ARGS 10              // Arguments per record
+#define LOG_RING_RECORDS 64          // Records buffered between drains
+#define LOG_DRAIN_INTERVAL_MS 20     // Drain task wake-up period
+#define LOG_DRAIN_TASK_STACK 3072
+#define LOG_DRAIN_TASK_PRIORITY 1    // Same as loop(), below the WiFi and display tasks
+
+// ===== RECORDS =====
+
+enum LogArgType : uint8_t {
+  LOG_ARG_INT,
+  LOG_ARG_UINT,
+  LOG_ARG_FLOAT,
+  LOG_ARG_STRING
+};
+
+// Raw argument value; LogArgType says which member is set
+union LogValue {
+  int32_t i;
+  uint32_t u;
+  float f;
+  const char* s;
+};
+
+// One argument, captured by value
+struct LogArg {
+  LogValue value;
+  LogArgType type;
+
+  LogArg() : type(LOG_ARG_UINT) { value.u = 0; }
+  LogArg(signed char v) : type(LOG_ARG_INT) { value.i = v; }
+  LogArg(short v) : type(LOG_ARG_INT) { value.i = v; }
+  LogArg(int v) : type(LOG_ARG_INT) { value.i = v; }
+  LogArg(long v) : type(LOG_ARG_INT) { value.i = v; }
+  LogArg(char v) : type(LOG_ARG_INT) { value.i = v; }
+  LogArg(unsigned char v) : type(LOG_ARG_UINT) { value.u = v; }
+  LogArg(unsigned short v) : type(LOG_ARG_UINT) { value.u = v; }
+  LogArg(unsigned int v) : type(LOG_ARG_UINT) { value.u = v; }
+  LogArg(unsigned long v) : type(LOG_ARG_UINT) { value.u = v; }
+  LogArg(bool v) : type(LOG_ARG_UINT) { value.u = v; }
+  LogArg(float v) : type(LOG_ARG_FLOAT) { value.f = v; }
+  LogArg(double v) : type(LOG_ARG_FLOAT) { value.f = (float)v; }
+  LogArg(const char* v) : type(LOG_ARG_STRING) { value.s = v; }
+};
+
+// A log call as stored in the ring
+struct LogRecord {
+  const char* format;        // Format string (in flash): the record's format ID
+  LogValue values[LOG_MAX_ARGS];
+  LogArgType types[LOG_MAX_ARGS];
+  uint8_t level;
+  uint8_t argCount;
+};
+
+// ===== LOGGER =====
+
+class AsyncLog {
+public:
+  // Start the drain task writing to `out`; records logged before this are kept
+  static bool begin(Print& out = Serial);
+
+  // Store one record (any task, not from ISRs); false if the ring was full
+  static bool write(uint8_t level, const char* format, const LogArg* args, uint8_t count);
+
+  // Format and emit everything buffered, in the calling task (e.g. before a reboot)
+  static void flush();
+
+  // Records dropped because the ring was full (since boot)
+  static uint32_t dropped() { return droppedCount; }
+
+private:
+  static void drainTask(void* param);
+  static bool pop(LogRecord& record);
+  static void emit(const LogRecord& record);
+
+  static Print* output;
+  static LogRecord ring[LOG_RING_RECORDS];
+  static uint16_t head;               // Next record to emit
+  static uint16_t tail;               // Next free slot
+  static volatile uint32_t droppedCount;
+  static uint32_t reportedDrops;      // droppedCount at the last drop notice
+  static portMUX_TYPE ringMux;
+};
+
+// Capture the arguments and store a record
+template <typename... Args>
+inline void logRecord(uint8_t level, const char* format, Args... args) {
+  static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments (LOG_MAX_ARGS)");
+  const LogArg packed[sizeof...(Args) + 1] = {LogArg(args)...};
+  AsyncLog::write(level, format, packed, sizeof...(Args));
+}
+
+// ===== LOG MACROS =====
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) logRecord(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) logRecord(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) logRecord(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) logRecord(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+
+#endif // ASYNC_LOG_H
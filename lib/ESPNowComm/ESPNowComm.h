@@ -13,6 +13,9 @@
 // Number of hands per pixel
 #define HANDS_PER_PIXEL 3
 
+// Pixels are laid out in rows of GRID_COLUMNS: row = id / GRID_COLUMNS, column = id % GRID_COLUMNS
+#define GRID_COLUMNS 8
+
 // Broadcast MAC address (all pixels listen to this)
 static const uint8_t BROADCAST_MAC[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
 
@@ -33,7 +36,14 @@ enum CommandType : uint8_t {
   CMD_GET_VERSION = 0x09,     // Request pixels to display their version
   CMD_VERSION_RESPONSE = 0x0A,// Pixel responds with version info
   CMD_OTA_START = 0x0B,       // Tell specific pixel to start OTA download (sequential orchestration)
-  CMD_DISCOVERY_RESPONSE = 0x0C // Pixel responds to discovery request (CRITICAL: separate from CMD_DISCOVERY to prevent infinite loop!)
+  CMD_DISCOVERY_RESPONSE = 0x0C, // Pixel responds to discovery request (CRITICAL: separate from CMD_DISCOVERY to prevent infinite loop!)
+  CMD_GET_PROFILE = 0x0D,     // Request a pixel's frame stage profile
+  CMD_PROFILE_RESPONSE = 0x0E,// Pixel responds with its stage timing summary
+  CMD_QUEUE_KEYFRAMES = 0x0F, // Queue keyframes for a pixel to play back on its own clock
+  CMD_STREAM_TARGETS = 0x10,  // Streamed hand angles (samples of a continuous motion)
+  CMD_UPLOAD_EASING = 0x11,   // Upload a custom easing curve into a slot on every pixel
+  CMD_SPIN_HANDS = 0x12,      // Spin hands at a constant angular velocity on the pixels' own clocks
+  CMD_GRID_PATTERN = 0x13     // Angle command given as functions of row/column, evaluated by each pixel
 };
 
 // Transition/easing types (matches pixel's EasingType enum)
@@ -45,9 +55,21 @@ enum TransitionType : uint8_t {
   TRANSITION_BACK_IN = 4,
   TRANSITION_BACK_OUT = 5,
   TRANSITION_BACK_IN_OUT = 6,
-  TRANSITION_INSTANT = 7
+  TRANSITION_INSTANT = 7,
+  TRANSITION_SPRING = 8,     // Damped spring: no fixed duration, keeps velocity when retargeted
+  TRANSITION_CUSTOM_1 = 9,   // Uploaded curves (CMD_UPLOAD_EASING slots 0-3); linear until uploaded
+  TRANSITION_CUSTOM_2 = 10,
+  TRANSITION_CUSTOM_3 = 11,
+  TRANSITION_CUSTOM_4 = 12
 };
 
+// Custom easing curve slots (TRANSITION_CUSTOM_1 + slot)
+#define EASING_SLOTS 4
+
+inline bool isCustomTransition(TransitionType transition) {
+  return transition >= TRANSITION_CUSTOM_1 && transition < TRANSITION_CUSTOM_1 + EASING_SLOTS;
+}
+
 // Direction for hand rotation
 enum RotationDirection : uint8_t {
   DIR_SHORTEST = 0,  // Choose shortest path (default)
@@ -55,6 +77,12 @@ enum RotationDirection : uint8_t {
   DIR_CCW = 2        // Counter-clockwise
 };
 
+// Angle commands pack extra whole turns above the direction (bits 2-5 of a
+// direction byte), so a multi-turn sweep is still one transition
+#define DIR_MASK 0x03
+#define DIR_TURNS_SHIFT 2
+#define MAX_EXTRA_TURNS 15
+
 // Compact angle representation (0-255 maps to 0-360 degrees)
 // This saves bandwidth: 1 byte vs 4 bytes for float
 typedef uint8_t angle_t;
@@ -91,19 +119,37 @@ inline float durationToFloat(duration_t duration) {
   return duration * 0.25f;
 }
 
+// Per-pixel start delays of an angle command: slot (0-7) x step, step in 2 ms units
+#define START_DELAY_UNIT_MS 2
+#define START_DELAY_MAX_SLOT 7
+
+// Spring of TRANSITION_SPRING hands (when the packet leaves it at 0)
+#define SPRING_DEFAULT_FREQUENCY_HZ 1.5f
+#define SPRING_DEFAULT_DAMPING_RATIO 1.0f  // Critically damped: no overshoot
+
 // Command packet for setting angles
-// Total size: 1 + 1 + 1 + 72 + 72 + 24 + 24 + 3 + 21 = 219 bytes (under ESP-NOW's 250 byte limit)
+// Total size: 1 + 1 + 1 + 72 + 72 + 24 + 24 + 3 + 1 + 9 + 1 + 2 + 3 + 1 + 1 + 1 + 1 + 3 = 221 bytes (under ESP-NOW's 250 byte limit)
 struct __attribute__((packed)) AngleCommandPacket {
   CommandType command;              // 1 byte: Command type (CMD_SET_ANGLES)
   TransitionType transition;        // 1 byte: Transition/easing type
   duration_t duration;              // 1 byte: Transition duration (0-60 seconds)
   angle_t angles[MAX_PIXELS][HANDS_PER_PIXEL];  // 72 bytes: Target angles for all pixels
-  RotationDirection directions[MAX_PIXELS][HANDS_PER_PIXEL]; // 72 bytes: Rotation directions
+  RotationDirection directions[MAX_PIXELS][HANDS_PER_PIXEL]; // 72 bytes: Rotation directions (and extra turns above DIR_MASK)
   uint8_t colorIndices[MAX_PIXELS]; // 24 bytes: Color palette index for each pixel
   uint8_t opacities[MAX_PIXELS];    // 24 bytes: Opacity for each pixel (0-255)
   uint8_t targetMask[3];            // 3 bytes: Bitmask for which pixels should respond (24 bits)
                                     //          Bit N = Pixel N (0-23). All zeros = target all pixels
-  uint8_t reserved[21];             // 21 bytes: Reserved for future use
+  uint8_t startDelayStep;           // 1 byte: Start delay step in START_DELAY_UNIT_MS units (0 = no delays)
+  uint8_t startDelaySlots[9];       // 9 bytes: Start delay slot per pixel, 3 bits each (pixel N at bit 3*N)
+                                    //          Pixel N starts slot * step after receiving the command
+  uint8_t handTimingMask;           // 1 byte: Bit H = hand H uses handEasings/handDurations (0 = packet's)
+  uint8_t handEasings[2];           // 2 bytes: TransitionType per hand, 4 bits each (hand H at bit 4*H)
+  duration_t handDurations[HANDS_PER_PIXEL]; // 3 bytes: Duration per hand (same for all pixels)
+  uint8_t springFrequency;          // 1 byte: Spring natural frequency in 0.1 Hz (0 = default)
+  uint8_t springDamping;            // 1 byte: Spring damping ratio in 1/100 (0 = default)
+  uint8_t waypointMask;             // 1 byte: Bit H = hand H passes through waypoints[H] on the way
+  uint8_t waypointDirections;       // 1 byte: RotationDirection from the waypoint on, 2 bits per hand
+  angle_t waypoints[HANDS_PER_PIXEL]; // 3 bytes: Waypoint per hand (same for all pixels)
 
   // Helper to set angles for a specific pixel
   void setPixelAngles(uint8_t pixelIndex, float angle1, float angle2, float angle3,
@@ -132,12 +178,29 @@ struct __attribute__((packed)) AngleCommandPacket {
   // Helper to get directions for a specific pixel
   void getPixelDirections(uint8_t pixelIndex, RotationDirection &dir1, RotationDirection &dir2, RotationDirection &dir3) const {
     if (pixelIndex < MAX_PIXELS) {
-      dir1 = directions[pixelIndex][0];
-      dir2 = directions[pixelIndex][1];
-      dir3 = directions[pixelIndex][2];
+      dir1 = (RotationDirection)(directions[pixelIndex][0] & DIR_MASK);
+      dir2 = (RotationDirection)(directions[pixelIndex][1] & DIR_MASK);
+      dir3 = (RotationDirection)(directions[pixelIndex][2] & DIR_MASK);
+    }
+  }
+
+  // Extra whole turns a pixel's hands make on the way to their targets (0-15)
+  // Call after setPixelAngles (which clears them)
+  void setPixelTurns(uint8_t pixelIndex, uint8_t turns1, uint8_t turns2, uint8_t turns3) {
+    if (pixelIndex < MAX_PIXELS) {
+      const uint8_t turns[HANDS_PER_PIXEL] = {turns1, turns2, turns3};
+      for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+        uint8_t t = turns[h] > MAX_EXTRA_TURNS ? MAX_EXTRA_TURNS : turns[h];
+        directions[pixelIndex][h] = (RotationDirection)((directions[pixelIndex][h] & DIR_MASK) | (t << DIR_TURNS_SHIFT));
+      }
     }
   }
 
+  uint8_t getPixelTurns(uint8_t pixelIndex, uint8_t hand) const {
+    if (pixelIndex >= MAX_PIXELS || hand >= HANDS_PER_PIXEL) return 0;
+    return (directions[pixelIndex][hand] >> DIR_TURNS_SHIFT) & MAX_EXTRA_TURNS;
+  }
+
   // Helper to set color and opacity for a specific pixel
   void setPixelStyle(uint8_t pixelIndex, uint8_t colorIndex, uint8_t opacity) {
     if (pixelIndex < MAX_PIXELS) {
@@ -215,6 +278,125 @@ struct __attribute__((packed)) AngleCommandPacket {
     }
     return count;
   }
+
+  // Clear the optional fields after the target mask (start delays, per-hand
+  // timing, spring, waypoints): every pixel starts on receipt, all hands
+  // use the packet's transition and duration and go straight to their targets.
+  // Senders must call this before setting any of them.
+  void clearExtensions() {
+    memset(&startDelayStep, 0, sizeof(AngleCommandPacket) - offsetof(AngleCommandPacket, startDelayStep));
+  }
+
+  // ===== START DELAY HELPERS =====
+  // A wave (pixels starting one group after another) fits in one packet: each
+  // pixel gets a slot 0-7 and starts slot * step after it receives the command.
+
+  // Set the step between slots (rounded to START_DELAY_UNIT_MS, at most 510 ms)
+  void setStartDelayStep(uint16_t stepMs) {
+    uint16_t units = (stepMs + START_DELAY_UNIT_MS / 2) / START_DELAY_UNIT_MS;
+    startDelayStep = units > 255 ? 255 : units;
+  }
+
+  // Set the delay slot of a specific pixel (0-7)
+  void setPixelStartSlot(uint8_t pixelIndex, uint8_t slot) {
+    if (pixelIndex < MAX_PIXELS) {
+      if (slot > START_DELAY_MAX_SLOT) slot = START_DELAY_MAX_SLOT;
+      for (uint8_t b = 0; b < 3; b++) {
+        uint8_t bit = pixelIndex * 3 + b;
+        if (slot & (1 << b)) {
+          startDelaySlots[bit / 8] |= (1 << (bit % 8));
+        } else {
+          startDelaySlots[bit / 8] &= ~(1 << (bit % 8));
+        }
+      }
+    }
+  }
+
+  // Get the delay slot of a specific pixel
+  uint8_t getPixelStartSlot(uint8_t pixelIndex) const {
+    uint8_t slot = 0;
+    if (pixelIndex < MAX_PIXELS) {
+      for (uint8_t b = 0; b < 3; b++) {
+        uint8_t bit = pixelIndex * 3 + b;
+        if (startDelaySlots[bit / 8] & (1 << (bit % 8))) slot |= (1 << b);
+      }
+    }
+    return slot;
+  }
+
+  // Start delay of a specific pixel in milliseconds
+  uint16_t getPixelStartDelayMs(uint8_t pixelIndex) const {
+    return (uint16_t)getPixelStartSlot(pixelIndex) * startDelayStep * START_DELAY_UNIT_MS;
+  }
+
+  // ===== PER-HAND TIMING HELPERS =====
+  // Hands within a pixel can move with their own easing and duration (staggered
+  // motion); colors and opacity always follow the packet's duration.
+
+  // Give a hand its own transition and duration (applies to every pixel)
+  void setHandTiming(uint8_t hand, TransitionType handTransition, float seconds) {
+    if (hand < HANDS_PER_PIXEL) {
+      uint8_t shift = (hand % 2) * 4;
+      handEasings[hand / 2] = (handEasings[hand / 2] & ~(0x0F << shift)) | ((handTransition & 0x0F) << shift);
+      handDurations[hand] = floatToDuration(seconds);
+      handTimingMask |= (1 << hand);
+    }
+  }
+
+  // Transition a hand uses
+  TransitionType getHandTransition(uint8_t hand) const {
+    if (hand >= HANDS_PER_PIXEL || !(handTimingMask & (1 << hand))) return transition;
+    return (TransitionType)((handEasings[hand / 2] >> ((hand % 2) * 4)) & 0x0F);
+  }
+
+  // Duration a hand uses
+  duration_t getHandDuration(uint8_t hand) const {
+    if (hand >= HANDS_PER_PIXEL || !(handTimingMask & (1 << hand))) return duration;
+    return handDurations[hand];
+  }
+
+  // ===== SPRING HELPERS =====
+  // TRANSITION_SPRING hands ignore their duration: they move until the spring
+  // settles. Frequency sets how fast (0.1-25.5 Hz; pixels cap it), the damping
+  // ratio how much they overshoot (1.0 none, lower rings).
+
+  // Set the spring of every TRANSITION_SPRING hand in the packet
+  void setSpring(float frequencyHz, float dampingRatio) {
+    float frequency = frequencyHz * 10.0f + 0.5f;
+    float damping = dampingRatio * 100.0f + 0.5f;
+    springFrequency = frequency < 1.0f ? 1 : (frequency > 255.0f ? 255 : (uint8_t)frequency);
+    springDamping = damping < 1.0f ? 1 : (damping > 255.0f ? 255 : (uint8_t)damping);
+  }
+
+  float getSpringFrequencyHz() const {
+    return springFrequency ? springFrequency / 10.0f : SPRING_DEFAULT_FREQUENCY_HZ;
+  }
+
+  float getSpringDampingRatio() const {
+    return springDamping ? springDamping / 100.0f : SPRING_DEFAULT_DAMPING_RATIO;
+  }
+
+  // ===== WAYPOINT HELPERS =====
+  // A hand with a waypoint travels to it (in its pixel's direction, with its extra
+  // turns), then on to its target in the waypoint direction, all in one eased
+  // transition. The waypoint is per hand and shared by every pixel.
+
+  void setHandWaypoint(uint8_t hand, float degrees, RotationDirection dirAfter) {
+    if (hand < HANDS_PER_PIXEL) {
+      uint8_t shift = hand * 2;
+      waypoints[hand] = floatToAngle(degrees);
+      waypointDirections = (waypointDirections & ~(DIR_MASK << shift)) | ((dirAfter & DIR_MASK) << shift);
+      waypointMask |= (1 << hand);
+    }
+  }
+
+  bool hasWaypoint(uint8_t hand) const {
+    return hand < HANDS_PER_PIXEL && (waypointMask & (1 << hand));
+  }
+
+  RotationDirection getWaypointDirection(uint8_t hand) const {
+    return (RotationDirection)((waypointDirections >> (hand * 2)) & DIR_MASK);
+  }
 };
 
 // Simple ping packet
@@ -314,6 +496,351 @@ struct __attribute__((packed)) VersionResponsePacket {
   uint8_t versionMinor;          // Minor version (e.g., 2 in "1.2")
 };
 
+// ===== PROFILE PACKETS =====
+
+// Frame stages reported by pixels built with USE_STAGE_PROFILER, in order
+#define PROFILE_MAX_STAGES 5
+
+// Get profile command - master asks one pixel for its frame stage histograms
+struct __attribute__((packed)) GetProfilePacket {
+  CommandType command;           // CMD_GET_PROFILE
+  uint8_t targetPixelId;         // Pixel to report (one at a time, responses are not staggered)
+  bool printOnPixel;             // If true, pixel also prints the profile on its serial log
+  bool reset;                    // If true, pixel clears its histograms after reporting
+};
+
+// One stage's frame times since boot or the last reset (microseconds, 65535 = longer)
+struct __attribute__((packed)) ProfileStageSummary {
+  uint32_t samples;
+  uint16_t p50Us;
+  uint16_t p95Us;
+  uint16_t p99Us;
+  uint32_t maxUs;
+};
+
+// Profile response packet - pixel reports its stage timing summary
+struct __attribute__((packed)) ProfileResponsePacket {
+  CommandType command;           // CMD_PROFILE_RESPONSE
+  uint8_t pixelId;               // Pixel reporting
+  uint8_t stageCount;            // 0 = built without the profiler
+  ProfileStageSummary stages[PROFILE_MAX_STAGES];  // update, damage, raster, push, frame
+};
+
+// Name of a reported stage
+inline const char* getProfileStageName(uint8_t stage) {
+  static const char* const names[PROFILE_MAX_STAGES] = {"update", "damage", "raster", "push", "frame"};
+  return stage < PROFILE_MAX_STAGES ? names[stage] : "?";
+}
+
+// ===== KEYFRAME PACKETS =====
+// A pixel's choreography sent ahead of time: the pixel queues the keyframes and
+// plays them back locally, each starting delayMs after the previous one ends.
+
+#define KEYFRAMES_PER_PACKET 20
+#define KEYFRAME_REPLACE 0x01        // Flag: drop the queue (and its schedule) before adding
+
+// One keyframe - 11 bytes
+struct __attribute__((packed)) KeyframeEntry {
+  angle_t angles[HANDS_PER_PIXEL];   // Target angles
+  uint8_t directions;                // RotationDirection per hand, 2 bits each (hand 0 in bits 0-1)
+  uint8_t colorIndex;                // Color palette index
+  uint8_t opacity;                   // Opacity (0-255)
+  TransitionType transition;         // Easing (TRANSITION_SPRING: the default spring)
+  uint16_t durationMs;               // Transition duration (a spring's colors only)
+  uint16_t delayMs;                  // Gap after the previous keyframe ends (0 = back-to-back)
+
+  void setDirections(RotationDirection dir1, RotationDirection dir2, RotationDirection dir3) {
+    directions = (dir1 & 0x03) | ((dir2 & 0x03) << 2) | ((dir3 & 0x03) << 4);
+  }
+
+  RotationDirection getDirection(uint8_t hand) const {
+    return (RotationDirection)((directions >> (hand * 2)) & 0x03);
+  }
+};
+
+// Keyframe packet - queues up to KEYFRAMES_PER_PACKET keyframes on one pixel
+// Total size: 4 + 20 * 11 = 224 bytes; only the first `count` entries are sent
+struct __attribute__((packed)) KeyframePacket {
+  CommandType command;           // CMD_QUEUE_KEYFRAMES
+  uint8_t pixelId;               // Pixel to queue on
+  uint8_t flags;                 // KEYFRAME_REPLACE
+  uint8_t count;                 // Keyframes in this packet
+  KeyframeEntry keyframes[KEYFRAMES_PER_PACKET];
+
+  // Bytes to send for the keyframes filled in so far
+  size_t length() const {
+    return offsetof(KeyframePacket, keyframes) + count * sizeof(KeyframeEntry);
+  }
+};
+
+// ===== STREAMING PACKETS =====
+// For interactive or generative control the master streams all hand angles at
+// 20-50 Hz. Pixels treat each packet as a timestamped sample of a continuous
+// motion and play back a smooth curve through the samples (bridging lost packets)
+// instead of starting a transition per packet. Colors and opacity are not
+// streamed: they stay as the last angle command left them.
+
+// Fine angle for streaming (0-65535 maps to 0-360 degrees)
+typedef uint16_t stream_angle_t;
+
+inline stream_angle_t floatToStreamAngle(float degrees) {
+  while (degrees < 0) degrees += 360.0f;
+  while (degrees >= 360.0f) degrees -= 360.0f;
+  return (stream_angle_t)(uint32_t)((degrees / 360.0f) * 65536.0f + 0.5f);  // 65536 wraps to 0
+}
+
+inline float streamAngleToFloat(stream_angle_t angle) {
+  return (angle / 65536.0f) * 360.0f;
+}
+
+// Streamed targets for all pixels - 1 + 2 + 4 + 144 = 151 bytes
+struct __attribute__((packed)) StreamTargetsPacket {
+  CommandType command;           // CMD_STREAM_TARGETS
+  uint16_t sequence;             // Incremented per packet (pixels count the gaps as lost)
+  uint32_t timestampMs;          // Master millis() the angles belong to
+  stream_angle_t angles[MAX_PIXELS][HANDS_PER_PIXEL];
+};
+
+// ===== EASING CURVE PACKETS =====
+// New easing curves are uploaded instead of flashed: a curve goes into one of
+// EASING_SLOTS slots on every pixel and is used as TRANSITION_CUSTOM_1 + slot.
+// Slots live in RAM, so the master re-uploads after pixels restart.
+
+#define EASING_CURVE_SAMPLES 64   // Samples of an EASING_FORMAT_SAMPLES curve (t = 0 to 1 inclusive)
+#define EASING_CURVE_ONE 16384    // Curve value 1.0 (values range -2.0 to 2.0)
+
+enum EasingCurveFormat : uint8_t {
+  EASING_FORMAT_BEZIER = 0,   // CSS-style cubic Bezier from (0,0) to (1,1): points = x1, y1, x2, y2
+  EASING_FORMAT_SAMPLES = 1   // Eased value at t = i / (EASING_CURVE_SAMPLES - 1)
+};
+
+inline int16_t floatToCurveValue(float value) {
+  float scaled = value * EASING_CURVE_ONE;
+  scaled += (scaled < 0) ? -0.5f : 0.5f;
+  if (scaled > 32767.0f) return 32767;
+  if (scaled < -32768.0f) return -32768;
+  return (int16_t)scaled;
+}
+
+inline float curveValueToFloat(int16_t value) {
+  return value * (1.0f / EASING_CURVE_ONE);
+}
+
+// Upload one easing curve - 1 + 1 + 1 + 128 = 131 bytes
+struct __attribute__((packed)) EasingUploadPacket {
+  CommandType command;               // CMD_UPLOAD_EASING
+  uint8_t slot;                      // 0 to EASING_SLOTS - 1
+  EasingCurveFormat format;
+  int16_t points[EASING_CURVE_SAMPLES];  // EASING_CURVE_ONE = 1.0 (Bezier uses the first 4)
+
+  void setBezier(uint8_t curveSlot, float x1, float y1, float x2, float y2) {
+    command = CMD_UPLOAD_EASING;
+    slot = curveSlot;
+    format = EASING_FORMAT_BEZIER;
+    memset(points, 0, sizeof(points));
+    points[0] = floatToCurveValue(x1);
+    points[1] = floatToCurveValue(y1);
+    points[2] = floatToCurveValue(x2);
+    points[3] = floatToCurveValue(y2);
+  }
+
+  // Samples are then set with setSample()
+  void setSampled(uint8_t curveSlot) {
+    command = CMD_UPLOAD_EASING;
+    slot = curveSlot;
+    format = EASING_FORMAT_SAMPLES;
+  }
+
+  void setSample(uint8_t index, float value) {
+    if (index < EASING_CURVE_SAMPLES) points[index] = floatToCurveValue(value);
+  }
+};
+
+// ===== SPIN PACKETS =====
+// Continuous motion (a sweeping second hand, a rotating pattern) without a
+// command stream: a spinning hand's angle is worked out from the pixel's own
+// clock, as phase + velocity x time since receipt, and keeps going until it is
+// stopped. Spinning hands ignore angle commands and keyframes, which keep
+// moving the other hands; a spin with velocity 0 (or CMD_RESET) stops them.
+
+#define SPIN_FLAG_PHASE 0x01   // Start from phases[][] rather than the current angles
+#define SPIN_ARCSEC_PER_DEGREE 3600
+
+// Spin hands - 1 + 3 + 1 + 1 + 12 + 4 + 144 = 166 bytes
+struct __attribute__((packed)) SpinPacket {
+  CommandType command;             // CMD_SPIN_HANDS
+  uint8_t targetMask[3];           // Pixels that respond (all zeros = all pixels)
+  uint8_t handMask;                // Bit H: hand H gets velocities[H]; other hands are left alone
+  uint8_t flags;                   // SPIN_FLAG_*
+  int32_t velocities[HANDS_PER_PIXEL]; // Arcseconds per second, + is CW (3600 = 1 degree/s, 0 = stop)
+  uint32_t stopAfterMs;            // Stop after this long, where the hand is then (0 = never)
+  stream_angle_t phases[MAX_PIXELS][HANDS_PER_PIXEL]; // Angle at receipt (with SPIN_FLAG_PHASE)
+
+  // Start with no hands, all pixels, current angles, no stop
+  void clear() {
+    memset(targetMask, 0, sizeof(SpinPacket) - offsetof(SpinPacket, targetMask));
+    command = CMD_SPIN_HANDS;
+  }
+
+  // Spin a hand at `degreesPerSecond` (0 stops it)
+  void setHandSpin(uint8_t hand, float degreesPerSecond) {
+    if (hand < HANDS_PER_PIXEL) {
+      float arcsec = degreesPerSecond * SPIN_ARCSEC_PER_DEGREE;
+      velocities[hand] = (int32_t)(arcsec + (arcsec < 0 ? -0.5f : 0.5f));
+      handMask |= (1 << hand);
+    }
+  }
+
+  // Angle a pixel's hand starts from (the packet then sets every spinning hand's phase)
+  void setPixelPhase(uint8_t pixelIndex, uint8_t hand, float degrees) {
+    if (pixelIndex < MAX_PIXELS && hand < HANDS_PER_PIXEL) {
+      phases[pixelIndex][hand] = floatToStreamAngle(degrees);
+      flags |= SPIN_FLAG_PHASE;
+    }
+  }
+
+  // Restrict the spin to specific pixels (none set = all pixels)
+  void setTargetPixel(uint8_t pixelIndex) {
+    if (pixelIndex < MAX_PIXELS) targetMask[pixelIndex / 8] |= (1 << (pixelIndex % 8));
+  }
+
+  bool isPixelTargeted(uint8_t pixelIndex) const {
+    if (targetMask[0] == 0 && targetMask[1] == 0 && targetMask[2] == 0) return true;
+    if (pixelIndex >= MAX_PIXELS) return false;
+    return (targetMask[pixelIndex / 8] & (1 << (pixelIndex % 8))) != 0;
+  }
+};
+
+// ===== GRID PATTERN PACKETS =====
+// Waves, gradients and phase-shifted patterns are linear in a pixel's row and
+// column, so instead of 24 pixels' angles, directions and colors a grid pattern
+// sends a base value plus a step per row and per column, and each pixel works
+// out its own: value = base + row * rowStep + column * columnStep. Angles and
+// colors wrap (a step of -10 degrees is sent as 350); delays are clamped at 0.
+// Angles are 1/65536 turn, so steps summed over the grid stay finer than an
+// AngleCommandPacket's 1/256 turn; otherwise a pixel ends up doing exactly what
+// an angle command with the expanded values would have it do.
+
+// Grid pattern - 1 + 1 + 1 + 3 + 18 + 1 + 1 + 2 + 3 + 1 + 2 + 2 = 36 bytes
+struct __attribute__((packed)) GridPatternPacket {
+  CommandType command;             // CMD_GRID_PATTERN
+  TransitionType transition;       // Easing of every hand
+  duration_t duration;             // Transition duration (0-60 seconds)
+  uint8_t targetMask[3];           // Pixels that respond (all zeros = all pixels)
+  stream_angle_t baseAngles[HANDS_PER_PIXEL];       // Angle of pixel 0's hands
+  stream_angle_t rowAngleSteps[HANDS_PER_PIXEL];    // Added per row
+  stream_angle_t columnAngleSteps[HANDS_PER_PIXEL]; // Added per column
+  uint8_t directions;              // RotationDirection per hand, 2 bits each (hand 0 in bits 0-1)
+  uint8_t directionFlips;          // Bit H: hand H turns the other way in odd columns; bit H + 4: in odd rows
+  uint8_t turns[2];                // Extra whole turns per hand, 4 bits each (hand H at bit 4*H)
+  uint8_t baseColor;               // Color palette index of pixel 0
+  int8_t rowColorStep;             // Added per row (wraps around the palette)
+  int8_t columnColorStep;          // Added per column
+  uint8_t opacity;                 // Opacity of every pixel (0-255)
+  uint16_t baseDelay;              // Start delay of pixel 0 in START_DELAY_UNIT_MS units
+  int8_t rowDelayStep;             // Added per row, START_DELAY_UNIT_MS units
+  int8_t columnDelayStep;          // Added per column, START_DELAY_UNIT_MS units
+
+  // Start from all pixels at 0 degrees, shortest direction, color 0, full opacity, no delays
+  void clear() {
+    memset(this, 0, sizeof(GridPatternPacket));
+    command = CMD_GRID_PATTERN;
+    opacity = 255;
+  }
+
+  // Angles of a hand: `degrees` at pixel 0, plus `perRow` and `perColumn` degrees per step
+  void setHandAngles(uint8_t hand, float degrees, float perRow, float perColumn) {
+    if (hand < HANDS_PER_PIXEL) {
+      baseAngles[hand] = floatToStreamAngle(degrees);
+      rowAngleSteps[hand] = floatToStreamAngle(perRow);
+      columnAngleSteps[hand] = floatToStreamAngle(perColumn);
+    }
+  }
+
+  // Direction of a hand, optionally reversed in odd columns and/or odd rows
+  // (counter-rotating neighbours); DIR_SHORTEST is never reversed
+  void setHandDirection(uint8_t hand, RotationDirection dir, bool flipOddColumns = false, bool flipOddRows = false) {
+    if (hand < HANDS_PER_PIXEL) {
+      directions = (directions & ~(DIR_MASK << (hand * 2))) | ((dir & DIR_MASK) << (hand * 2));
+      directionFlips &= ~((1 << hand) | (1 << (hand + 4)));
+      if (flipOddColumns) directionFlips |= (1 << hand);
+      if (flipOddRows) directionFlips |= (1 << (hand + 4));
+    }
+  }
+
+  // Extra whole turns of a hand on every pixel (0-15)
+  void setHandTurns(uint8_t hand, uint8_t handTurns) {
+    if (hand < HANDS_PER_PIXEL) {
+      uint8_t shift = (hand % 2) * 4;
+      if (handTurns > MAX_EXTRA_TURNS) handTurns = MAX_EXTRA_TURNS;
+      turns[hand / 2] = (turns[hand / 2] & ~(0x0F << shift)) | (handTurns << shift);
+    }
+  }
+
+  // Palette index at pixel 0, plus steps per row and column
+  void setColors(uint8_t colorIndex, int8_t perRow, int8_t perColumn) {
+    baseColor = colorIndex;
+    rowColorStep = perRow;
+    columnColorStep = perColumn;
+  }
+
+  // Start delays: `baseMs` at pixel 0, plus steps per row and column (rounded to
+  // START_DELAY_UNIT_MS; steps up to +/-254 ms)
+  void setStartDelays(uint16_t baseMs, int16_t perRowMs, int16_t perColumnMs) {
+    baseDelay = toDelayUnits(baseMs);
+    rowDelayStep = constrain(toDelayUnits(perRowMs), -128, 127);
+    columnDelayStep = constrain(toDelayUnits(perColumnMs), -128, 127);
+  }
+
+  // Milliseconds to START_DELAY_UNIT_MS units, rounded to nearest (halves away
+  // from zero, so -3 ms and 3 ms give steps of the same size)
+  static int32_t toDelayUnits(int32_t ms) {
+    return (ms + (ms < 0 ? -START_DELAY_UNIT_MS / 2 : START_DELAY_UNIT_MS / 2)) / START_DELAY_UNIT_MS;
+  }
+
+  // Restrict the pattern to specific pixels (none set = all pixels)
+  void setTargetPixel(uint8_t pixelIndex) {
+    if (pixelIndex < MAX_PIXELS) targetMask[pixelIndex / 8] |= (1 << (pixelIndex % 8));
+  }
+
+  bool isPixelTargeted(uint8_t pixelIndex) const {
+    if (targetMask[0] == 0 && targetMask[1] == 0 && targetMask[2] == 0) return true;
+    if (pixelIndex >= MAX_PIXELS) return false;
+    return (targetMask[pixelIndex / 8] & (1 << (pixelIndex % 8))) != 0;
+  }
+
+  // ===== PER-PIXEL EVALUATION =====
+
+  // Target angle of a pixel's hand, in degrees
+  float getPixelAngle(uint8_t pixelIndex, uint8_t hand) const {
+    uint8_t row = pixelIndex / GRID_COLUMNS;
+    uint8_t column = pixelIndex % GRID_COLUMNS;
+    stream_angle_t angle = baseAngles[hand] + row * rowAngleSteps[hand] + column * columnAngleSteps[hand];
+    return streamAngleToFloat(angle);
+  }
+
+  RotationDirection getPixelDirection(uint8_t pixelIndex, uint8_t hand) const {
+    RotationDirection dir = (RotationDirection)((directions >> (hand * 2)) & DIR_MASK);
+    bool flip = ((directionFlips & (1 << hand)) && (pixelIndex % GRID_COLUMNS) % 2 == 1) !=
+                ((directionFlips & (1 << (hand + 4))) && (pixelIndex / GRID_COLUMNS) % 2 == 1);
+    if (!flip || dir == DIR_SHORTEST) return dir;
+    return dir == DIR_CW ? DIR_CCW : DIR_CW;
+  }
+
+  uint8_t getHandTurns(uint8_t hand) const {
+    return (turns[hand / 2] >> ((hand % 2) * 4)) & 0x0F;
+  }
+
+  uint8_t getPixelColorIndex(uint8_t pixelIndex) const;  // Defined after the palette
+
+  uint16_t getPixelStartDelayMs(uint8_t pixelIndex) const {
+    int32_t units = (int32_t)baseDelay + (pixelIndex / GRID_COLUMNS) * rowDelayStep +
+                    (pixelIndex % GRID_COLUMNS) * columnDelayStep;
+    int32_t ms = units * START_DELAY_UNIT_MS;
+    return ms <= 0 ? 0 : (ms > UINT16_MAX ? UINT16_MAX : ms);
+  }
+};
+
 // Generic packet union for easy handling
 union ESPNowPacket {
   CommandType command;
@@ -327,6 +854,13 @@ union ESPNowPacket {
   OTAAckPacket otaAck;
   GetVersionPacket getVersion;
   VersionResponsePacket versionResponse;
+  GetProfilePacket getProfile;
+  ProfileResponsePacket profileResponse;
+  KeyframePacket keyframes;
+  StreamTargetsPacket streamTargets;
+  EasingUploadPacket easingUpload;
+  SpinPacket spin;
+  GridPatternPacket gridPattern;
   uint8_t raw[250];  // ESP-NOW max packet size
 };
 
@@ -360,6 +894,14 @@ const ColorPaletteEntry COLOR_PALETTE[] = {
 
 const uint8_t COLOR_PALETTE_SIZE = sizeof(COLOR_PALETTE) / sizeof(ColorPaletteEntry);
 
+// Palette index of a pixel in a grid pattern (wraps around the palette)
+inline uint8_t GridPatternPacket::getPixelColorIndex(uint8_t pixelIndex) const {
+  int16_t color = baseColor + (pixelIndex / GRID_COLUMNS) * rowColorStep +
+                  (pixelIndex % GRID_COLUMNS) * columnColorStep;
+  color %= COLOR_PALETTE_SIZE;
+  return color < 0 ? color + COLOR_PALETTE_SIZE : color;
+}
+
 // ===== HELPER FUNCTIONS FOR MASTER =====
 // These functions are used by the master to generate random values
 // Pixels no longer generate random values - they only follow commands
@@ -409,6 +951,11 @@ inline const char* getTransitionName(TransitionType transition) {
     case TRANSITION_BACK_OUT: return "Back Out";
     case TRANSITION_BACK_IN_OUT: return "Back In-Out";
     case TRANSITION_INSTANT: return "Instant";
+    case TRANSITION_SPRING: return "Spring";
+    case TRANSITION_CUSTOM_1: return "Custom 1";
+    case TRANSITION_CUSTOM_2: return "Custom 2";
+    case TRANSITION_CUSTOM_3: return "Custom 3";
+    case TRANSITION_CUSTOM_4: return "Custom 4";
     default: return "Unknown";
   }
 }
@@ -0,0 +1,136 @@
+#ifndef FLOW_ANIMATION_H
+#define FLOW_ANIMATION_H
+
+#include <Arduino.h>
+#include <ESPNowComm.h>
+#include <AsyncLog.h>
+#include <TFT_eSPI.h>
+
+// Flow Animation - a generative sine field streamed to all pixels
+// Hand angles are computed continuously from the pixel's row/column and the time,
+// and streamed as CMD_STREAM_TARGETS samples; pixels play them back as a smooth
+// curve, so the field moves without per-command starts and stops.
+
+// Timing for Flow animation
+const unsigned long FLOW_STREAM_INTERVAL = 33;    // ~30 Hz samples
+const unsigned long FLOW_APPROACH_MS = 1500;      // Transition into the field before streaming
+
+// External references (provided by master.cpp)
+extern TFT_eSPI tft;
+extern unsigned long lastCommandTime;
+
+// Color definitions (from master.cpp)
+#define COLOR_BG      TFT_BLACK
+#define COLOR_TEXT    TFT_WHITE
+#define COLOR_ACCENT  TFT_GREEN
+
+// ===== STATE TRACKING =====
+
+unsigned long flowStartTime = 0;
+unsigned long lastFlowSampleTime = 0;
+uint16_t flowSequence = 0;
+bool flowStreaming = false;
+
+// ===== HELPER FUNCTIONS =====
+
+// Hand angles of one pixel at `ms` into the animation
+// Two travelling waves cross the grid (8 columns x 3 rows); the third hand slowly circles
+void getFlowAngles(uint8_t pixelId, unsigned long ms, float angles[HANDS_PER_PIXEL]) {
+  float t = ms / 1000.0f;
+  float col = pixelId % 8;
+  float row = pixelId / 8;
+
+  angles[0] = 90.0f + 80.0f * sinf(0.7f * col + 0.5f * row - 1.3f * t);
+  angles[1] = 270.0f + 80.0f * sinf(0.9f * row - 0.4f * col + 0.9f * t);
+  angles[2] = fmodf(20.0f * t + 45.0f * col + 120.0f * row, 360.0f);
+}
+
+// Move all pixels to the field's starting angles in a random color
+// (streams carry angles only, so the color is set once here)
+void sendFlowApproach() {
+  ESPNowPacket packet;
+  packet.angleCmd.command = CMD_SET_ANGLES;
+  packet.angleCmd.clearTargetMask();  // Target all pixels (broadcast mode)
+  packet.angleCmd.clearExtensions();
+  packet.angleCmd.transition = TRANSITION_EASE_IN_OUT;
+  packet.angleCmd.duration = floatToDuration(FLOW_APPROACH_MS / 1000.0f);
+
+  uint8_t colorIndex = getRandomColorIndex();
+  for (int i = 0; i < MAX_PIXELS; i++) {
+    float a[HANDS_PER_PIXEL];
+    getFlowAngles(i, 0, a);
+    packet.angleCmd.setPixelAngles(i, a[0], a[1], a[2], DIR_SHORTEST, DIR_SHORTEST, DIR_SHORTEST);
+    packet.angleCmd.setPixelStyle(i, colorIndex, 255);
+  }
+
+  if (!ESPNowComm::sendPacket(&packet, sizeof(AngleCommandPacket))) {
+    LOG_WARN("Failed to send Flow approach!");
+  }
+}
+
+// Send one streamed sample of the field
+void sendFlowSample(unsigned long currentTime) {
+  ESPNowPacket packet;
+  packet.streamTargets.command = CMD_STREAM_TARGETS;
+  packet.streamTargets.sequence = flowSequence++;
+  packet.streamTargets.timestampMs = currentTime;
+
+  unsigned long ms = currentTime - flowStartTime;
+  for (int i = 0; i < MAX_PIXELS; i++) {
+    float a[HANDS_PER_PIXEL];
+    getFlowAngles(i, ms, a);
+    for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+      packet.streamTargets.angles[i][h] = floatToStreamAngle(a[h]);
+    }
+  }
+
+  // A lost sample is bridged by the pixels; nothing to retry
+  ESPNowComm::sendPacket(&packet, sizeof(StreamTargetsPacket));
+}
+
+// Start the Flow animation: move into the field, streaming starts once there
+void startFlow() {
+  unsigned long now = millis();
+  flowStartTime = now + FLOW_APPROACH_MS;  // Field time 0 is where the approach ends
+  flowStreaming = false;
+
+  sendFlowApproach();
+  LOG_INFO("Flow: streaming at %lu Hz after %lums approach", 1000 / FLOW_STREAM_INTERVAL, FLOW_APPROACH_MS);
+
+  // Update display
+  tft.fillScreen(COLOR_BG);
+  tft.setTextColor(COLOR_ACCENT, COLOR_BG);
+  tft.setTextSize(2);
+  tft.setCursor(10, 10);
+  tft.println("FLOW ANIMATION");
+
+  tft.setTextColor(COLOR_TEXT, COLOR_BG);
+  tft.setTextSize(1);
+  tft.setCursor(10, 40);
+  tft.println("Sine field streamed at 30 Hz");
+  tft.setCursor(10, 55);
+  tft.println("Pixels interpolate between samples");
+
+  tft.setCursor(10, 110);
+  tft.setTextColor(TFT_YELLOW, COLOR_BG);
+  tft.println("Touch screen to return to menu");
+}
+
+// Handle Flow animation loop - streams samples once the approach is done
+void handleFlowLoop(unsigned long currentTime) {
+  if (!flowStreaming) {
+    if ((long)(currentTime - flowStartTime) < 0) return;  // Still approaching
+    flowStreaming = true;
+    lastFlowSampleTime = currentTime - FLOW_STREAM_INTERVAL;
+  }
+
+  if (currentTime - lastFlowSampleTime >= FLOW_STREAM_INTERVAL) {
+    sendFlowSample(currentTime);
+    // Keep the sample rate on schedule rather than drifting with loop() latency
+    lastFlowSampleTime += FLOW_STREAM_INTERVAL;
+    if (currentTime - lastFlowSampleTime >= FLOW_STREAM_INTERVAL) lastFlowSampleTime = currentTime;
+    lastCommandTime = currentTime;
+  }
+}
+
+#endif // FLOW_ANIMATION_H
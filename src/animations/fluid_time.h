@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <ESPNowComm.h>
+#include <AsyncLog.h>
 #include <TFT_eSPI.h>
 
 // Fluid Time Animation - Enhanced with multiple patterns, direction modes, and multi-stage effects
@@ -69,13 +70,12 @@ enum MirrorMode {
 // Phase tracking
 enum FluidTimePhase {
   FLUID_IDLE,           // Ready to generate new pattern
-  FLUID_SENDING_GROUPS, // Actively sending to groups with delays
+  FLUID_SENDING_GROUPS, // Wave sent; groups start on the pixels with their delays
   FLUID_WAITING,        // Waiting for animations to complete before next pattern
   FLUID_HOLDING_TIME    // Holding time display for 5-7 seconds
 };
 
 FluidTimePhase fluidPhase = FLUID_IDLE;
-uint8_t currentGroup = 0;
 uint8_t totalGroups = 0;
 unsigned long lastGroupSendTime = 0;
 unsigned long fluidAnimationStartTime = 0;
@@ -350,67 +350,53 @@ void buildGroupOrder() {
   }
 }
 
-// Send pattern to a specific group (column or row)
-void sendFluidPatternToGroup(uint8_t groupIndex) {
+// Group (position in groupOrder) a pixel belongs to for the current pattern
+uint8_t fluidGroupOf(uint8_t pixelId) {
+  uint8_t line = (currentPattern == PATTERN_TOP_BOTTOM || currentPattern == PATTERN_BOTTOM_TOP)
+                   ? pixelId / 8    // Row-based
+                   : pixelId % 8;   // Column-based
+  for (uint8_t g = 0; g < totalGroups; g++) {
+    if (groupOrder[g] == line) return g;
+  }
+  return 0;
+}
+
+// Send the whole wave in one broadcast: group g starts g * baseGroupDelay after
+// the packet arrives (per-pixel start delays), in place of one packet per group
+void sendFluidWave() {
   ESPNowPacket packet;
   packet.angleCmd.command = CMD_SET_ANGLES;
   packet.angleCmd.clearTargetMask();
   packet.angleCmd.transition = currentFluidPattern.transition;
   packet.angleCmd.duration = floatToDuration(currentFluidPattern.duration);
-
-  // When showing time, only target the 12 digit pixels
-  if (showingTime) {
-    // Target only digit pixels
-    for (int i = 0; i < 6; i++) {
-      packet.angleCmd.setTargetPixel(digit1PixelIds[i]);
-      packet.angleCmd.setTargetPixel(digit2PixelIds[i]);
-    }
-  } else {
-    // Determine which pixels to target based on pattern type
-    if (currentPattern == PATTERN_TOP_BOTTOM || currentPattern == PATTERN_BOTTOM_TOP) {
-      // Row-based: target all 8 pixels in the row
-      uint8_t row = groupOrder[groupIndex];
-      for (uint8_t col = 0; col < 8; col++) {
-        uint8_t pixelId = row * 8 + col;
-        packet.angleCmd.setTargetPixel(pixelId);
-      }
+  packet.angleCmd.clearExtensions();
+  packet.angleCmd.setStartDelayStep(baseGroupDelay);
+
+  // Generate directions for each group based on mode
+  RotationDirection groupDirs[24][3];
+  for (uint8_t g = 0; g < totalGroups; g++) {
+    if (currentDirMode == DIR_MODE_UNIFIED) {
+      // All hands same direction (use the stored direction from pattern)
+      groupDirs[g][0] = currentFluidPattern.dir1;
+      groupDirs[g][1] = currentFluidPattern.dir2;
+      groupDirs[g][2] = currentFluidPattern.dir3;
+    } else if (currentDirMode == DIR_MODE_ALTERNATING) {
+      // Alternate by group
+      RotationDirection dir = (g % 2 == 0) ? DIR_CW : DIR_CCW;
+      groupDirs[g][0] = dir;
+      groupDirs[g][1] = dir;
+      groupDirs[g][2] = dir;
     } else {
-      // Column-based: target 3 pixels in the column
-      uint8_t col = groupOrder[groupIndex];
-      packet.angleCmd.setTargetPixel(col);       // Row 0
-      packet.angleCmd.setTargetPixel(col + 8);   // Row 1
-      packet.angleCmd.setTargetPixel(col + 16);  // Row 2
+      // Random per hand
+      groupDirs[g][0] = (random(2) == 0) ? DIR_CW : DIR_CCW;
+      groupDirs[g][1] = (random(2) == 0) ? DIR_CW : DIR_CCW;
+      groupDirs[g][2] = (random(2) == 0) ? DIR_CW : DIR_CCW;
     }
   }
 
-  // Generate directions based on mode
-  RotationDirection dir1, dir2, dir3;
-  if (currentDirMode == DIR_MODE_UNIFIED) {
-    // All hands same direction (use the stored direction from pattern)
-    dir1 = currentFluidPattern.dir1;
-    dir2 = currentFluidPattern.dir2;
-    dir3 = currentFluidPattern.dir3;
-  } else if (currentDirMode == DIR_MODE_ALTERNATING) {
-    // Alternate by group
-    if (groupIndex % 2 == 0) {
-      dir1 = DIR_CW;
-      dir2 = DIR_CW;
-      dir3 = DIR_CW;
-    } else {
-      dir1 = DIR_CCW;
-      dir2 = DIR_CCW;
-      dir3 = DIR_CCW;
-    }
-  } else {
-    // Random per hand
-    dir1 = (random(2) == 0) ? DIR_CW : DIR_CCW;
-    dir2 = (random(2) == 0) ? DIR_CW : DIR_CCW;
-    dir3 = (random(2) == 0) ? DIR_CW : DIR_CCW;
-  }
-
-  // Set angles/directions/style for all pixels
+  // Set angles/directions/style/start slot for all pixels
   if (showingTime) {
-    // Use digit patterns for time display
+    // Use digit patterns for time display; only the 12 digit pixels are targeted
     uint8_t leftDigit = currentMinute / 10;
     uint8_t rightDigit = currentMinute % 10;
 
@@ -421,6 +407,10 @@ void sendFluidPatternToGroup(uint8_t groupIndex) {
     // Set left digit angles (with right-align for "1")
     for (int i = 0; i < 6; i++) {
       uint8_t pixelId = digit1PixelIds[i];
+      uint8_t group = fluidGroupOf(pixelId);
+      const RotationDirection* dirs = groupDirs[group];
+      packet.angleCmd.setTargetPixel(pixelId);
+      packet.angleCmd.setPixelStartSlot(pixelId, group);
 
       if (leftDigit == 1) {
         // Special handling for "1": right-align it
@@ -432,7 +422,7 @@ void sendFluidPatternToGroup(uint8_t groupIndex) {
             spacePattern.angles[i][0],
             spacePattern.angles[i][1],
             spacePattern.angles[i][2],
-            dir1, dir2, dir3);
+            dirs[0], dirs[1], dirs[2]);
           packet.angleCmd.setPixelStyle(pixelId, currentFluidPattern.colorIndex, spacePattern.opacity[i]);
         } else {
           // Column 1: use column 0 from "1" pattern (remap indices)
@@ -442,7 +432,7 @@ void sendFluidPatternToGroup(uint8_t groupIndex) {
             leftPattern.angles[sourceIdx][0],
             leftPattern.angles[sourceIdx][1],
             leftPattern.angles[sourceIdx][2],
-            dir1, dir2, dir3);
+            dirs[0], dirs[1], dirs[2]);
           packet.angleCmd.setPixelStyle(pixelId, currentFluidPattern.colorIndex, leftPattern.opacity[sourceIdx]);
         }
       } else {
@@ -451,7 +441,7 @@ void sendFluidPatternToGroup(uint8_t groupIndex) {
           leftPattern.angles[i][0],
           leftPattern.angles[i][1],
           leftPattern.angles[i][2],
-          dir1, dir2, dir3);
+          dirs[0], dirs[1], dirs[2]);
         packet.angleCmd.setPixelStyle(pixelId, currentFluidPattern.colorIndex, leftPattern.opacity[i]);
       }
     }
@@ -459,16 +449,23 @@ void sendFluidPatternToGroup(uint8_t groupIndex) {
     // Set right digit angles
     for (int i = 0; i < 6; i++) {
       uint8_t pixelId = digit2PixelIds[i];
+      uint8_t group = fluidGroupOf(pixelId);
+      const RotationDirection* dirs = groupDirs[group];
+      packet.angleCmd.setTargetPixel(pixelId);
+      packet.angleCmd.setPixelStartSlot(pixelId, group);
       packet.angleCmd.setPixelAngles(pixelId,
         rightPattern.angles[i][0],
         rightPattern.angles[i][1],
         rightPattern.angles[i][2],
-        dir1, dir2, dir3);
+        dirs[0], dirs[1], dirs[2]);
       packet.angleCmd.setPixelStyle(pixelId, currentFluidPattern.colorIndex, rightPattern.opacity[i]);
     }
   } else {
-    // Use random pattern for all pixels WITH MIRRORING
+    // Use random pattern for all pixels WITH MIRRORING (broadcast to all)
     for (int i = 0; i < MAX_PIXELS; i++) {
+      uint8_t group = fluidGroupOf(i);
+      const RotationDirection* dirs = groupDirs[group];
+
       // Apply mirroring based on pixel position
       float mirroredAngle1, mirroredAngle2, mirroredAngle3;
       getMirroredAngles(i,
@@ -481,8 +478,9 @@ void sendFluidPatternToGroup(uint8_t groupIndex) {
         mirroredAngle1,
         mirroredAngle2,
         mirroredAngle3,
-        dir1, dir2, dir3);
+        dirs[0], dirs[1], dirs[2]);
       packet.angleCmd.setPixelStyle(i, currentFluidPattern.colorIndex, 255);
+      packet.angleCmd.setPixelStartSlot(i, group);
     }
   }
 
@@ -511,7 +509,7 @@ void generateFluidPattern() {
   }
 
   // Randomize timing
-  baseGroupDelay = random(150, 501);  // 150-500ms
+  baseGroupDelay = random(75, 251) * 2;  // 150-500ms, in START_DELAY_UNIT_MS steps
   baseDuration = getFluidDuration();  // 6-10 seconds
 
   // Build group order for this pattern
@@ -542,23 +540,14 @@ void generateFluidPattern() {
   float variation = 0.85f + (random(31) / 100.0f);  // 0.85 to 1.15
   currentFluidPattern.duration = baseDuration * variation;
 
-  Serial.println("=== New Fluid Time Pattern ===");
-  Serial.print("Pattern: ");
-  Serial.println(getPatternName(currentPattern));
-  Serial.print("Direction Mode: ");
-  Serial.println(getDirectionModeName(currentDirMode));
-  Serial.print("Mirror Mode: ");
-  Serial.println(getMirrorModeName(currentMirrorMode));
-  Serial.print("Stage Mode: ");
-  Serial.println(getStageModeName(currentStageMode));
-  Serial.print("Base Delay: ");
-  Serial.print(baseGroupDelay);
-  Serial.println("ms");
-  Serial.print("Duration: ");
-  Serial.print(currentFluidPattern.duration, 1);
-  Serial.println("s");
-  Serial.print("Transition: ");
-  Serial.println(getTransitionName(currentFluidPattern.transition));
+  LOG_INFO("=== New Fluid Time Pattern ===");
+  LOG_INFO("Pattern: %s", getPatternName(currentPattern));
+  LOG_INFO("Direction Mode: %s", getDirectionModeName(currentDirMode));
+  LOG_INFO("Mirror Mode: %s", getMirrorModeName(currentMirrorMode));
+  LOG_INFO("Stage Mode: %s", getStageModeName(currentStageMode));
+  LOG_INFO("Base Delay: %ums", baseGroupDelay);
+  LOG_INFO("Duration: %.1fs", currentFluidPattern.duration);
+  LOG_INFO("Transition: %s", getTransitionName(currentFluidPattern.transition));
 }
 
 // Generate time display pattern (uses digit angles instead of random)
@@ -576,7 +565,7 @@ void generateFluidTimePattern() {
   currentStageMode = STAGE_SINGLE;
 
   // Randomize timing
-  baseGroupDelay = random(150, 501);  // 150-500ms
+  baseGroupDelay = random(75, 251) * 2;  // 150-500ms, in START_DELAY_UNIT_MS steps
   baseDuration = getFluidDuration();  // 6-10 seconds
 
   // Build group order for this pattern
@@ -607,19 +596,12 @@ void generateFluidTimePattern() {
     currentFluidPattern.dir3 = (random(2) == 0) ? DIR_CW : DIR_CCW;
   }
 
-  Serial.println("=== Fluid Time Display ===");
-  Serial.print("Time: ");
-  Serial.print(leftDigit);
-  Serial.println(rightDigit);
-  Serial.print("Pattern: ");
-  Serial.println(getPatternName(currentPattern));
-  Serial.print("Direction Mode: ");
-  Serial.println(getDirectionModeName(currentDirMode));
-  Serial.print("Duration: ");
-  Serial.print(currentFluidPattern.duration, 1);
-  Serial.println("s");
-  Serial.print("Transition: ");
-  Serial.println(getTransitionName(currentFluidPattern.transition));
+  LOG_INFO("=== Fluid Time Display ===");
+  LOG_INFO("Time: %u%u", leftDigit, rightDigit);
+  LOG_INFO("Pattern: %s", getPatternName(currentPattern));
+  LOG_INFO("Direction Mode: %s", getDirectionModeName(currentDirMode));
+  LOG_INFO("Duration: %.1fs", currentFluidPattern.duration);
+  LOG_INFO("Transition: %s", getTransitionName(currentFluidPattern.transition));
 
   showingTime = true;
 }
@@ -682,13 +664,14 @@ void updateFluidTimeDisplay() {
   tft.print(currentFluidPattern.duration, 1);
   tft.println("s");
 
-  // Show progress
+  // Show the wave (sent as one packet, staggered on the pixels)
   tft.setCursor(10, 120 + yOffset);
   tft.setTextColor(TFT_CYAN, COLOR_BG);
-  tft.print("Progress: ");
-  tft.print(currentGroup + 1);  // Display 1-based counting
-  tft.print(" / ");
-  tft.println(totalGroups);
+  tft.print("Wave: ");
+  tft.print(totalGroups);
+  tft.print(" groups, ");
+  tft.print(baseGroupDelay);
+  tft.println("ms apart");
 
   tft.setCursor(10, 140 + yOffset);
   tft.setTextColor(TFT_YELLOW, COLOR_BG);
@@ -710,9 +693,7 @@ void handleFluidTimeLoop(unsigned long currentTime) {
     lastMinuteChange = currentTime;
     shouldShowTimeNext = true;  // Set flag to show time on next IDLE cycle
 
-    Serial.print("Showing current time: ");
-    Serial.print(currentMinute / 10);
-    Serial.println(currentMinute % 10);
+    LOG_INFO("Showing current time: %u%u", currentMinute / 10, currentMinute % 10);
   }
 
   switch (fluidPhase) {
@@ -731,9 +712,8 @@ void handleFluidTimeLoop(unsigned long currentTime) {
       }
       currentStage = 0;
 
-      // Send to first group immediately
-      currentGroup = 0;
-      sendFluidPatternToGroup(currentGroup);
+      // The whole wave goes out at once; the pixels stagger the groups
+      sendFluidWave();
       updateFluidTimeDisplay();
       lastGroupSendTime = currentTime;
       fluidAnimationStartTime = currentTime;
@@ -742,50 +722,31 @@ void handleFluidTimeLoop(unsigned long currentTime) {
     }
 
     case FLUID_SENDING_GROUPS: {
-      // For double wave mode, check if we should start stage 2
-      if (currentStageMode == STAGE_DOUBLE_WAVE && currentStage == 0) {
-        // Start second wave when halfway through first wave
-        if (currentGroup >= totalGroups / 2) {
+      // The last group of this stage starts (totalGroups - 1) delays after the
+      // wave was sent; the next stage follows one delay after that
+      if (currentTime - lastGroupSendTime >= totalGroups * baseGroupDelay) {
+        if (currentStageMode == STAGE_PING_PONG && currentStage == 0) {
+          // Start reverse wave immediately
+          LOG_INFO("Starting ping-pong reverse");
           currentStage = 1;
-          // Keep the same pattern but restart from beginning
-          // This creates overlapping waves
-          Serial.println("Starting second wave (overlap)");
-        }
-      }
 
-      // Send to next group after delay
-      if (currentTime - lastGroupSendTime >= baseGroupDelay) {
-        currentGroup++;
-        if (currentGroup < totalGroups) {
-          sendFluidPatternToGroup(currentGroup);
+          // Reverse the group order
+          uint8_t temp[24];
+          for (uint8_t i = 0; i < totalGroups; i++) {
+            temp[i] = groupOrder[totalGroups - 1 - i];
+          }
+          for (uint8_t i = 0; i < totalGroups; i++) {
+            groupOrder[i] = temp[i];
+          }
+
+          // Send the reversed wave
+          sendFluidWave();
           updateFluidTimeDisplay();
           lastGroupSendTime = currentTime;
         } else {
-          // All groups sent for this stage
-          if (currentStageMode == STAGE_PING_PONG && currentStage == 0) {
-            // Start reverse wave immediately
-            Serial.println("Starting ping-pong reverse");
-            currentStage = 1;
-
-            // Reverse the group order
-            uint8_t temp[24];
-            for (uint8_t i = 0; i < totalGroups; i++) {
-              temp[i] = groupOrder[totalGroups - 1 - i];
-            }
-            for (uint8_t i = 0; i < totalGroups; i++) {
-              groupOrder[i] = temp[i];
-            }
-
-            // Restart sending from first group (now reversed)
-            currentGroup = 0;
-            sendFluidPatternToGroup(currentGroup);
-            updateFluidTimeDisplay();
-            lastGroupSendTime = currentTime;
-          } else {
-            // Done with all stages, wait for animations to complete
-            Serial.println("All stages sent, waiting for completion");
-            fluidPhase = FLUID_WAITING;
-          }
+          // Done with all stages, wait for animations to complete
+          LOG_INFO("All stages sent, waiting for completion");
+          fluidPhase = FLUID_WAITING;
         }
       }
       break;
@@ -799,12 +760,12 @@ void handleFluidTimeLoop(unsigned long currentTime) {
       if (currentTime - fluidAnimationStartTime >= totalWaitTime) {
         if (showingTime) {
           // After showing time, hold it for 5-7 seconds
-          Serial.println("Holding time display");
+          LOG_INFO("Holding time display");
           fluidPhase = FLUID_HOLDING_TIME;
           timeHoldStartTime = currentTime;
         } else {
           // Regular pattern, start next one
-          Serial.println("Starting next pattern");
+          LOG_INFO("Starting next pattern");
           fluidPhase = FLUID_IDLE;
         }
       }
@@ -814,7 +775,7 @@ void handleFluidTimeLoop(unsigned long currentTime) {
     case FLUID_HOLDING_TIME: {
       // Hold the time display for TIME_HOLD_DURATION
       if (currentTime - timeHoldStartTime >= TIME_HOLD_DURATION) {
-        Serial.println("Time hold complete, back to random patterns");
+        LOG_INFO("Time hold complete, back to random patterns");
         showingTime = false;  // Clear time flag
         fluidPhase = FLUID_IDLE;  // Go back to random patterns
       }
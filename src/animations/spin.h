@@ -0,0 +1,132 @@
+#ifndef SPIN_ANIMATION_H
+#define SPIN_ANIMATION_H
+
+#include <Arduino.h>
+#include <ESPNowComm.h>
+#include <AsyncLog.h>
+#include <TFT_eSPI.h>
+
+// Spin Animation - ambient rotating pattern with no command traffic
+// One grid pattern brings the hands into a phase pattern across the grid, then
+// one CMD_SPIN_HANDS sets them turning; the pixels keep it going from their own
+// clocks, so the master only sends keepalive pings.
+
+// Timing for Spin animation
+const unsigned long SPIN_APPROACH_MS = 2000;   // Transition into the pattern before spinning
+const unsigned long SPIN_PING_INTERVAL = 3000;
+
+// Hand speeds (degrees per second, + is clockwise)
+const float SPIN_HAND_SPEEDS[HANDS_PER_PIXEL] = {24.0f, -24.0f, 6.0f};
+
+// Starting phases: degrees at pixel 0, per row (3), per column (8)
+const float SPIN_PHASE_FIELD[HANDS_PER_PIXEL][3] = {
+  {0.0f, 30.0f, 45.0f},
+  {180.0f, 30.0f, -45.0f},
+  {0.0f, 120.0f, 22.5f}
+};
+
+// External references (provided by master.cpp)
+extern TFT_eSPI tft;
+extern unsigned long lastPingTime;
+void sendPing();  // External function to ping pixels
+
+// Color definitions (from master.cpp)
+#define COLOR_BG      TFT_BLACK
+#define COLOR_TEXT    TFT_WHITE
+#define COLOR_ACCENT  TFT_GREEN
+
+// ===== STATE TRACKING =====
+
+unsigned long spinStartTime = 0;
+bool spinSent = false;
+
+// ===== HELPER FUNCTIONS =====
+
+// Starting angle of a pixel's hand: phases step along the columns (8) and rows (3)
+float getSpinPhase(uint8_t pixelId, uint8_t hand) {
+  uint8_t col = pixelId % GRID_COLUMNS;
+  uint8_t row = pixelId / GRID_COLUMNS;
+  const float* field = SPIN_PHASE_FIELD[hand];
+  return field[0] + row * field[1] + col * field[2];
+}
+
+// Start the Spin animation: move into the pattern, the spin follows once there
+void startSpinAnimation() {
+  spinStartTime = millis();
+  spinSent = false;
+
+  // The phases are linear in row and column: the pixels work out their own
+  ESPNowPacket packet;
+  packet.gridPattern.clear();  // All pixels, shortest direction, full opacity, no delays
+  packet.gridPattern.transition = TRANSITION_EASE_IN_OUT;
+  packet.gridPattern.duration = floatToDuration(SPIN_APPROACH_MS / 1000.0f);
+  for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+    packet.gridPattern.setHandAngles(h, SPIN_PHASE_FIELD[h][0], SPIN_PHASE_FIELD[h][1], SPIN_PHASE_FIELD[h][2]);
+  }
+  packet.gridPattern.setColors(getRandomColorIndex(), 0, 0);
+  if (!ESPNowComm::sendPacket(&packet, sizeof(GridPatternPacket))) {
+    LOG_WARN("Failed to send Spin approach!");
+  }
+
+  // Update display
+  tft.fillScreen(COLOR_BG);
+  tft.setTextColor(COLOR_ACCENT, COLOR_BG);
+  tft.setTextSize(2);
+  tft.setCursor(10, 10);
+  tft.println("SPIN ANIMATION");
+
+  tft.setTextColor(COLOR_TEXT, COLOR_BG);
+  tft.setTextSize(1);
+  tft.setCursor(10, 40);
+  tft.printf("Hands: %.0f, %.0f, %.0f deg/s", SPIN_HAND_SPEEDS[0], SPIN_HAND_SPEEDS[1], SPIN_HAND_SPEEDS[2]);
+  tft.setCursor(10, 55);
+  tft.println("Pixels spin on their own clocks");
+
+  tft.setCursor(10, 110);
+  tft.setTextColor(TFT_YELLOW, COLOR_BG);
+  tft.println("Touch screen to return to menu");
+}
+
+// Set every hand spinning from its phase (one packet for the whole animation)
+void sendSpin() {
+  ESPNowPacket packet;
+  packet.spin.clear();
+  for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+    packet.spin.setHandSpin(h, SPIN_HAND_SPEEDS[h]);
+    for (uint8_t i = 0; i < MAX_PIXELS; i++) {
+      packet.spin.setPixelPhase(i, h, getSpinPhase(i, h));
+    }
+  }
+  if (ESPNowComm::sendPacket(&packet, sizeof(SpinPacket))) {
+    LOG_INFO("Spin: hands spinning at %.0f, %.0f, %.0f deg/s",
+             SPIN_HAND_SPEEDS[0], SPIN_HAND_SPEEDS[1], SPIN_HAND_SPEEDS[2]);
+  } else {
+    LOG_WARN("Failed to send Spin!");
+  }
+}
+
+// Stop every spinning hand where it is (leaving the animation)
+void stopSpinAnimation() {
+  ESPNowPacket packet;
+  packet.spin.clear();
+  for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+    packet.spin.setHandSpin(h, 0.0f);
+  }
+  ESPNowComm::sendPacket(&packet, sizeof(SpinPacket));
+}
+
+// Handle Spin animation loop - one spin after the approach, then only pings
+void handleSpinLoop(unsigned long currentTime) {
+  if (!spinSent && currentTime - spinStartTime >= SPIN_APPROACH_MS) {
+    sendSpin();
+    spinSent = true;
+  }
+
+  // Pixels show an error screen after 10 s without packets
+  if (currentTime - lastPingTime >= SPIN_PING_INTERVAL) {
+    sendPing();
+    lastPingTime = currentTime;
+  }
+}
+
+#endif // SPIN_ANIMATION_H
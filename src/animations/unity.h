@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <ESPNowComm.h>
+#include <AsyncLog.h>
 #include <TFT_eSPI.h>
 
 // Unity Animation - All pixels move in unison with synchronized random patterns
@@ -20,13 +21,46 @@ extern unsigned long lastCommandTime;
 #define COLOR_TEXT    TFT_WHITE
 #define COLOR_ACCENT  TFT_GREEN
 
+// Upload Unity's custom easings to all pixels
+// Custom 1: a sharp ease-out (Bezier); Custom 2: three smoothed ticks (sampled)
+// Sent again ahead of every pattern that uses one: a pixel that missed an upload
+// (broadcasts are not acknowledged) or rebooted since would ease that pattern linearly
+void sendUnityEasings() {
+  ESPNowPacket packet;
+  packet.easingUpload.setBezier(0, 0.16f, 1.0f, 0.3f, 1.0f);
+  bool sent = ESPNowComm::sendPacket(&packet, sizeof(EasingUploadPacket));
+
+  packet.easingUpload.setSampled(1);
+  for (uint8_t i = 0; i < EASING_CURVE_SAMPLES; i++) {
+    float x = 3.0f * i / (EASING_CURVE_SAMPLES - 1);
+    float tick = min(floorf(x), 2.0f);
+    float f = x - tick;
+    packet.easingUpload.setSample(i, (tick + f * f * (3.0f - 2.0f * f)) / 3.0f);
+  }
+  sent &= ESPNowComm::sendPacket(&packet, sizeof(EasingUploadPacket));
+
+  if (!sent) {
+    LOG_WARN("Failed to upload Unity easings!");
+  }
+}
+
+// Random transition for Unity: the built-in curves or one of the uploaded ones
+inline TransitionType getUnityTransition() {
+  uint8_t pick = random(9);  // 0-6 built-in (excluding INSTANT), 7-8 custom
+  return pick < 7 ? (TransitionType)pick : (TransitionType)(TRANSITION_CUSTOM_1 + pick - 7);
+}
+
 // Send a Unity pattern - all pixels move in synchronized unison
 void sendUnityPattern() {
   ESPNowPacket packet;
   packet.angleCmd.command = CMD_SET_ANGLES;
   packet.angleCmd.clearTargetMask();  // Target all pixels (broadcast mode)
-  packet.angleCmd.transition = getRandomTransition();
+  packet.angleCmd.clearExtensions();  // All pixels start together, hands share the timing
+  packet.angleCmd.transition = getUnityTransition();
   packet.angleCmd.duration = floatToDuration(getRandomDuration());
+  if (isCustomTransition(packet.angleCmd.transition)) {
+    sendUnityEasings();  // Pixels apply the uploads before the pattern (command queue order)
+  }
 
   // Generate random values ONCE for all pixels (synchronized movement)
   float angle1 = getRandomAngle();
@@ -49,11 +83,8 @@ void sendUnityPattern() {
 
   // Send the packet
   if (ESPNowComm::sendPacket(&packet, sizeof(AngleCommandPacket))) {
-    Serial.print("Sent Unity pattern: ");
-    Serial.print(getTransitionName(packet.angleCmd.transition));
-    Serial.print(", duration: ");
-    Serial.print(durationToFloat(packet.angleCmd.duration), 1);
-    Serial.println("s");
+    LOG_INFO("Sent Unity pattern: %s, duration: %.1fs",
+             getTransitionName(packet.angleCmd.transition), durationToFloat(packet.angleCmd.duration));
 
     // Update display
     tft.fillScreen(COLOR_BG);
@@ -83,7 +114,7 @@ void sendUnityPattern() {
     tft.println("Touch screen to return to menu");
 
   } else {
-    Serial.println("Failed to send Unity pattern!");
+    LOG_WARN("Failed to send Unity pattern!");
   }
 }
 
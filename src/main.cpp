@@ -3,11 +3,36 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_GC9A01A.h>
 #include <ESPNowComm.h>
+#include <AsyncLog.h>
 #include <Preferences.h>
 #include <HTTPUpdate.h>
 #include <WiFiClient.h>
 #include <esp_now.h>
 #include <esp_wifi.h>
+#include "pixel/display_bus.h"
+#include "pixel/damage.h"
+#include "pixel/circle_mask.h"
+#include "pixel/clock_face.h"
+#include "pixel/frame_buffers.h"
+#include "pixel/frame_pipeline.h"
+#include "pixel/easing.h"
+#include "pixel/fixed_math.h"
+#include "pixel/spring_motion.h"
+#include "pixel/hand_path.h"
+#include "pixel/easing_curves.h"
+#include "pixel/spin_motion.h"
+#include "pixel/display_list.h"
+#include "pixel/band_renderer.h"
+#include "pixel/frame_scheduler.h"
+#include "pixel/color_ramp.h"
+#include "pixel/command_queue.h"
+#include "pixel/stage_profiler.h"
+#include "pixel/keyframe_queue.h"
+#include "pixel/hand_motion.h"
+#include "pixel/stream_player.h"
+#if defined(CONFIG_IDF_TARGET_ESP32S3) || defined(ARDUINO_ESP32S3_DEV)
+  #include "pixel/dma_bus.h"
+#endif
 
 // Proof of concept: Three rotating clock hands on a 240x240 circular display
 // Based on the twenty-four-times simulation
@@ -15,7 +40,9 @@
 
 // ===== FIRMWARE VERSION =====
 #define FIRMWARE_VERSION_MAJOR 1
-#define FIRMWARE_VERSION_MINOR 34
+#define FIRMWARE_VERSION_MINOR 37
+// 1.37: AngleCommandPacket grew from 219 to 221 bytes (turns and waypoints), so
+// commandPacketSize() rejects angle commands from masters older than 1.37
 
 // ===== PIXEL CONFIGURATION =====
 // Pixel ID is loaded from NVS (non-volatile storage) on startup.
@@ -30,8 +57,11 @@ const char* NVS_KEY_PIXEL_ID = "id";
 // Pixel ID (loaded from NVS in setup, or PIXEL_ID_UNPROVISIONED if not set)
 uint8_t pixelId = PIXEL_ID_UNPROVISIONED;
 
-// 240x240 RGB565 buffer (~115 KB) - allocated in setup() to avoid boot crash
-GFXcanvas16* canvas = nullptr;
+// Drawing target for mode screens (text, fills)
+// Canvas builds: the 240x240 RGB565 framebuffer (~115 KB) currently being drawn,
+// allocated in setup() to avoid boot crash (see frameBuffers below)
+// Band builds (USE_BAND_RENDERER): a display list replayed into small line buffers
+Adafruit_GFX* canvas = nullptr;
 
 // ===== BOARD-SPECIFIC PIN CONFIGURATION =====
 #if defined(CONFIG_IDF_TARGET_ESP32C3) || defined(ARDUINO_XIAO_ESP32C3)
@@ -45,6 +75,11 @@ GFXcanvas16* canvas = nullptr;
   #define tft_scl  8   // D8 / GPIO8 / pin 9 (strapping pin - safe for SPI CLK)
   #define tft_sda  10  // D10 / GPIO10 / pin 11
 
+  // Single framebuffer: the blocking SPI push finishes before the next frame is drawn
+  // (builds with USE_BAND_RENDERER use small band buffers from the same heap instead)
+  #define FRAME_BUFFER_COUNT 1
+  #define FRAME_BUFFER_CAPS MALLOC_CAP_8BIT
+
   // 3-parameter constructor - SPI pins set manually in setup()
   Adafruit_GC9A01A tft(tft_cs, tft_dc, tft_rst);
 
@@ -62,6 +97,13 @@ GFXcanvas16* canvas = nullptr;
 
   #define USE_HARDWARE_SPI 1
 
+  // Two DMA-capable framebuffers: render the next frame while the last one streams out
+  #define FRAME_BUFFER_COUNT 2
+  #define FRAME_BUFFER_CAPS (MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL)
+
+  // Pre-rasterized hands for all 1024 angle steps of both hand shapes (~380 KB), in PSRAM
+  #define HAND_SPAN_POOL_BYTES (400 * 1024)
+
   // 3-parameter constructor for hardware SPI - uses default SPI pins
   Adafruit_GC9A01A tft(tft_cs, tft_dc, tft_rst);
 
@@ -69,36 +111,88 @@ GFXcanvas16* canvas = nullptr;
   #error "Unsupported board! Please use ESP32-C3 or ESP32-S3."
 #endif
 
-// ---- Display geometry ----
-const int DISPLAY_WIDTH = 240;
-const int DISPLAY_HEIGHT = 240;
-const int CENTER_X = 120;
-const int CENTER_Y = 120;
+// ---- Display output ----
+// All panel writes go through the display bus; the panel tracker remembers
+// what is on the panel so clock frames only push the regions that changed.
+// The circle mask (built in setup) keeps the invisible corners off the wire.
+GC9A01ABus gc9a01Bus(tft);
+#ifdef USE_HARDWARE_SPI
+DmaDisplayBus dmaBus(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+#endif
+DisplayBus* displayBus = &gc9a01Bus;  // Switched to the DMA bus in setup() when available
+
+DamageTracker panelTracker(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+CircleMask circleMask;
+
+// Anti-aliased hands and center dot, rasterized in one pass per damaged region
+CapsuleRasterizer rasterizer;
+
+// Hand coverage cached per quantized angle (boards with room for it, see HAND_SPAN_POOL_BYTES)
+// When ready, hands are drawn at the nearest cached angle step
+HandSpanCache handSpanCache;
+
+// Frames are only rendered when the screen changed; loop() sleeps otherwise
+FrameScheduler frameScheduler;
+
+#ifdef USE_BAND_RENDERER
+// No framebuffer: screens are recorded and streamed out a band of rows at a time
+DisplayList displayList(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+BandRenderer bandRenderer;
+
+// Record a screen drawn by draw() and stream it to the panel (mode screens, OTA
+// progress, provisioning); draw() runs again for each pass when the screen does
+// not fit the display list in one
+// The panel no longer shows a clock frame afterwards, so the next one is drawn in full
+template <typename DrawScreen>
+void presentScreen(DrawScreen draw) {
+  if (!bandRenderer.presentScreen(*displayBus, displayList, circleMask, draw)) {
+    Serial.println("WARNING: Display list full - screen is incomplete");
+  }
+  panelTracker.invalidate();
+}
+#else
+FrameBuffers frameBuffers;
+
+// loop() renders; on dual-core chips a transfer task on the other core pushes
+FramePipeline framePipeline(frameBuffers, circleMask);
+
+// Submit damaged regions of the current framebuffer and move on to the next one
+void presentFrame(const DamageList& regions) {
+  framePipeline.submit(regions);
+  canvas = frameBuffers.canvas();
+}
 
-// Maximum visible radius (adjustable if needed to account for bezel)
-const int MAX_RADIUS = 120;
+// Draw a screen with draw() and push the whole canvas to the panel (mode screens,
+// OTA progress, provisioning)
+// The panel no longer shows a clock frame afterwards, so the next one is drawn in full
+template <typename DrawScreen>
+void presentScreen(DrawScreen draw) {
+  draw();
 
-// Hand parameters
-// Normal hands: 92% of max radius
-// Thin hand (3rd hand): 80% thickness of normal
-const float HAND_LENGTH_NORMAL = MAX_RADIUS * 0.92;
-const float HAND_THICKNESS_NORMAL = 13.0;
-const float HAND_THICKNESS_THIN = 9;  // 80% of normal
+  DamageList all;
+  all.screen = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+  all.setFull();
+
+  frameBuffers.contents().invalidate();
+  panelTracker.invalidate();
+  presentFrame(all);
+}
+#endif
 
 // ---- Transition/Easing Types ----
 // Use TransitionType from ESPNowComm.h (shared between master and pixels)
 
+// Uploaded easing curves (CMD_UPLOAD_EASING), used by TRANSITION_CUSTOM_1..4
+EasingCurves easingCurves;
+
 // ---- Hand State ----
-struct HandState {
-  float currentAngle;
-  float targetAngle;
-  float startAngle;
-  int direction;  // 1 for CW, -1 for CCW
-};
+// Per-hand transition state (hand_motion.h); opacity and colors are shared and
+// timed by TransitionState.
+HandStates hands = {};
 
-HandState hand1 = {0.0, 0.0, 0.0, 1};
-HandState hand2 = {0.0, 0.0, 0.0, 1};
-HandState hand3 = {0.0, 0.0, 0.0, 1};
+// Streamed hand angles (CMD_STREAM_TARGETS): while a stream is active it drives
+// the hands instead of the transition
+StreamPlayer streamPlayer;
 
 // ---- Opacity State (shared by all hands) ----
 struct OpacityState {
@@ -117,23 +211,28 @@ struct ColorState {
   uint16_t currentFg;
   uint16_t targetFg;
   uint16_t startFg;
+  uint16_t currentHand;  // Foreground blended over background at the current opacity
 };
 
-// Start with black background, white foreground
+// Start with black background, white foreground (hands invisible)
 ColorState colors = {
   GC9A01A_BLACK, GC9A01A_BLACK, GC9A01A_BLACK,
-  GC9A01A_WHITE, GC9A01A_WHITE, GC9A01A_WHITE
+  GC9A01A_WHITE, GC9A01A_WHITE, GC9A01A_WHITE,
+  GC9A01A_BLACK
 };
 
-// ---- Transition State (shared by all hands) ----
+// Colors of the running transition, precomputed per progress step by startTransition()
+ColorRamp colorRamp;
+
+// ---- Transition State (colors and opacity, shared by all hands) ----
 struct TransitionState {
   unsigned long startTime;
-  float duration;  // in seconds
-  TransitionType easing;
-  bool isActive;
+  uint32_t durationMs;
+  bool colorsActive;  // Opacity and colors still changing
+  bool isActive;      // Colors or any hand still changing
 };
 
-TransitionState transition = {0, 0.0, TRANSITION_ELASTIC, false};
+TransitionState transition = {0, 0, false, false};
 
 // Timing
 unsigned long lastUpdateTime = 0;
@@ -149,54 +248,23 @@ bool otaInProgress = false;        // True when performing OTA update
 OTAStatus currentOTAStatus = OTA_STATUS_IDLE;
 uint8_t currentOTAProgress = 0;    // 0-100
 
-// OTA requests are received via ESP-NOW callback (WiFi task context).
-// IMPORTANT: Do NOT run WiFi.mode()/scan/begin/update inside the receive callback.
-// Instead, latch the request and perform OTA from loop() context.
-static portMUX_TYPE otaRequestMux = portMUX_INITIALIZER_UNLOCKED;
-volatile bool otaRequestPending = false;
+// OTA requests are applied by applyCommand() in loop(), but WiFi.mode()/begin/update
+// must not run in the middle of command handling either: latch the request and
+// start the OTA from the top of loop().
+bool otaRequestPending = false;
 OTAStartPacket otaPendingStart;  // Changed from OTANotifyPacket to OTAStartPacket
 
 // Forward declarations for OTA
 void sendOTAAck(OTAStatus status, uint8_t progress, uint16_t errorCode = 0);
 void performOTAUpdate(const OTAStartPacket& start);
 
-// FPS tracking
+// FPS tracking (frame counts come from frameScheduler)
 unsigned long fpsLastTime = 0;
-unsigned long fpsFrames = 0;
-
-// ---- Color Palette ----
-// Each palette entry has {background, foreground} with good contrast
-struct ColorPair {
-  uint16_t bg;
-  uint16_t fg;
-  const char* name;
-};
-
-const ColorPair colorPalette[] = {
-  // Classic high contrast
-  {GC9A01A_BLACK, GC9A01A_WHITE, "White on Black"},
-  {GC9A01A_WHITE, GC9A01A_BLACK, "Black on White"},
-
-  // Earthy tones
-  {tft.color565(245, 235, 220), tft.color565(101, 67, 33), "Dark Brown on Cream"},  // Cream bg, dark brown fg
-  {tft.color565(101, 67, 33), tft.color565(245, 235, 220), "Cream on Dark Brown"},  // Dark brown bg, cream fg
-  {tft.color565(47, 79, 79), tft.color565(245, 222, 179), "Wheat on Dark Slate"},   // Dark slate bg, wheat fg
-  {tft.color565(245, 222, 179), tft.color565(47, 79, 79), "Dark Slate on Wheat"},   // Wheat bg, dark slate fg
-  {tft.color565(139, 69, 19), tft.color565(255, 248, 220), "Cornsilk on Saddle Brown"},  // Saddle brown bg, cornsilk fg
-  {tft.color565(34, 49, 63), tft.color565(236, 240, 241), "Light Gray on Navy"},    // Navy bg, light gray fg
-
-  // Bright vibrant colors
-  {tft.color565(255, 69, 0), tft.color565(255, 255, 224), "Light Yellow on Red-Orange"},     // Red-orange bg, light yellow fg
-  {tft.color565(255, 215, 0), tft.color565(139, 0, 139), "Dark Magenta on Gold"},            // Gold bg, dark magenta fg
-  {tft.color565(0, 191, 255), tft.color565(255, 255, 255), "White on Deep Sky Blue"},        // Deep sky blue bg, white fg
-  {tft.color565(255, 20, 147), tft.color565(255, 255, 240), "Ivory on Deep Pink"},           // Deep pink bg, ivory fg
-  {tft.color565(50, 205, 50), tft.color565(25, 25, 112), "Midnight Blue on Lime Green"},     // Lime green bg, midnight blue fg
-  {tft.color565(138, 43, 226), tft.color565(255, 250, 205), "Lemon Chiffon on Blue Violet"}, // Blue violet bg, lemon chiffon fg
-  {tft.color565(255, 140, 0), tft.color565(25, 25, 112), "Midnight Blue on Dark Orange"},    // Dark orange bg, midnight blue fg
-  {tft.color565(0, 206, 209), tft.color565(139, 0, 0), "Dark Red on Turquoise"},             // Turquoise bg, dark red fg
-};
-
-const int paletteSize = sizeof(colorPalette) / sizeof(ColorPair);
+uint32_t renderUs = 0;  // Render stage time (transition update + rasterization) since last report
+#ifdef USE_BAND_RENDERER
+uint32_t streamUs = 0;        // Band raster + push time since last report
+uint32_t streamedFrames = 0;  // Clock frames streamed since last report
+#endif
 
 // ---- Helper Functions ----
 
@@ -206,92 +274,24 @@ const char* getEasingName(TransitionType easing) {
   return getTransitionName(easing);
 }
 
-// ---- Easing Functions ----
-// All easing functions take t in range [0, 1] and return eased value in range [0, 1]
-
-float easeLinear(float t) {
-  return t;
-}
-
-float easeInOut(float t) {
-  // Smoothstep (S-curve)
-  return t < 0.5 ? 2 * t * t : 1 - pow(-2 * t + 2, 2) / 2;
-}
-
-float easeElasticOut(float t) {
-  if (t == 0 || t == 1) return t;
-  const float c4 = (2 * PI) / 3;
-  return pow(2, -10 * t) * sin((t * 10 - 0.75) * c4) + 1;
-}
-
-float easeBounceOut(float t) {
-  // Robert Penner's bounce ease out
-  if (t < (1.0 / 2.75)) {
-    return 7.5625 * t * t;
-  } else if (t < (2.0 / 2.75)) {
-    t -= (1.5 / 2.75);
-    return 7.5625 * t * t + 0.75;
-  } else if (t < (2.5 / 2.75)) {
-    t -= (2.25 / 2.75);
-    return 7.5625 * t * t + 0.9375;
-  } else {
-    t -= (2.625 / 2.75);
-    return 7.5625 * t * t + 0.984375;
-  }
-}
-
-float easeBackIn(float t) {
-  // Robert Penner's back ease in
-  const float c1 = 1.70158;
-  const float c3 = c1 + 1;
-  return c3 * t * t * t - c1 * t * t;
-}
-
-float easeBackOut(float t) {
-  // Robert Penner's back ease out
-  const float c1 = 1.70158;
-  const float c3 = c1 + 1;
-  return 1 + c3 * pow(t - 1, 3) + c1 * pow(t - 1, 2);
-}
-
-float easeBackInOut(float t) {
-  // Robert Penner's back ease in-out
-  const float c1 = 1.70158 * 1.525;
-  return t < 0.5
-    ? (pow(2 * t, 2) * ((c1 + 1) * 2 * t - c1)) / 2
-    : (pow(2 * t - 2, 2) * ((c1 + 1) * (t * 2 - 2) + c1) + 2) / 2;
-}
-
-// Apply the current easing function
-float applyEasing(float t, TransitionType easing) {
-  switch (easing) {
-    case TRANSITION_LINEAR: return easeLinear(t);
-    case TRANSITION_EASE_IN_OUT: return easeInOut(t);
-    case TRANSITION_ELASTIC: return easeElasticOut(t);
-    case TRANSITION_BOUNCE: return easeBounceOut(t);
-    case TRANSITION_BACK_IN: return easeBackIn(t);
-    case TRANSITION_BACK_OUT: return easeBackOut(t);
-    case TRANSITION_BACK_IN_OUT: return easeBackInOut(t);
-    case TRANSITION_INSTANT: return 1.0;  // Jump immediately to target
-    default: return t;
-  }
-}
-
 // ---- Transition Control Functions ----
 
-// Start a transition for all hands (synchronized)
-// All hands transition together with shared opacity and colors
-// durationSeconds: transition duration in seconds
-// easing: easing type to use (for angles; opacity and colors always use ease-in-out)
-void startTransition(float target1, float target2, float target3,
+void buildColorRamp();                 // Defined with the transition update functions below
+uint16_t blendColor(uint16_t bgColor, uint16_t fgColor, uint8_t opacity);  // Defined with the helper functions below
+
+// Start a transition for all hands
+// Each hand moves as `motion` gives it from startTime; opacity and colors are
+// shared and always use ease-in-out over colorDurationMs
+// startTime: millis() the transition counts from (a queued keyframe starts at its scheduled time)
+void startTransition(const HandMotion& motion,
                      uint8_t targetOpacity,
                      uint16_t targetBg, uint16_t targetFg,
-                     float durationSeconds, TransitionType easing,
-                     int8_t dir1, int8_t dir2, int8_t dir3) {
-  // Set up transition state
-  transition.startTime = millis();
-  transition.duration = durationSeconds;
-  transition.easing = easing;
+                     uint32_t colorDurationMs,
+                     unsigned long startTime) {
+  // Set up shared transition state
+  transition.startTime = startTime;
+  transition.durationMs = colorDurationMs;
+  transition.colorsActive = true;
   transition.isActive = true;
 
   // Set up shared opacity
@@ -304,88 +304,117 @@ void startTransition(float target1, float target2, float target3,
   colors.startFg = colors.currentFg;
   colors.targetFg = targetFg;
 
-  // Normalize current angles to 0-360 range before starting new transition
-  while (hand1.currentAngle < 0) hand1.currentAngle += 360.0;
-  while (hand1.currentAngle >= 360.0) hand1.currentAngle -= 360.0;
-  while (hand2.currentAngle < 0) hand2.currentAngle += 360.0;
-  while (hand2.currentAngle >= 360.0) hand2.currentAngle -= 360.0;
-  while (hand3.currentAngle < 0) hand3.currentAngle += 360.0;
-  while (hand3.currentAngle >= 360.0) hand3.currentAngle -= 360.0;
-
-  // Set up hand 1
-  hand1.startAngle = hand1.currentAngle;
-  hand1.targetAngle = target1;
-  hand1.direction = dir1;
-  // If start == target (accounting for 360° wrap), do a full 360° rotation
-  float diff1 = hand1.currentAngle - target1;
-  while (diff1 > 180.0) diff1 -= 360.0;
-  while (diff1 < -180.0) diff1 += 360.0;
-  if (abs(diff1) < 0.1) {
-    hand1.targetAngle = hand1.currentAngle + (360.0 * hand1.direction);
+  startHands(hands, motion, startTime);
+
+  // Colors only depend on progress from here on: evaluate them once per ramp step
+  buildColorRamp();
+}
+
+// When the running transition (every hand and the colors) ends, in millis()
+// Spinning hands are not waited for: movements that follow leave them alone
+uint32_t transitionEndMs() {
+  uint32_t end = transition.startTime + transition.durationMs;
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    if (hands.spinMask & (1 << i)) continue;
+    uint32_t handEnd = hands.startTime[i] + hands.durationMs[i];
+    if ((int32_t)(handEnd - end) > 0) end = handEnd;
   }
+  return end;
+}
 
-  // Set up hand 2
-  hand2.startAngle = hand2.currentAngle;
-  hand2.targetAngle = target2;
-  hand2.direction = dir2;
-  float diff2 = hand2.currentAngle - target2;
-  while (diff2 > 180.0) diff2 -= 360.0;
-  while (diff2 < -180.0) diff2 += 360.0;
-  if (abs(diff2) < 0.1) {
-    hand2.targetAngle = hand2.currentAngle + (360.0 * hand2.direction);
+// Start a commanded movement (CMD_SET_ANGLES or a queued keyframe): colors from
+// the palette, directions resolved against the current hand angles
+void startKeyframe(const Keyframe& keyframe, unsigned long startTime) {
+  // Commanded movements take the hands back from a stream
+  streamPlayer.reset();
+
+  // Get colors from palette
+  uint16_t targetBg, targetFg;
+  if (keyframe.colorIndex < paletteSize) {
+    targetBg = colorPalette[keyframe.colorIndex].bg;
+    targetFg = colorPalette[keyframe.colorIndex].fg;
+  } else {
+    // Invalid index, use current colors
+    targetBg = colors.currentBg;
+    targetFg = colors.currentFg;
   }
 
-  // Set up hand 3
-  hand3.startAngle = hand3.currentAngle;
-  hand3.targetAngle = target3;
-  hand3.direction = dir3;
-  float diff3 = hand3.currentAngle - target3;
-  while (diff3 > 180.0) diff3 -= 360.0;
-  while (diff3 < -180.0) diff3 += 360.0;
-  if (abs(diff3) < 0.1) {
-    hand3.targetAngle = hand3.currentAngle + (360.0 * hand3.direction);
+  // With a waypoint the first direction is resolved toward the waypoint, the
+  // direction after it from the waypoint to the target
+  HandMotion motion;
+  motion.waypointMask = keyframe.waypointMask;
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    bool viaWaypoint = keyframe.waypointMask & (1 << i);
+    float firstStop = viaWaypoint ? keyframe.waypoints[i] : keyframe.targets[i];
+    motion.targets[i] = keyframe.targets[i];
+    motion.dirs[i] = resolveDirection(keyframe.dirs[i], firstStop, hands.currentAngle[i]);
+    motion.turns[i] = keyframe.turns[i];
+    motion.waypoints[i] = keyframe.waypoints[i];
+    motion.waypointDirs[i] = viaWaypoint
+      ? resolveDirection(keyframe.waypointDirs[i], keyframe.targets[i], keyframe.waypoints[i])
+      : motion.dirs[i];
+    motion.easings[i] = keyframe.easings[i];
+    motion.durationsMs[i] = keyframe.durationsMs[i];
   }
+  motion.springFrequencyHz = keyframe.springFrequencyHz;
+  motion.springDampingRatio = keyframe.springDampingRatio;
+
+  // Debug output
+  LOG_DEBUG("Pixel %u: Targets=(%.0f,%.0f,%.0f) Dirs=(%u,%u,%u) -> (%d,%d,%d)",
+            pixelId, keyframe.targets[0], keyframe.targets[1], keyframe.targets[2],
+            keyframe.dirs[0], keyframe.dirs[1], keyframe.dirs[2],
+            motion.dirs[0], motion.dirs[1], motion.dirs[2]);
+  LOG_DEBUG("Pixel %u: Current=(%.0f,%.0f,%.0f)",
+            pixelId, hands.currentAngle[0], hands.currentAngle[1], hands.currentAngle[2]);
+
+  startTransition(motion, keyframe.opacity, targetBg, targetFg, keyframe.colorDurationMs, startTime);
 }
 
-// Update a hand's angle based on transition state
-void updateHandAngle(HandState &hand, float t) {
-  // Apply easing function for angle (uses transition easing)
-  float easedT = applyEasing(t, transition.easing);
-
-  // Calculate angle difference
-  float diff = hand.targetAngle - hand.startAngle;
-
-  // For full 360° rotations, diff is already set correctly (±360)
-  // For normal transitions, apply direction consistently
-  if (abs(diff) < 359.0) {  // Not a full rotation
-    // Normalize diff to 0-360 range first
-    while (diff < 0) diff += 360.0;
-    while (diff >= 360.0) diff -= 360.0;
-
-    // Now apply the specified direction
-    if (hand.direction > 0) {
-      // Clockwise (positive direction): keep diff as-is (0-360)
-      // This means we always rotate CW by the calculated amount
-    } else {
-      // Counter-clockwise (negative direction): go the other way
-      // If diff is 90, we want to go -270 (CCW 270°)
-      diff = diff - 360.0;
-    }
-  }
+#ifdef USE_FIXED_POINT_MATH
+// ---- Fixed-point transition path (no FPU) ----
+// Progress t is Q16 (65536 = done); start and sweep are converted once per transition
+
+// Progress of `elapsedMs` into a span of `durationMs` (Q16, capped at done)
+q16_t progressAt(uint32_t elapsedMs, uint32_t durationMs) {
+  if (elapsedMs >= durationMs) return Q16_ONE;
+  return (q16_t)(((uint64_t)elapsedMs << 16) / durationMs);
+}
+
+// Interpolate between two RGB565 colors (Q16 t)
+uint16_t lerpColorFx(uint16_t color1, uint16_t color2, q16_t t) {
+  int32_t r1 = (color1 >> 11) & 0x1F;
+  int32_t g1 = (color1 >> 5) & 0x3F;
+  int32_t b1 = color1 & 0x1F;
+
+  int32_t r = r1 + fxMul((int32_t)((color2 >> 11) & 0x1F) - r1, t);
+  int32_t g = g1 + fxMul((int32_t)((color2 >> 5) & 0x3F) - g1, t);
+  int32_t b = b1 + fxMul((int32_t)(color2 & 0x1F) - b1, t);
 
-  // Interpolate angle
-  hand.currentAngle = hand.startAngle + diff * easedT;
+  return ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
+}
 
-  // Keep in 0-360 range
-  while (hand.currentAngle < 0) hand.currentAngle += 360.0;
-  while (hand.currentAngle >= 360.0) hand.currentAngle -= 360.0;
+// Opacity and colors at progress t (always ease-in-out)
+ColorRampEntry colorsAt(q16_t t) {
+  q16_t easedT = fxEaseInOut(t);
+  ColorRampEntry entry;
+  entry.opacity = opacity.start + (opacity.target - opacity.start) * easedT / Q16_ONE;
+  entry.bg = lerpColorFx(colors.startBg, colors.targetBg, easedT);
+  entry.fg = lerpColorFx(colors.startFg, colors.targetFg, easedT);
+  entry.hand = blendColor(entry.bg, entry.fg, entry.opacity);
+  return entry;
 }
 
-// Update shared opacity based on transition state
-void updateOpacity(float t) {
-  // Interpolate opacity (always uses ease-in-out)
-  float opacityT = easeInOut(t);
-  opacity.current = opacity.start + (opacity.target - opacity.start) * opacityT;
+// Progress of ramp half step h (step i is half step 2 * i)
+q16_t colorRampProgress(uint16_t h) {
+  return (q16_t)(((uint32_t)h << 15) / COLOR_RAMP_STEPS);
+}
+
+#else
+// Progress of `elapsedMs` into a span of `durationMs` (0.0 to 1.0, capped at done)
+// A zero-length span (instant keyframe) is already done
+float progressAt(uint32_t elapsedMs, uint32_t durationMs) {
+  if (elapsedMs >= durationMs) return 1.0;
+  return (float)elapsedMs / durationMs;
 }
 
 // Interpolate between two RGB565 colors
@@ -408,38 +437,89 @@ uint16_t lerpColor(uint16_t color1, uint16_t color2, float t) {
   return (r << 11) | (g << 5) | b;
 }
 
-// Update colors based on transition state
-void updateColors(float t) {
-  // Interpolate colors (always uses ease-in-out)
-  float colorT = easeInOut(t);
-  colors.currentBg = lerpColor(colors.startBg, colors.targetBg, colorT);
-  colors.currentFg = lerpColor(colors.startFg, colors.targetFg, colorT);
+// Opacity and colors at progress t (always ease-in-out)
+ColorRampEntry colorsAt(float t) {
+  float easedT = easeInOut(t);
+  ColorRampEntry entry;
+  entry.opacity = opacity.start + (opacity.target - opacity.start) * easedT;
+  entry.bg = lerpColor(colors.startBg, colors.targetBg, easedT);
+  entry.fg = lerpColor(colors.startFg, colors.targetFg, easedT);
+  entry.hand = blendColor(entry.bg, entry.fg, entry.opacity);
+  return entry;
 }
 
-// ---- Helper functions ----
+// Progress of ramp half step h (step i is half step 2 * i)
+float colorRampProgress(uint16_t h) {
+  return (float)h / (2 * COLOR_RAMP_STEPS);
+}
+#endif
 
-// Blend a color with background based on opacity (0-255)
-// bgColor and fgColor are RGB565 format
-uint16_t blendColor(uint16_t bgColor, uint16_t fgColor, uint8_t opacity) {
-  if (opacity == 255) return fgColor;
-  if (opacity == 0) return bgColor;
+// Evaluate the transition's colors at every ramp half step (endpoints are fixed by now)
+// Each step's hand color is centered on the half steps around it; see color_ramp.h
+void buildColorRamp() {
+  ColorRampEntry before = colorsAt(colorRampProgress(0));
+  for (uint16_t i = 0; i <= COLOR_RAMP_STEPS; i++) {
+    ColorRampEntry entry = colorsAt(colorRampProgress(2 * i));
+    ColorRampEntry after = colorsAt(colorRampProgress(min(2 * i + 1, 2 * COLOR_RAMP_STEPS)));
+    entry.hand = midrange565(before.hand, entry.hand, after.hand);
+    colorRamp.set(i, entry);
+    before = after;
+  }
+}
 
-  // Extract RGB components from RGB565
-  uint8_t bgR = (bgColor >> 11) & 0x1F;
-  uint8_t bgG = (bgColor >> 5) & 0x3F;
-  uint8_t bgB = bgColor & 0x1F;
+// Take the opacity and colors for this frame from the ramp
+void updateColors(const ColorRampEntry& entry) {
+  opacity.current = entry.opacity;
+  colors.currentBg = entry.bg;
+  colors.currentFg = entry.fg;
+  colors.currentHand = entry.hand;
+}
+
+// Advance the running transition to `now`: every moving hand in one pass over
+// the hand arrays, then the shared colors. Hands and colors that reach the end
+// of their span (spring hands: that settle) land exactly on their targets
+// (angles normalized to 0-360)
+void updateTransition(unsigned long now) {
+  updateHands(hands, easingCurves, now);
+
+  if (transition.colorsActive) {
+    uint32_t elapsedMs = now - transition.startTime;
+    if (elapsedMs >= transition.durationMs) {
+      // Exact target colors, not the ramp's centered last step
+      updateColors(colorsAt(colorRampProgress(2 * COLOR_RAMP_STEPS)));
+      transition.colorsActive = false;
+    } else {
+      updateColors(colorRamp.at(progressAt(elapsedMs, transition.durationMs)));
+    }
+  }
+
+  transition.isActive = transition.colorsActive || hands.activeMask != 0;
+}
 
-  uint8_t fgR = (fgColor >> 11) & 0x1F;
-  uint8_t fgG = (fgColor >> 5) & 0x3F;
-  uint8_t fgB = fgColor & 0x1F;
+// End the running transition on its targets (angles normalized to 0-360)
+// Spring hands still settling keep moving, so the next movement inherits their
+// velocity; spinning hands keep spinning
+void finishTransition() {
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    if (hands.spinMask & (1 << i)) continue;
+    if ((hands.activeMask & (1 << i)) && hands.easing[i] == TRANSITION_SPRING) continue;
+    hands.currentAngle[i] = wrapDegrees(hands.targetAngle[i]);
+    hands.activeMask &= ~(1 << i);
+  }
 
-  // Blend (alpha blend formula)
-  uint8_t outR = ((fgR * opacity) + (bgR * (255 - opacity))) / 255;
-  uint8_t outG = ((fgG * opacity) + (bgG * (255 - opacity))) / 255;
-  uint8_t outB = ((fgB * opacity) + (bgB * (255 - opacity))) / 255;
+  // Exact target colors, not the ramp's centered last step
+  updateColors(colorsAt(colorRampProgress(2 * COLOR_RAMP_STEPS)));
+  transition.colorsActive = false;
+  transition.isActive = hands.activeMask != 0;
+}
 
-  // Pack back to RGB565
-  return (outR << 11) | (outG << 5) | outB;
+// ---- Helper functions ----
+
+// Blend a color with background based on opacity (0-255)
+// bgColor and fgColor are RGB565 format
+uint16_t blendColor(uint16_t bgColor, uint16_t fgColor, uint8_t opacity) {
+  // Only called while building the color ramp, so it keeps the exact /255 rounding
+  return blend565Exact(bgColor, fgColor, opacity);
 }
 
 // ---- Version Mode State ----
@@ -449,16 +529,149 @@ bool versionMode = false;  // If true, show version info on screen
 bool highlightMode = false;  // If true, show highlight state on screen
 HighlightState currentHighlightState = HIGHLIGHT_IDLE;
 
+// ---- Pixel ID Confirmation ----
+// Set by CMD_SET_PIXEL_ID; loop() draws the green ID flash
+bool pixelIdFlashPending = false;
+
+// ---- Discovery Response ----
+// Responses are spread over a random delay to avoid collisions between pixels;
+// loop() sends the response once the delay has passed
+bool discoveryResponsePending = false;
+unsigned long discoveryResponseAt = 0;
+
+// ---- Keyframe Queue ----
+// Choreography queued by CMD_QUEUE_KEYFRAMES; loop() starts each keyframe on schedule
+KeyframeQueue keyframes;
+
+// ---- Received Command Queue ----
+// The receive callback runs in the WiFi task: it only validates and enqueues.
+// loop() drains the queue at the start of each frame and applies the commands.
+
+// A received packet waiting to be applied
+struct ReceivedCommand {
+  ESPNowPacket packet;
+  uint8_t length;
+  uint32_t receivedAt;  // millis() in the receive callback (start delays count from here)
+};
+
+const uint8_t COMMAND_QUEUE_SIZE = 16;  // Packets buffered while a frame renders
+CommandQueue<ReceivedCommand, COMMAND_QUEUE_SIZE> commandQueue;
+volatile uint32_t commandsRejected = 0;  // Unknown or truncated packets (receive callback)
+
+// Smallest valid packet for each command a pixel handles (0: not handled by pixels)
+size_t commandPacketSize(CommandType command) {
+  switch (command) {
+    case CMD_SET_ANGLES:   return sizeof(AngleCommandPacket);
+    case CMD_PING:         return sizeof(CommandType);  // Timestamp is not used
+    case CMD_RESET:        return sizeof(CommandType);
+    case CMD_SET_PIXEL_ID: return sizeof(SetPixelIdPacket);
+    case CMD_DISCOVERY:    return sizeof(DiscoveryCommandPacket);
+    case CMD_HIGHLIGHT:    return sizeof(HighlightPacket);
+    case CMD_OTA_START:    return sizeof(OTAStartPacket);
+    case CMD_GET_VERSION:  return sizeof(GetVersionPacket);
+    case CMD_GET_PROFILE:  return sizeof(GetProfilePacket);
+    case CMD_QUEUE_KEYFRAMES: return offsetof(KeyframePacket, keyframes);  // Plus `count` entries
+    case CMD_STREAM_TARGETS: return sizeof(StreamTargetsPacket);
+    case CMD_UPLOAD_EASING: return sizeof(EasingUploadPacket);
+    case CMD_SPIN_HANDS:   return sizeof(SpinPacket);
+    case CMD_GRID_PATTERN: return sizeof(GridPatternPacket);
+    default:               return 0;  // Responses from other pixels, unknown commands
+  }
+}
+
+// ---- Stage Profile ----
+// Frame stage histograms (USE_STAGE_PROFILER), reported on CMD_GET_PROFILE
+#ifdef USE_STAGE_PROFILER
+static_assert(PROFILE_STAGE_COUNT == PROFILE_MAX_STAGES, "ProfileResponsePacket carries the stages in ProfileStage order");
+#endif
+
+// Send the stage summaries to the master, and print them here if asked
+void reportStageProfile(bool print, bool reset) {
+  ESPNowPacket response;
+  memset(&response, 0, sizeof(ProfileResponsePacket));
+  response.profileResponse.command = CMD_PROFILE_RESPONSE;
+  response.profileResponse.pixelId = pixelId;
+
+#ifdef USE_STAGE_PROFILER
+  response.profileResponse.stageCount = PROFILE_STAGE_COUNT;
+  for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+    StageSummary summary = StageProfiler::summarize((ProfileStage)i);
+    ProfileStageSummary& out = response.profileResponse.stages[i];
+    out.samples = summary.samples;
+    out.p50Us = min<uint32_t>(summary.p50Us, UINT16_MAX);
+    out.p95Us = min<uint32_t>(summary.p95Us, UINT16_MAX);
+    out.p99Us = min<uint32_t>(summary.p99Us, UINT16_MAX);
+    out.maxUs = summary.maxUs;
+
+    if (print) {
+      LOG_INFO("Profile %s: n=%u p50=%u p95=%u p99=%u max=%u us",
+               StageProfiler::stageName((ProfileStage)i), summary.samples,
+               summary.p50Us, summary.p95Us, summary.p99Us, summary.maxUs);
+    }
+  }
+  if (reset) StageProfiler::reset();
+#else
+  if (print) LOG_INFO("Profile: built without USE_STAGE_PROFILER");
+#endif
+
+  ESPNowComm::sendPacket(&response, sizeof(ProfileResponsePacket));
+}
+
 // ---- ESP-NOW Packet Handler ----
 
-// Called when an ESP-NOW packet is received
+// Called in the WiFi task when an ESP-NOW packet is received
+// Must not touch render state: validate, enqueue and wake loop()
 void onPacketReceived(const ESPNowPacket* packet, size_t len) {
+  // The command byte itself must have arrived before it can be read
+  if (len < sizeof(CommandType)) {
+    commandsRejected++;
+    return;
+  }
+
+  size_t needed = commandPacketSize(packet->command);
+  if (needed == 0 || len < needed) {
+    commandsRejected++;
+    return;
+  }
+  if (packet->command == CMD_QUEUE_KEYFRAMES &&
+      (packet->keyframes.count > KEYFRAMES_PER_PACKET || len < packet->keyframes.length())) {
+    commandsRejected++;
+    return;
+  }
+
+  ReceivedCommand received;
+  memcpy(&received.packet, packet, len);
+  received.length = len;
+  received.receivedAt = millis();
+  commandQueue.push(received);  // A full queue counts the drop
+
+  // Whatever the packet changes, loop() should look at it now rather than after its idle sleep
+  frameScheduler.wake();
+}
+
+// Play a commanded movement (CMD_SET_ANGLES, CMD_GRID_PATTERN) for this pixel
+// A live command overrides queued choreography
+void playCommandedMotion(const Keyframe& motion, uint16_t startDelayMs, uint32_t receivedAt) {
+  if (startDelayMs == 0) {
+    // Start the transition with specified directions; keyframes queued later follow it
+    startKeyframe(motion, millis());
+    keyframes.clear(transitionEndMs());
+  } else {
+    // Wave member: start delayed from receipt, as the only queued keyframe
+    // (the running transition carries on until then)
+    keyframes.clear(receivedAt + startDelayMs);
+    keyframes.push(motion, millis());
+  }
+}
+
+// Apply one received command (loop() context)
+void applyCommand(const ESPNowPacket* packet, uint32_t receivedAt) {
   lastPacketTime = millis();
 
   // Clear error state when we receive a packet
   if (errorState) {
     errorState = false;
-    Serial.println("ESP-NOW: Connection restored!");
+    LOG_INFO("ESP-NOW: Connection restored!");
   }
 
   // Handle different command types
@@ -468,9 +681,7 @@ void onPacketReceived(const ESPNowPacket* packet, size_t len) {
 
       // Check if this pixel is targeted by this command
       if (!cmd.isPixelTargeted(pixelId)) {
-        Serial.print("ESP-NOW: Pixel ");
-        Serial.print(pixelId);
-        Serial.println(" not targeted, ignoring command");
+        LOG_DEBUG("ESP-NOW: Pixel %u not targeted, ignoring command", pixelId);
         break;
       }
 
@@ -478,130 +689,103 @@ void onPacketReceived(const ESPNowPacket* packet, size_t len) {
       versionMode = false;
       highlightMode = false;
 
-      // Extract angles for this pixel
-      float target1, target2, target3;
-      cmd.getPixelAngles(pixelId, target1, target2, target3);
-
-      // Extract directions for this pixel
-      RotationDirection dir1, dir2, dir3;
-      cmd.getPixelDirections(pixelId, dir1, dir2, dir3);
-
-      // Extract color and opacity for this pixel
-      uint8_t colorIndex = cmd.colorIndices[pixelId];
-      uint8_t targetOpacity = cmd.opacities[pixelId];
-
-      // Get transition type directly (no mapping needed - they're the same now!)
-      TransitionType easing = cmd.transition;
-
-      // Convert duration from compact format to seconds
-      float durationSec = durationToFloat(cmd.duration);
-
-      // Get colors from palette
-      uint16_t targetBg, targetFg;
-      if (colorIndex < paletteSize) {
-        targetBg = colorPalette[colorIndex].bg;
-        targetFg = colorPalette[colorIndex].fg;
-      } else {
-        // Invalid index, use current colors
-        targetBg = colors.currentBg;
-        targetFg = colors.currentFg;
+      // Extract angles, directions, per-hand timing, color and opacity for this pixel
+      // (duration_t is in 0.25 s steps)
+      Keyframe motion;
+      cmd.getPixelAngles(pixelId, motion.targets[0], motion.targets[1], motion.targets[2]);
+      cmd.getPixelDirections(pixelId, motion.dirs[0], motion.dirs[1], motion.dirs[2]);
+      motion.springFrequencyHz = cmd.getSpringFrequencyHz();
+      motion.springDampingRatio = cmd.getSpringDampingRatio();
+      motion.waypointMask = cmd.waypointMask & ((1 << HANDS_PER_PIXEL) - 1);
+      bool springs = false;
+      for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+        motion.turns[i] = cmd.getPixelTurns(pixelId, i);
+        motion.waypoints[i] = angleToFloat(cmd.waypoints[i]);
+        motion.waypointDirs[i] = cmd.getWaypointDirection(i);
+        motion.setHandTiming(i, cmd.getHandTransition(i), (uint32_t)cmd.getHandDuration(i) * 250);
+        springs |= (motion.easings[i] == TRANSITION_SPRING);
       }
-
-      // Convert rotation directions to int8_t for startTransition
-      // DIR_SHORTEST (0) = choose shortest path based on angle difference
-      // DIR_CW (1) = clockwise (1)
-      // DIR_CCW (2) = counter-clockwise (-1)
-      int8_t direction1, direction2, direction3;
-
-      if (dir1 == DIR_SHORTEST) {
-        // Choose shortest path
-        float diff = target1 - hand1.currentAngle;
-        while (diff > 180.0) diff -= 360.0;
-        while (diff < -180.0) diff += 360.0;
-        direction1 = (diff >= 0) ? 1 : -1;
-      } else {
-        direction1 = (dir1 == DIR_CW) ? 1 : -1;
+      motion.colorDurationMs = (uint32_t)cmd.duration * 250;
+      motion.colorIndex = cmd.colorIndices[pixelId];
+      motion.opacity = cmd.opacities[pixelId];
+      motion.delayMs = 0;
+
+      uint16_t startDelayMs = cmd.getPixelStartDelayMs(pixelId);
+      playCommandedMotion(motion, startDelayMs, receivedAt);
+
+      LOG_INFO("ESP-NOW: Angles [%.0f°, %.0f°, %.0f°] dur=%.2fs ease=%s color=%u opacity=%u delay=%ums",
+               motion.targets[0], motion.targets[1], motion.targets[2], durationToFloat(cmd.duration),
+               getEasingName(cmd.transition), motion.colorIndex, motion.opacity, startDelayMs);
+      if (cmd.handTimingMask) {
+        LOG_INFO("ESP-NOW: Hand timing [%s %.2fs, %s %.2fs, %s %.2fs]",
+                 getEasingName(motion.easings[0]), motion.durationsMs[0] / 1000.0f,
+                 getEasingName(motion.easings[1]), motion.durationsMs[1] / 1000.0f,
+                 getEasingName(motion.easings[2]), motion.durationsMs[2] / 1000.0f);
       }
-
-      if (dir2 == DIR_SHORTEST) {
-        float diff = target2 - hand2.currentAngle;
-        while (diff > 180.0) diff -= 360.0;
-        while (diff < -180.0) diff += 360.0;
-        direction2 = (diff >= 0) ? 1 : -1;
-      } else {
-        direction2 = (dir2 == DIR_CW) ? 1 : -1;
+      if (springs) {
+        LOG_INFO("ESP-NOW: Spring %.1fHz damping %.2f (settles in ~%.2fs)",
+                 motion.springFrequencyHz, motion.springDampingRatio,
+                 springSettleMs(motion.springFrequencyHz, motion.springDampingRatio) / 1000.0f);
+      }
+      if (motion.turns[0] || motion.turns[1] || motion.turns[2] || motion.waypointMask) {
+        LOG_INFO("ESP-NOW: Extra turns [%u, %u, %u] waypoints 0x%X [%.0f°, %.0f°, %.0f°]",
+                 motion.turns[0], motion.turns[1], motion.turns[2], motion.waypointMask,
+                 motion.waypoints[0], motion.waypoints[1], motion.waypoints[2]);
       }
+      break;
+    }
 
-      if (dir3 == DIR_SHORTEST) {
-        float diff = target3 - hand3.currentAngle;
-        while (diff > 180.0) diff -= 360.0;
-        while (diff < -180.0) diff += 360.0;
-        direction3 = (diff >= 0) ? 1 : -1;
-      } else {
-        direction3 = (dir3 == DIR_CW) ? 1 : -1;
+    case CMD_GRID_PATTERN: {
+      const GridPatternPacket& cmd = packet->gridPattern;
+      if (!cmd.isPixelTargeted(pixelId)) break;
+
+      // Exit version/highlight mode when we receive a new command
+      versionMode = false;
+      highlightMode = false;
+
+      // Work out this pixel's values from its row and column: from here on it is
+      // the movement an angle command with the expanded values would start
+      Keyframe motion;
+      motion.springFrequencyHz = SPRING_DEFAULT_FREQUENCY_HZ;
+      motion.springDampingRatio = SPRING_DEFAULT_DAMPING_RATIO;
+      motion.waypointMask = 0;
+      for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+        motion.targets[i] = cmd.getPixelAngle(pixelId, i);
+        motion.dirs[i] = cmd.getPixelDirection(pixelId, i);
+        motion.turns[i] = cmd.getHandTurns(i);
+        motion.setHandTiming(i, cmd.transition, (uint32_t)cmd.duration * 250);
       }
+      motion.colorDurationMs = (uint32_t)cmd.duration * 250;
+      motion.colorIndex = cmd.getPixelColorIndex(pixelId);
+      motion.opacity = cmd.opacity;
+      motion.delayMs = 0;
+
+      uint16_t startDelayMs = cmd.getPixelStartDelayMs(pixelId);
+      playCommandedMotion(motion, startDelayMs, receivedAt);
 
-      // Debug output
-      Serial.print("Pixel ");
-      Serial.print(pixelId);
-      Serial.print(": Targets=(");
-      Serial.print(target1, 0);
-      Serial.print(",");
-      Serial.print(target2, 0);
-      Serial.print(",");
-      Serial.print(target3, 0);
-      Serial.print(") Dirs=(");
-      Serial.print(dir1);
-      Serial.print(",");
-      Serial.print(dir2);
-      Serial.print(",");
-      Serial.print(dir3);
-      Serial.print(") -> (");
-      Serial.print(direction1);
-      Serial.print(",");
-      Serial.print(direction2);
-      Serial.print(",");
-      Serial.print(direction3);
-      Serial.print(") Current=(");
-      Serial.print(hand1.currentAngle, 0);
-      Serial.print(",");
-      Serial.print(hand2.currentAngle, 0);
-      Serial.print(",");
-      Serial.print(hand3.currentAngle, 0);
-      Serial.println(")");
-
-      // Start the transition with specified directions
-      startTransition(target1, target2, target3, targetOpacity, targetBg, targetFg, durationSec, easing,
-                      direction1, direction2, direction3);
-
-      Serial.print("ESP-NOW: Angles [");
-      Serial.print(target1, 0);
-      Serial.print("°, ");
-      Serial.print(target2, 0);
-      Serial.print("°, ");
-      Serial.print(target3, 0);
-      Serial.print("°] dur=");
-      Serial.print(durationSec, 2);
-      Serial.print("s ease=");
-      Serial.print(getEasingName(easing));
-      Serial.print(" color=");
-      Serial.print(colorIndex);
-      Serial.print(" opacity=");
-      Serial.println(targetOpacity);
+      LOG_INFO("ESP-NOW: Grid pattern -> [%.0f°, %.0f°, %.0f°] dur=%.2fs ease=%s color=%u opacity=%u delay=%ums",
+               motion.targets[0], motion.targets[1], motion.targets[2], durationToFloat(cmd.duration),
+               getEasingName(cmd.transition), motion.colorIndex, motion.opacity, startDelayMs);
       break;
     }
 
     case CMD_PING:
-      Serial.println("ESP-NOW: Ping received");
+      LOG_INFO("ESP-NOW: Ping received");
       break;
 
     case CMD_RESET:
-      Serial.println("ESP-NOW: Reset command received");
+      LOG_INFO("ESP-NOW: Reset command received");
       // Clear all special display modes
       versionMode = false;
       highlightMode = false;
       errorState = false;
-      Serial.println("ESP-NOW: All display modes cleared");
+      keyframes.clear(millis());
+      streamPlayer.reset();
+      for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+        if (hands.spinMask & (1 << i)) stopSpin(hands, i);
+      }
+      transition.isActive = transition.colorsActive || hands.activeMask != 0;
+      LOG_INFO("ESP-NOW: All display modes cleared");
       break;
 
     case CMD_SET_PIXEL_ID: {
@@ -627,20 +811,12 @@ void onPacketReceived(const ESPNowPacket* packet, size_t len) {
         uint8_t oldId = pixelId;
         pixelId = cmd.pixelId;
 
-        Serial.print("ESP-NOW: Pixel ID assigned: ");
-        Serial.print(oldId);
-        Serial.print(" -> ");
-        Serial.println(pixelId);
-        Serial.println("ID stored in NVS (persists across reboots)");
-
-        // Show visual confirmation - briefly flash green
-        canvas->fillScreen(0x07E0);  // Green
-        canvas->setTextColor(0x0000);  // Black text
-        canvas->setTextSize(8);
-        canvas->setCursor(pixelId < 10 ? 95 : 65, 85);
-        canvas->print(pixelId);
-        tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
-        delay(500);
+        LOG_INFO("ESP-NOW: Pixel ID assigned: %u -> %u", oldId, pixelId);
+        LOG_INFO("ID stored in NVS (persists across reboots)");
+
+        // Show visual confirmation - briefly flash green (drawn from loop(),
+        // which owns the framebuffers)
+        pixelIdFlashPending = true;
       }
       break;
     }
@@ -668,28 +844,15 @@ void onPacketReceived(const ESPNowPacket* packet, size_t len) {
         // Enter discovery waiting mode - show "?"
         highlightMode = true;
         currentHighlightState = HIGHLIGHT_DISCOVERY_WAITING;
-        Serial.println("ESP-NOW: Entering discovery waiting mode (showing ?)");
+        LOG_INFO("ESP-NOW: Entering discovery waiting mode (showing ?)");
 
-        // Random delay (0-2000ms) to avoid packet collisions
+        // Random delay (0-2000ms) to avoid packet collisions; sent from loop()
         uint16_t delayMs = random(2000);
-        Serial.print("ESP-NOW: Discovery received, responding in ");
-        Serial.print(delayMs);
-        Serial.println("ms");
-        delay(delayMs);
-
-        // Send response with our MAC and current ID
-        ESPNowPacket response;
-        response.discoveryResponse.command = CMD_DISCOVERY_RESPONSE;  // CRITICAL: Use separate command to prevent infinite loop!
-        memcpy(response.discoveryResponse.mac, myMac, 6);
-        response.discoveryResponse.currentId = pixelId;
-
-        if (ESPNowComm::sendPacket(&response, sizeof(DiscoveryResponsePacket))) {
-          Serial.println("ESP-NOW: Discovery response sent");
-        } else {
-          Serial.println("ESP-NOW: Discovery response FAILED");
-        }
+        LOG_INFO("ESP-NOW: Discovery received, responding in %ums", delayMs);
+        discoveryResponseAt = millis() + delayMs;
+        discoveryResponsePending = true;
       } else {
-        Serial.println("ESP-NOW: Discovery received but we're excluded (already discovered)");
+        LOG_INFO("ESP-NOW: Discovery received but we're excluded (already discovered)");
       }
       break;
     }
@@ -703,8 +866,7 @@ void onPacketReceived(const ESPNowPacket* packet, size_t len) {
 
       // Check if this command is for us
       if (memcmp(cmd.targetMac, myMac, 6) == 0) {
-        Serial.print("ESP-NOW: Highlight state ");
-        Serial.println(cmd.state);
+        LOG_INFO("ESP-NOW: Highlight state %u", cmd.state);
 
         // Enter highlight mode and store the state
         highlightMode = true;
@@ -731,17 +893,15 @@ void onPacketReceived(const ESPNowPacket* packet, size_t len) {
       Serial.print("  Size: ");
       Serial.println(start.firmwareSize);
 
-      // Latch OTA request; perform it later from loop() (safe context)
-      portENTER_CRITICAL(&otaRequestMux);
+      // Latch OTA request; performed at the top of the next loop()
       otaPendingStart = start;
       otaRequestPending = true;
-      portEXIT_CRITICAL(&otaRequestMux);
       break;
     }
 
     case CMD_GET_VERSION: {
       const GetVersionPacket& cmd = packet->getVersion;
-      Serial.println("ESP-NOW: Get version command received");
+      LOG_INFO("ESP-NOW: Get version command received");
 
       // Send version response back to master
       ESPNowPacket response;
@@ -754,15 +914,164 @@ void onPacketReceived(const ESPNowPacket* packet, size_t len) {
       // Display version on screen if requested
       if (cmd.displayOnScreen) {
         versionMode = true;  // Enter version mode to persist display
-        Serial.print("ESP-NOW: Version mode activated for pixel ");
-        Serial.println(pixelId);
+        LOG_INFO("ESP-NOW: Version mode activated for pixel %u", pixelId);
+      }
+      break;
+    }
+
+    case CMD_GET_PROFILE: {
+      const GetProfilePacket& cmd = packet->getProfile;
+      if (cmd.targetPixelId != pixelId) break;
+      reportStageProfile(cmd.printOnPixel, cmd.reset);
+      break;
+    }
+
+    case CMD_STREAM_TARGETS: {
+      const StreamTargetsPacket& cmd = packet->streamTargets;
+      if (pixelId >= MAX_PIXELS) break;  // Unassigned pixel: no slot in the packet
+
+      // Exit version/highlight mode: streamed angles play on the clock screen
+      versionMode = false;
+      highlightMode = false;
+
+      unsigned long now = millis();
+      if (!streamPlayer.isActive(now)) {
+        // The stream takes the hands over from any transition or queued keyframes
+        // (a running color change carries on)
+        streamPlayer.reset();
+        keyframes.clear(now);
+        hands.activeMask = 0;
+        hands.spinMask = 0;
+        transition.isActive = transition.colorsActive;
+        LOG_INFO("ESP-NOW: Streaming started");
       }
+
+      float angles[HANDS_PER_PIXEL];
+      for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+        angles[i] = streamAngleToFloat(cmd.angles[pixelId][i]);
+      }
+      streamPlayer.addSample(cmd.sequence, cmd.timestampMs, receivedAt, angles);
+      break;
+    }
+
+    case CMD_SPIN_HANDS: {
+      const SpinPacket& cmd = packet->spin;
+      if (!cmd.isPixelTargeted(pixelId)) break;
+
+      // Exit version/highlight mode: spinning hands show on the clock screen
+      versionMode = false;
+      highlightMode = false;
+
+      // Spinning hands follow their own clock, not a stream
+      streamPlayer.reset();
+
+      // Spins count from receipt, so pixels given phases turn in step
+      // (an unassigned pixel has no phase slot and spins from where it is)
+      bool fromPhase = (cmd.flags & SPIN_FLAG_PHASE) && pixelId < MAX_PIXELS;
+      for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+        if (!(cmd.handMask & (1 << i))) continue;
+        int32_t velocity = cmd.velocities[i];
+        if (velocity == 0) {
+          if (hands.spinMask & (1 << i)) {
+            advanceSpin(hands, i, receivedAt);
+            stopSpin(hands, i);
+          }
+        } else {
+          spin_angle_t phase = fromPhase ? (spin_angle_t)cmd.phases[pixelId][i] << 16 : 0;
+          startSpin(hands, i, velocity, fromPhase, phase, receivedAt, cmd.stopAfterMs);
+        }
+      }
+      transition.isActive = transition.colorsActive || hands.activeMask != 0;
+
+      LOG_INFO("ESP-NOW: Spin [%.3f, %.3f, %.3f] deg/s hands=0x%X%s stop=%lums",
+               cmd.velocities[0] / (float)SPIN_ARCSEC_PER_DEGREE, cmd.velocities[1] / (float)SPIN_ARCSEC_PER_DEGREE,
+               cmd.velocities[2] / (float)SPIN_ARCSEC_PER_DEGREE, cmd.handMask,
+               fromPhase ? " phased" : "", (unsigned long)cmd.stopAfterMs);
+      break;
+    }
+
+    case CMD_UPLOAD_EASING: {
+      const EasingUploadPacket& cmd = packet->easingUpload;
+      if (easingCurves.upload(cmd)) {
+        LOG_INFO("ESP-NOW: Easing curve (%s) baked into slot %u as %s",
+                 cmd.format == EASING_FORMAT_BEZIER ? "Bezier" : "samples", cmd.slot,
+                 getEasingName((TransitionType)(TRANSITION_CUSTOM_1 + cmd.slot)));
+      } else {
+        LOG_WARN("ESP-NOW: Easing curve for slot %u rejected (format %u)", cmd.slot, cmd.format);
+      }
+      break;
+    }
+
+    case CMD_QUEUE_KEYFRAMES: {
+      const KeyframePacket& cmd = packet->keyframes;
+      if (cmd.pixelId != pixelId) break;
+
+      // Exit version/highlight mode: queued keyframes play on the clock screen
+      versionMode = false;
+      highlightMode = false;
+
+      unsigned long now = millis();
+      if (cmd.flags & KEYFRAME_REPLACE) {
+        keyframes.clear(now);
+      }
+
+      uint8_t queued = 0;
+      while (queued < cmd.count && keyframes.push(Keyframe::fromEntry(cmd.keyframes[queued]), now)) {
+        queued++;
+      }
+      if (queued < cmd.count) {
+        LOG_WARN("ESP-NOW: Keyframe queue full, %u keyframes dropped", cmd.count - queued);
+      }
+      LOG_INFO("ESP-NOW: Queued %u keyframes (%u pending)", queued, keyframes.size());
       break;
     }
 
     default:
-      Serial.print("ESP-NOW: Unknown command: ");
-      Serial.println(packet->command);
+      LOG_WARN("ESP-NOW: Unknown command: %u", packet->command);
+  }
+}
+
+// Start the queued keyframes that are due (loop() context, before the transition update)
+// Each starts at its scheduled time, so a late loop() does not delay the ones after it.
+// A keyframe that was due entirely in the past (loop() was blocked) is finished at
+// once and the next one started on schedule
+void playDueKeyframes(unsigned long now) {
+  Keyframe keyframe;
+  uint32_t startMs;
+  while (keyframes.popDue(now, keyframe, startMs)) {
+    // The previous transition is over by schedule: land it exactly on its targets
+    // (a replaced sequence instead continues from wherever the hands are)
+    if (transition.isActive && (long)(startMs - transitionEndMs()) >= 0) {
+      finishTransition();
+    }
+    startKeyframe(keyframe, startMs);
+  }
+}
+
+// Send the discovery response with our MAC and current ID
+void sendDiscoveryResponse() {
+  ESPNowPacket response;
+  response.discoveryResponse.command = CMD_DISCOVERY_RESPONSE;  // CRITICAL: Use separate command to prevent infinite loop!
+  WiFi.macAddress(response.discoveryResponse.mac);
+  response.discoveryResponse.currentId = pixelId;
+
+  if (ESPNowComm::sendPacket(&response, sizeof(DiscoveryResponsePacket))) {
+    LOG_INFO("ESP-NOW: Discovery response sent");
+  } else {
+    LOG_WARN("ESP-NOW: Discovery response FAILED");
+  }
+}
+
+// Apply everything received since the last frame, in arrival order
+void drainCommands() {
+  ReceivedCommand received;
+  while (commandQueue.pop(received)) {
+    applyCommand(&received.packet, received.receivedAt);
+  }
+
+  if (discoveryResponsePending && (long)(millis() - discoveryResponseAt) >= 0) {
+    discoveryResponsePending = false;
+    sendDiscoveryResponse();
   }
 }
 
@@ -781,36 +1090,44 @@ void sendOTAAck(OTAStatus status, uint8_t progress, uint16_t errorCode) {
 }
 
 // Display OTA progress on screen
-void displayOTAProgress(const char* status, int progress) {
-  canvas->fillScreen(GC9A01A_BLUE);
-  canvas->setTextColor(GC9A01A_WHITE);
-
-  // Status text
-  canvas->setTextSize(2);
-  canvas->setCursor(30, 80);
-  canvas->print(status);
-
-  // Progress bar background
-  canvas->fillRect(30, 120, 180, 20, GC9A01A_BLACK);
-
-  // Progress bar fill
-  if (progress > 0) {
-    int fillWidth = (180 * progress) / 100;
-    canvas->fillRect(30, 120, fillWidth, 20, GC9A01A_GREEN);
-  }
+// An optional detail line (e.g. the error string) is drawn below the percentage
+void displayOTAProgress(const char* status, int progress, const char* detail = nullptr) {
+  presentScreen([&]() {
+    canvas->fillScreen(GC9A01A_BLUE);
+    canvas->setTextColor(GC9A01A_WHITE);
+
+    // Status text
+    canvas->setTextSize(2);
+    canvas->setCursor(30, 80);
+    canvas->print(status);
+
+    // Progress bar background
+    canvas->fillRect(30, 120, 180, 20, GC9A01A_BLACK);
+
+    // Progress bar fill
+    if (progress > 0) {
+      int fillWidth = (180 * progress) / 100;
+      canvas->fillRect(30, 120, fillWidth, 20, GC9A01A_GREEN);
+    }
 
-  // Progress text
-  canvas->setTextSize(2);
-  canvas->setCursor(90, 150);
-  canvas->print(progress);
-  canvas->print("%");
+    // Progress text
+    canvas->setTextSize(2);
+    canvas->setCursor(90, 150);
+    canvas->print(progress);
+    canvas->print("%");
 
-  tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    if (detail) {
+      canvas->setTextSize(1);
+      canvas->setCursor(20, 180);
+      canvas->print(detail);
+    }
+  });
 }
 
 // Perform OTA update - connects to WiFi and downloads firmware
 void performOTAUpdate(const OTAStartPacket& start) {
   otaInProgress = true;
+  frameScheduler.invalidate();  // OTA progress screens replace whatever was shown
   currentOTAStatus = OTA_STATUS_STARTING;
   sendOTAAck(OTA_STATUS_STARTING, 0);
 
@@ -925,11 +1242,7 @@ void performOTAUpdate(const OTAStartPacket& start) {
       Serial.printf("OTA: Update failed! Error (%d): %s\n",
                     httpUpdate.getLastError(),
                     httpUpdate.getLastErrorString().c_str());
-      displayOTAProgress("FAILED!", 0);
-      canvas->setTextSize(1);
-      canvas->setCursor(20, 180);
-      canvas->print(httpUpdate.getLastErrorString().c_str());
-      tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
+      displayOTAProgress("FAILED!", 0, httpUpdate.getLastErrorString().c_str());
 
       currentOTAStatus = OTA_STATUS_ERROR;
       sendOTAAck(OTA_STATUS_ERROR, 0, httpUpdate.getLastError());
@@ -944,8 +1257,7 @@ void performOTAUpdate(const OTAStartPacket& start) {
       lastPacketTime = millis();  // Reset timeout to avoid immediate error
 
       // Clear the OTA screen
-      canvas->fillScreen(GC9A01A_BLACK);
-      tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
+      presentScreen([]() { canvas->fillScreen(GC9A01A_BLACK); });
       Serial.println("OTA: Returned to normal operation");
       break;
 
@@ -963,8 +1275,7 @@ void performOTAUpdate(const OTAStartPacket& start) {
       lastPacketTime = millis();  // Reset timeout to avoid immediate error
 
       // Clear the OTA screen
-      canvas->fillScreen(GC9A01A_BLACK);
-      tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
+      presentScreen([]() { canvas->fillScreen(GC9A01A_BLACK); });
       Serial.println("OTA: Returned to normal operation");
       break;
 
@@ -982,45 +1293,98 @@ void performOTAUpdate(const OTAStartPacket& start) {
   otaInProgress = false;
 }
 
-// Draw a thick clock hand using 2 filled triangles (forming a rectangle) + rounded caps
-// This is more efficient than drawing many circles along the line
-void drawHand(float cx, float cy, float angleDeg, float length, float thickness, uint16_t color) {
-  // Convert angle to radians (subtract 90 to make 0 degrees point up)
-  float angleRad = (angleDeg - 90.0) * PI / 180.0;
-  float perpRad = angleRad + PI / 2.0;  // Perpendicular angle for width
-
-  float halfThick = thickness / 2.0;
-
-  // Calculate 4 corners of the rectangle
-  // Base corners (at center)
-  float x1 = cx + cos(perpRad) * halfThick;
-  float y1 = cy + sin(perpRad) * halfThick;
-  float x2 = cx - cos(perpRad) * halfThick;
-  float y2 = cy - sin(perpRad) * halfThick;
-
-  // End point
-  float endX = cx + cos(angleRad) * length;
-  float endY = cy + sin(angleRad) * length;
-
-  // Tip corners (at end of hand)
-  float x3 = endX + cos(perpRad) * halfThick;
-  float y3 = endY + sin(perpRad) * halfThick;
-  float x4 = endX - cos(perpRad) * halfThick;
-  float y4 = endY - sin(perpRad) * halfThick;
-
-  // Draw two triangles to form rectangle
-  canvas->fillTriangle(x1, y1, x2, y2, x3, y3, color);
-  canvas->fillTriangle(x2, y2, x3, y3, x4, y4, color);
-
-  // Add rounded caps at both ends
-  canvas->fillCircle(cx, cy, (int)halfThick, color);      // Base cap
-  canvas->fillCircle(endX, endY, (int)halfThick, color);  // Tip cap
+// Angle a hand is drawn at: snapped to the span cache's angle steps when it is in use
+float drawnHandAngle(float angle) {
+  if (!handSpanCache.isReady()) return angle;
+  return HandSpanCache::stepAngle(HandSpanCache::angleStep(angle));
+}
+
+// The clock frame the hands and colors describe right now
+ClockFrame currentClockFrame(uint16_t handColor) {
+  ClockFrame frame = {{}, colors.currentBg, colors.currentFg, handColor};
+  for (uint8_t i = 0; i < FRAME_HAND_COUNT; i++) frame.angles[i] = drawnHandAngle(hands.currentAngle[i]);
+  return frame;
+}
+
+// ---- Frame statistics and idle ----
+
+// Print rendered/skipped frames, SPI traffic and stage timings once per second
+void reportFrameStats() {
+  unsigned long now = millis();
+  if (now - fpsLastTime < 1000) return;
+
+  uint32_t frames = frameScheduler.rendered;
+  float fps = frames * 1000.0f / (now - fpsLastTime);
+  LOG_INFO("FPS: %.1f (rendered %u, skipped %u) SPI: %u bytes/frame (%u windows)",
+           fps, frames, frameScheduler.skipped,
+           frames > 0 ? displayBus->bytesPushed / frames : 0, displayBus->windowsPushed);
+  displayBus->resetStats();
+  frameScheduler.resetStats();
+
+#ifdef USE_BAND_RENDERER
+  // Per-stage time per streamed frame: transition update, then band raster + push
+  if (streamedFrames > 0) {
+    LOG_INFO("  Stages/frame: update %.2f ms, bands %.2f ms (%u px)",
+             renderUs / 1000.0f / streamedFrames, streamUs / 1000.0f / streamedFrames,
+             rasterizer.pixelsWritten / streamedFrames);
+  }
+  streamUs = 0;
+  streamedFrames = 0;
+#else
+  // Per-stage time per pushed frame; overlap is the share of the transfer
+  // hidden behind rendering (0% when both stages run on one task)
+  PipelineStats stages = framePipeline.takeStats();
+  if (stages.frames > 0) {
+    uint32_t hiddenUs = stages.transferUs > stages.stallUs ? stages.transferUs - stages.stallUs : 0;
+    LOG_INFO("  Stages/frame: render %.2f ms (%u px), transfer %.2f ms, stall %.2f ms, overlap %u%%",
+             renderUs / 1000.0f / stages.frames, rasterizer.pixelsWritten / stages.frames,
+             stages.transferUs / 1000.0f / stages.frames, stages.stallUs / 1000.0f / stages.frames,
+             stages.transferUs ? hiddenUs * 100 / stages.transferUs : 0);
+  }
+#endif
+  renderUs = 0;
+  rasterizer.resetStats();
+
+  // Commands lost before loop() saw them (totals since boot)
+  if (commandQueue.dropped > 0 || commandsRejected > 0) {
+    LOG_INFO("  Commands: %u dropped (queue full), %u rejected", commandQueue.dropped, commandsRejected);
+  }
+  if (streamPlayer.lost() > 0) {
+    LOG_INFO("  Stream: %u samples lost", streamPlayer.lost());
+  }
+
+  fpsLastTime = now;
+}
+
+// Sleep until a packet arrives or loop() has work due: the ESP-NOW timeout
+// check, a pending discovery response, the next queued keyframe or the next
+// statistics report
+void idleUntilNextDeadline() {
+  unsigned long now = millis();
+  uint32_t waitMs = fpsLastTime + 1000 - now;
+  if (now - fpsLastTime >= 1000) waitMs = 0;
+  if (discoveryResponsePending) {
+    long untilResponse = (long)(discoveryResponseAt - now);
+    waitMs = min<uint32_t>(waitMs, untilResponse > 0 ? untilResponse : 0);
+  }
+  if (!keyframes.isEmpty()) {
+    long untilKeyframe = (long)(keyframes.nextStartMs() - now);
+    waitMs = min<uint32_t>(waitMs, untilKeyframe > 0 ? untilKeyframe : 0);
+  }
+  if (espnowEnabled && !errorState) {
+    unsigned long sinceLastPacket = now - lastPacketTime;
+    waitMs = min<uint32_t>(waitMs, sinceLastPacket > PACKET_TIMEOUT ? 0 : PACKET_TIMEOUT - sinceLastPacket + 1);
+  }
+  frameScheduler.idle(waitMs);
 }
 
 void setup() {
   Serial.begin(115200);
   delay(200);
 
+  // Packet handling and frame statistics log through the async ring, not Serial directly
+  AsyncLog::begin(Serial);
+
   // ---- Load Pixel ID from NVS ----
   preferences.begin(NVS_NAMESPACE, true);  // Read-only mode
   pixelId = preferences.getUChar(NVS_KEY_PIXEL_ID, PIXEL_ID_UNPROVISIONED);
@@ -1103,15 +1467,77 @@ void setup() {
   #endif
 
   // ---- Canvas ----
-  Serial.println("Allocating canvas buffer (115,200 bytes)...");
-  canvas = new GFXcanvas16(240, 240);
-  if (!canvas) {
+  #ifdef USE_BAND_RENDERER
+  if (!bandRenderer.begin(DISPLAY_WIDTH, DISPLAY_HEIGHT, FRAME_BUFFER_CAPS)) {
+    Serial.println("ERROR: Failed to allocate band buffers!");
+    while(1) delay(1000);
+  }
+  canvas = &displayList;
+  Serial.print("Band renderer: ");
+  Serial.print(bandRenderer.bufferBytes() + sizeof(DisplayList));
+  Serial.print(" bytes (");
+  Serial.print(BAND_BUFFERS);
+  Serial.print("x ");
+  Serial.print(BAND_ROWS);
+  Serial.print("-row bands + display list). Free heap: ");
+  Serial.print(ESP.getFreeHeap());
+  Serial.println(" bytes");
+  #else
+  Serial.print("Allocating ");
+  Serial.print(FRAME_BUFFER_COUNT);
+  #ifdef USE_INDEXED_FRAMEBUFFER
+  Serial.println(" indexed canvas buffer(s) (57,600 bytes each + line buffers)...");
+  #else
+  Serial.println(" canvas buffer(s) (115,200 bytes each)...");
+  #endif
+  if (frameBuffers.begin(FRAME_BUFFER_COUNT, DISPLAY_WIDTH, DISPLAY_HEIGHT, FRAME_BUFFER_CAPS) == 0) {
     Serial.println("ERROR: Failed to allocate canvas!");
     while(1) delay(1000);
   }
+  canvas = frameBuffers.canvas();
+  if (frameBuffers.size() < FRAME_BUFFER_COUNT) {
+    Serial.println("WARNING: Only one framebuffer fit - running single-buffered");
+  }
   Serial.print("Canvas allocated! Free heap: ");
   Serial.print(ESP.getFreeHeap());
   Serial.println(" bytes");
+  #endif
+
+  // ---- Fixed-point tables ----
+  #ifdef USE_FIXED_POINT_MATH
+    fxMathBegin();
+    Serial.println("Math: fixed-point trig and easing");
+  #endif
+
+  // ---- Frame scheduler ----
+  // Created before ESP-NOW starts so packets can wake loop() from its idle sleep
+  frameScheduler.begin();
+
+  // ---- Circle mask ----
+  circleMask.build(CENTER_X, CENTER_Y, MAX_RADIUS, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  Serial.print("Circle mask: ");
+  Serial.print(circleMask.visiblePixels());
+  Serial.print(" of ");
+  Serial.print(DISPLAY_WIDTH * DISPLAY_HEIGHT);
+  Serial.print(" pixels visible (full frame ");
+  Serial.print(circleMask.visiblePixels() * 2);
+  Serial.println(" bytes)");
+
+  // ---- Hand span cache ----
+  // Records are rasterized on first use of each angle step
+  #ifdef HAND_SPAN_POOL_BYTES
+  if (psramFound() && handSpanCache.begin(CENTER_X, CENTER_Y, HAND_SPAN_POOL_BYTES, MALLOC_CAP_SPIRAM)) {
+    handSpanCache.addShape(HAND_LENGTH_NORMAL, HAND_THICKNESS_NORMAL);  // HAND_SHAPE_NORMAL
+    handSpanCache.addShape(HAND_LENGTH_NORMAL, HAND_THICKNESS_THIN);    // HAND_SHAPE_THIN
+    Serial.print("Hand span cache: ");
+    Serial.print(HAND_SPAN_ANGLE_STEPS);
+    Serial.print(" angle steps, ");
+    Serial.print(HAND_SPAN_POOL_BYTES / 1024);
+    Serial.println(" KB pool in PSRAM");
+  } else {
+    Serial.println("Hand span cache: no PSRAM - hands rasterized live");
+  }
+  #endif
 
   // ---- TFT ----
   Serial.println("Initializing TFT...");
@@ -1126,6 +1552,32 @@ void setup() {
   #endif
   tft.setRotation(1);
 
+  #ifdef USE_HARDWARE_SPI
+    // Hand the initialized panel over to the DMA bus (esp_lcd owns SPI2 from here on)
+    SPI.end();
+    if (dmaBus.begin(tft_scl, tft_sda, tft_cs, tft_dc, 80000000)) {
+      displayBus = &dmaBus;
+      Serial.println("Display bus: SPI DMA (asynchronous frame push)");
+    } else {
+      SPI.begin();
+      Serial.println("Display bus: DMA setup failed, using blocking Adafruit writes");
+    }
+  #endif
+
+  // ---- Render/transfer pipeline ----
+  #ifdef USE_BAND_RENDERER
+  Serial.println("Pipeline: band renderer (render and transfer interleaved per band)");
+  #else
+  if (framePipeline.begin(*displayBus)) {
+    Serial.print("Pipeline: rendering on core ");
+    Serial.print(xPortGetCoreID());
+    Serial.print(", transfer task on core ");
+    Serial.println(xPortGetCoreID() == 0 ? 1 : 0);
+  } else {
+    Serial.println("Pipeline: single task (render and transfer inline)");
+  }
+  #endif
+
   Serial.print("Free heap after TFT init: ");
   Serial.print(ESP.getFreeHeap());
   Serial.println(" bytes");
@@ -1168,259 +1620,284 @@ void loop() {
     return;
   }
 
+  // ---- Received commands (frame boundary: nothing is mid-render) ----
+  drainCommands();
+  playDueKeyframes(currentTime);
+
   // ---- Start OTA if requested (must NOT run from ESP-NOW receive callback) ----
   if (otaRequestPending) {
-    OTAStartPacket startCmd;
-    bool shouldStart = false;
-    portENTER_CRITICAL(&otaRequestMux);
-    if (otaRequestPending) {
-      startCmd = otaPendingStart;
-      otaRequestPending = false;
-      shouldStart = true;
-    }
-    portEXIT_CRITICAL(&otaRequestMux);
+    otaRequestPending = false;
+    performOTAUpdate(otaPendingStart);
+    return;
+  }
 
-    if (shouldStart) {
-      performOTAUpdate(startCmd);
-      return;
-    }
+  // ---- Pixel ID confirmation flash ----
+  if (pixelIdFlashPending) {
+    pixelIdFlashPending = false;
+    presentScreen([&]() {
+      canvas->fillScreen(0x07E0);  // Green
+      canvas->setTextColor(0x0000);  // Black text
+      canvas->setTextSize(8);
+      canvas->setCursor(pixelId < 10 ? 95 : 65, 85);
+      canvas->print(pixelId);
+    });
+    delay(500);
+    frameScheduler.invalidate();  // The flash replaced whatever screen was shown
   }
 
   // ---- ESP-NOW Timeout Check ----
   // If we haven't received a packet in PACKET_TIMEOUT ms, show error state
   // Skip this check during OTA since ESP-NOW is disabled
   if (espnowEnabled && !errorState && !otaInProgress && (currentTime - lastPacketTime > PACKET_TIMEOUT)) {
-    Serial.println("\n!!! ESP-NOW TIMEOUT - NO MASTER SIGNAL !!!\n");
+    LOG_WARN("!!! ESP-NOW TIMEOUT - NO MASTER SIGNAL !!!");
     errorState = true;
   }
 
   // ---- Unprovisioned State Display ----
   // If pixel has no assigned ID, show green screen with "?" and wait for provisioning
   if (pixelId == PIXEL_ID_UNPROVISIONED) {
-    canvas->fillScreen(0x07E0);  // Green background
-
-    // Draw large white question mark in the center
-    canvas->setTextColor(GC9A01A_WHITE);
-    canvas->setTextSize(15);
-    canvas->setCursor(85, 90);
-    canvas->print("?");
+    if (frameScheduler.needsFrame(SCREEN_UNPROVISIONED)) {
+      presentScreen([&]() {
+        canvas->fillScreen(0x07E0);  // Green background
 
-    // Present unprovisioned frame to display
-    tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
+        // Draw large white question mark in the center
+        canvas->setTextColor(GC9A01A_WHITE);
+        canvas->setTextSize(15);
+        canvas->setCursor(85, 90);
+        canvas->print("?");
+      });
+    }
 
-    // Slow update rate - just waiting for provisioning
-    delay(100);
+    // Nothing changes until provisioning - sleep until a packet arrives
+    reportFrameStats();
+    idleUntilNextDeadline();
     return;
   }
 
   // ---- Version Mode Display ----
   // If in version mode, show version info and skip normal rendering
   if (versionMode) {
-    canvas->fillScreen(GC9A01A_MAGENTA);
-    canvas->setTextColor(GC9A01A_WHITE);
-    canvas->setTextSize(3);
-    canvas->setCursor(60, 80);
-    canvas->print("Pixel ");
-    canvas->println(pixelId);
-    canvas->setCursor(80, 130);
-    canvas->print("v");
-    canvas->print(FIRMWARE_VERSION_MAJOR);
-    canvas->print(".");
-    canvas->println(FIRMWARE_VERSION_MINOR);
-
-    // Present version frame to display
-    tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
-
-    // Small delay and return (skip normal rendering)
-    delay(100);
+    if (frameScheduler.needsFrame(SCREEN_VERSION, pixelId)) {
+      presentScreen([&]() {
+        canvas->fillScreen(GC9A01A_MAGENTA);
+        canvas->setTextColor(GC9A01A_WHITE);
+        canvas->setTextSize(3);
+        canvas->setCursor(60, 80);
+        canvas->print("Pixel ");
+        canvas->println(pixelId);
+        canvas->setCursor(80, 130);
+        canvas->print("v");
+        canvas->print(FIRMWARE_VERSION_MAJOR);
+        canvas->print(".");
+        canvas->println(FIRMWARE_VERSION_MINOR);
+      });
+    }
+
+    // Sleep and return (skip normal rendering)
+    reportFrameStats();
+    idleUntilNextDeadline();
     return;
   }
 
   // ---- Highlight Mode Display ----
   // If in highlight mode, show highlight state and skip normal rendering
   if (highlightMode) {
-    // Get MAC address for display
-    uint8_t myMac[6];
-    WiFi.macAddress(myMac);
-    char macStr[18];
-    sprintf(macStr, "%02X:%02X:%02X:%02X:%02X:%02X",
-            myMac[0], myMac[1], myMac[2], myMac[3], myMac[4], myMac[5]);
-
-    switch (currentHighlightState) {
-      case HIGHLIGHT_IDLE:
-        // Blue border, black bg, show MAC and current ID
-        canvas->fillScreen(GC9A01A_BLACK);
-        // Draw blue border (thick circle outline)
-        for (int r = 115; r < 120; r++) {
-          canvas->drawCircle(CENTER_X, CENTER_Y, r, 0x001F);  // Blue
-        }
-        canvas->setTextColor(GC9A01A_WHITE);
-        canvas->setTextSize(2);
-        canvas->setCursor(20, 60);
-        canvas->print("MAC:");
-        canvas->setCursor(10, 85);
-        canvas->print(macStr);
-        canvas->setCursor(50, 130);
-        canvas->print("ID: ");
-        if (pixelId == PIXEL_ID_UNPROVISIONED) {
-          canvas->print("?");
-        } else {
-          canvas->print(pixelId);
-        }
-        break;
-
-      case HIGHLIGHT_SELECTED:
-        // Bright green bg with black text, show MAC and current ID
-        canvas->fillScreen(0x07E0);  // Green
-        canvas->setTextColor(GC9A01A_BLACK);
-        canvas->setTextSize(2);
-        canvas->setCursor(20, 60);
-        canvas->print("MAC:");
-        canvas->setCursor(10, 85);
-        canvas->print(macStr);
-        canvas->setCursor(50, 130);
-        canvas->print("ID: ");
-        if (pixelId == PIXEL_ID_UNPROVISIONED) {
-          canvas->print("?");
-        } else {
-          canvas->print(pixelId);
+    if (frameScheduler.needsFrame(SCREEN_HIGHLIGHT, ((uint32_t)currentHighlightState << 8) | pixelId)) {
+      // Get MAC address for display
+      uint8_t myMac[6];
+      WiFi.macAddress(myMac);
+      char macStr[18];
+      sprintf(macStr, "%02X:%02X:%02X:%02X:%02X:%02X",
+              myMac[0], myMac[1], myMac[2], myMac[3], myMac[4], myMac[5]);
+
+      presentScreen([&]() {
+        switch (currentHighlightState) {
+          case HIGHLIGHT_IDLE:
+            // Blue border, black bg, show MAC and current ID
+            canvas->fillScreen(GC9A01A_BLACK);
+            // Draw blue border (thick circle outline, as row spans)
+            fillRing(*canvas, CENTER_X, CENTER_Y, 115, 119, 0x001F);  // Blue
+            canvas->setTextColor(GC9A01A_WHITE);
+            canvas->setTextSize(2);
+            canvas->setCursor(20, 60);
+            canvas->print("MAC:");
+            canvas->setCursor(10, 85);
+            canvas->print(macStr);
+            canvas->setCursor(50, 130);
+            canvas->print("ID: ");
+            if (pixelId == PIXEL_ID_UNPROVISIONED) {
+              canvas->print("?");
+            } else {
+              canvas->print(pixelId);
+            }
+            break;
+
+          case HIGHLIGHT_SELECTED:
+            // Bright green bg with black text, show MAC and current ID
+            canvas->fillScreen(0x07E0);  // Green
+            canvas->setTextColor(GC9A01A_BLACK);
+            canvas->setTextSize(2);
+            canvas->setCursor(20, 60);
+            canvas->print("MAC:");
+            canvas->setCursor(10, 85);
+            canvas->print(macStr);
+            canvas->setCursor(50, 130);
+            canvas->print("ID: ");
+            if (pixelId == PIXEL_ID_UNPROVISIONED) {
+              canvas->print("?");
+            } else {
+              canvas->print(pixelId);
+            }
+            break;
+
+          case HIGHLIGHT_ASSIGNED:
+            // Black bg, show OK and assigned ID
+            canvas->fillScreen(GC9A01A_BLACK);
+            canvas->setTextColor(0x07E0);  // Green
+            canvas->setTextSize(4);
+            canvas->setCursor(80, 60);
+            canvas->print("OK");
+            canvas->setTextSize(2);
+            canvas->setCursor(20, 110);
+            canvas->print("MAC:");
+            canvas->setCursor(10, 135);
+            canvas->print(macStr);
+            canvas->setCursor(40, 180);
+            canvas->print("ID: ");
+            canvas->print(pixelId);
+            break;
+
+          case HIGHLIGHT_DISCOVERY_WAITING:
+            // Black bg with white "?" - waiting to be discovered
+            canvas->fillScreen(GC9A01A_BLACK);
+            canvas->setTextColor(GC9A01A_WHITE);
+            canvas->setTextSize(15);
+            canvas->setCursor(85, 90);
+            canvas->print("?");
+            break;
+
+          case HIGHLIGHT_DISCOVERY_FOUND:
+            // Black bg with white "!" - discovered, waiting for assignment
+            canvas->fillScreen(GC9A01A_BLACK);
+            canvas->setTextColor(GC9A01A_WHITE);
+            canvas->setTextSize(15);
+            canvas->setCursor(95, 90);
+            canvas->print("!");
+            break;
         }
-        break;
-
-      case HIGHLIGHT_ASSIGNED:
-        // Black bg, show OK and assigned ID
-        canvas->fillScreen(GC9A01A_BLACK);
-        canvas->setTextColor(0x07E0);  // Green
-        canvas->setTextSize(4);
-        canvas->setCursor(80, 60);
-        canvas->print("OK");
-        canvas->setTextSize(2);
-        canvas->setCursor(20, 110);
-        canvas->print("MAC:");
-        canvas->setCursor(10, 135);
-        canvas->print(macStr);
-        canvas->setCursor(40, 180);
-        canvas->print("ID: ");
-        canvas->print(pixelId);
-        break;
-
-      case HIGHLIGHT_DISCOVERY_WAITING:
-        // Black bg with white "?" - waiting to be discovered
-        canvas->fillScreen(GC9A01A_BLACK);
-        canvas->setTextColor(GC9A01A_WHITE);
-        canvas->setTextSize(15);
-        canvas->setCursor(85, 90);
-        canvas->print("?");
-        break;
-
-      case HIGHLIGHT_DISCOVERY_FOUND:
-        // Black bg with white "!" - discovered, waiting for assignment
-        canvas->fillScreen(GC9A01A_BLACK);
-        canvas->setTextColor(GC9A01A_WHITE);
-        canvas->setTextSize(15);
-        canvas->setCursor(95, 90);
-        canvas->print("!");
-        break;
+      });
     }
 
-    // Present highlight frame to display
-    tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
-
-    // Small delay and return (skip normal rendering)
-    delay(100);
+    // Sleep and return (skip normal rendering)
+    reportFrameStats();
+    idleUntilNextDeadline();
     return;
   }
 
   // ---- Error State Display ----
   // If in error state, just show red screen with "!" and skip normal rendering
   if (errorState) {
-    canvas->fillScreen(GC9A01A_RED);
+    if (frameScheduler.needsFrame(SCREEN_ERROR)) {
+      presentScreen([&]() {
+        canvas->fillScreen(GC9A01A_RED);
 
-    // Draw large "!" in the center
-    // We'll draw it manually since we want it large and centered
-    canvas->setTextColor(GC9A01A_WHITE);
-    canvas->setTextSize(10);  // Large text
-    canvas->setCursor(95, 90);  // Roughly centered for "!"
-    canvas->print("!");
+        // Draw large "!" in the center
+        // We'll draw it manually since we want it large and centered
+        canvas->setTextColor(GC9A01A_WHITE);
+        canvas->setTextSize(10);  // Large text
+        canvas->setCursor(95, 90);  // Roughly centered for "!"
+        canvas->print("!");
+      });
+    }
 
-    // Present error frame to display
-    tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    // Sleep and return (skip normal rendering)
+    reportFrameStats();
+    idleUntilNextDeadline();
+    return;
+  }
 
-    // Small delay and return (skip normal rendering)
-    delay(100);
+  // ---- Clock ----
+  // The clock only changes while a transition or a stream runs; once it has
+  // settled the panel already shows the final frame, so sleep until the next command
+  bool streaming = streamPlayer.isActive(currentTime);
+  if (!frameScheduler.needsFrame(SCREEN_CLOCK, 0, transition.isActive || streaming)) {
+    reportFrameStats();
+    idleUntilNextDeadline();
     return;
   }
 
-  // Update hand angles based on transition
+  // Render stage starts here: transition update plus rasterization
+  uint32_t renderStart = micros();
+  PROFILE_BEGIN(frameStart);
+
+  // Update hand angles and colors based on transition
   if (transition.isActive) {
-    // Calculate elapsed time in seconds
-    float elapsed = (currentTime - transition.startTime) / 1000.0;
-
-    // Calculate progress (0.0 to 1.0)
-    float t = elapsed / transition.duration;
-
-    if (t >= 1.0) {
-      // Transition complete - set to target and normalize
-      hand1.currentAngle = hand1.targetAngle;
-      hand2.currentAngle = hand2.targetAngle;
-      hand3.currentAngle = hand3.targetAngle;
-
-      // Normalize angles to 0-360 range
-      while (hand1.currentAngle < 0) hand1.currentAngle += 360.0;
-      while (hand1.currentAngle >= 360.0) hand1.currentAngle -= 360.0;
-      while (hand2.currentAngle < 0) hand2.currentAngle += 360.0;
-      while (hand2.currentAngle >= 360.0) hand2.currentAngle -= 360.0;
-      while (hand3.currentAngle < 0) hand3.currentAngle += 360.0;
-      while (hand3.currentAngle >= 360.0) hand3.currentAngle -= 360.0;
-
-      opacity.current = opacity.target;
-      colors.currentBg = colors.targetBg;
-      colors.currentFg = colors.targetFg;
-      transition.isActive = false;
-    } else {
-      // Update all hands with same progress value
-      updateHandAngle(hand1, t);
-      updateHandAngle(hand2, t);
-      updateHandAngle(hand3, t);
-      updateOpacity(t);
-      updateColors(t);
+    updateTransition(currentTime);
+  }
+  float streamedAngles[HANDS_PER_PIXEL];
+  if (streaming && streamPlayer.anglesAt(currentTime, streamedAngles)) {
+    for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+      hands.currentAngle[i] = wrapDegrees(streamedAngles[i]);
     }
   }
+  PROFILE_END(PROFILE_UPDATE, frameStart);
 
   // ---- Rendering ----
-  // Clear canvas with current background color
-  canvas->fillScreen(colors.currentBg);
-
-  // Optional: Draw reference circle to show the max radius
-  // canvas->drawCircle(CENTER_X, CENTER_Y, MAX_RADIUS - 1, tft.color565(200, 200, 200));
-
-  // Draw the three clock hands with opacity blending
-  // Blend foreground color with background based on opacity
-  uint16_t handColor = blendColor(colors.currentBg, colors.currentFg, opacity.current);
-
-  // Draw hands 1 and 2 with normal thickness
-  drawHand(CENTER_X, CENTER_Y, hand1.currentAngle, HAND_LENGTH_NORMAL, HAND_THICKNESS_NORMAL, handColor);
-  drawHand(CENTER_X, CENTER_Y, hand2.currentAngle, HAND_LENGTH_NORMAL, HAND_THICKNESS_NORMAL, handColor);
-
-  // Draw hand 3 with thin thickness
-  drawHand(CENTER_X, CENTER_Y, hand3.currentAngle, HAND_LENGTH_NORMAL, HAND_THICKNESS_THIN, handColor);
-
-  // Draw center dot (always full opacity foreground color)
-  canvas->fillCircle(CENTER_X, CENTER_Y, 4, colors.currentFg);
-
-  // Present frame to display
-  tft.drawRGBBitmap(0, 0, canvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT);
-
-  // ---- FPS tracking ----
-  fpsFrames++;
-  unsigned long now = millis();
-
-  if (now - fpsLastTime >= 1000) {
-    float fps = fpsFrames * 1000.0f / (now - fpsLastTime);
-    Serial.print("FPS: ");
-    Serial.println(fps, 1);
+  // Foreground blended with background at the current opacity (from the color ramp)
+  uint16_t handColor = colors.currentHand;
+
+  // Describe this frame and diff it against the panel (what to push) and
+  // against the framebuffer, which may hold an older frame (what to redraw)
+  ClockFrame frame = currentClockFrame(handColor);
+  PROFILE_BEGIN(damageStart);
+  FrameShapes shapes;
+  buildFrameShapes(frame, shapes);
+
+  DamageList pushDamage;
+  panelTracker.computeDamage(shapes, pushDamage);
+  PROFILE_END(PROFILE_DAMAGE, damageStart);
+
+  if (!pushDamage.isEmpty()) {
+    PROFILE_BEGIN(rasterStart);
+    // Background, hands and center dot in one pass: each visible pixel of the
+    // damaged regions is written once, with anti-aliased edges
+    prepareRasterizer(rasterizer, frame);
+    // Cached hands: row lookups instead of distance evaluation
+    if (handSpanCache.isReady()) useCachedHands(rasterizer, handSpanCache, frame);
+
+  #ifdef USE_BAND_RENDERER
+    // No framebuffer to keep up to date: rasterize and stream the panel damage band by band
+    renderUs += micros() - renderStart;
+    uint32_t streamStart = micros();
+    bandRenderer.presentClock(*displayBus, rasterizer, pushDamage, circleMask);
+    panelTracker.commit(shapes);
+    PROFILE_END(PROFILE_PUSH, rasterStart);  // Raster and push are interleaved band by band
+    streamUs += micros() - streamStart;
+    streamedFrames++;
+  #else
+    DamageList drawDamage;
+    frameBuffers.contents().computeDamage(shapes, drawDamage);
+  #ifdef USE_INDEXED_FRAMEBUFFER
+    // Indexed buffer: store coverage indices, the palette turns them into colors at push time
+    frameBuffers.canvas()->usePalette(rasterizer.palette());
+    for (uint8_t i = 0; i < drawDamage.count; i++) {
+      rasterizer.renderIndexed(frameBuffers.canvas()->getBuffer(), DISPLAY_WIDTH, drawDamage.rects[i], circleMask);
+    }
+  #else
+    for (uint8_t i = 0; i < drawDamage.count; i++) {
+      rasterizer.render(frameBuffers.canvas()->getBuffer(), DISPLAY_WIDTH, drawDamage.rects[i], circleMask);
+    }
+  #endif
 
-    fpsFrames = 0;
-    fpsLastTime = now;
+    // Present only the windows that changed on the panel
+    frameBuffers.contents().commit(shapes);
+    panelTracker.commit(shapes);
+    PROFILE_END(PROFILE_RASTER, rasterStart);
+    renderUs += micros() - renderStart;
+    presentFrame(pushDamage);
+  #endif
   }
+  PROFILE_END(PROFILE_FRAME, frameStart);
+
+  reportFrameStats();
 }
@@ -4,12 +4,15 @@
 #include <WiFi.h>
 #include <TFT_eSPI.h>
 #include <ESPNowComm.h>
+#include <AsyncLog.h>
 #include "animations/unity.h"
+#include "animations/flow.h"
+#include "animations/spin.h"
 // fluid_time.h included later after DigitPattern definition
 
 // ===== FIRMWARE VERSION =====
 #define FIRMWARE_VERSION_MAJOR 1
-#define FIRMWARE_VERSION_MINOR 34
+#define FIRMWARE_VERSION_MINOR 37
 
 // ===== WIFI & TIME CONFIGURATION =====
 const char* WIFI_SSID = "Frontier5664";
@@ -84,6 +87,8 @@ enum ControlMode {
   MODE_ANIMATIONS,  // Animations menu - select animation
   MODE_UNITY,       // Unity animation - all pixels move in unison
   MODE_FLUID_TIME,  // Fluid Time animation - staggered wave effect
+  MODE_FLOW,        // Flow animation - streamed sine field
+  MODE_SPIN,        // Spin animation - hands spinning on the pixels' clocks
   MODE_DIGITS,      // Display digits 0-9 with animations
   MODE_PROVISION,   // Discovery and provisioning of pixels
   MODE_OTA,         // OTA firmware update for pixels
@@ -298,6 +303,8 @@ void drawVersionScreen();
 void handleVersionTouch(uint16_t x, uint16_t y);
 void sendGetVersionCommand();
 void handleVersionResponse(const VersionResponsePacket& resp);
+void sendProfileQuery(uint8_t targetPixelId);
+void handleProfileResponse(const ProfileResponsePacket& resp);
 
 // ===== FUNCTIONS =====
 
@@ -509,6 +516,26 @@ void drawAnimationsScreen() {
   tft.setCursor(185, 125);
   tft.println("Left to right");
 
+  // Flow animation button (bottom left)
+  tft.fillRoundRect(10, 170, 90, 50, 8, TFT_NAVY);
+  tft.setTextColor(TFT_WHITE, TFT_NAVY);
+  tft.setTextSize(2);
+  tft.setCursor(31, 180);
+  tft.println("Flow");
+  tft.setTextSize(1);
+  tft.setCursor(25, 202);
+  tft.println("Streamed");
+
+  // Spin animation button (bottom right)
+  tft.fillRoundRect(220, 170, 90, 50, 8, TFT_MAROON);
+  tft.setTextColor(TFT_WHITE, TFT_MAROON);
+  tft.setTextSize(2);
+  tft.setCursor(241, 180);
+  tft.println("Spin");
+  tft.setTextSize(1);
+  tft.setCursor(241, 202);
+  tft.println("Ambient");
+
   // Back button
   tft.fillRoundRect(110, 180, 100, 40, 8, TFT_RED);
   tft.setTextColor(TFT_WHITE, TFT_RED);
@@ -534,6 +561,20 @@ void handleAnimationsTouch(uint16_t x, uint16_t y) {
     return;
   }
 
+  // Flow button (10, 170, 90, 50)
+  if (x >= 10 && x <= 100 && y >= 170 && y <= 220) {
+    currentMode = MODE_FLOW;
+    startFlow();
+    return;
+  }
+
+  // Spin button (220, 170, 90, 50)
+  if (x >= 220 && x <= 310 && y >= 170 && y <= 220) {
+    currentMode = MODE_SPIN;
+    startSpinAnimation();
+    return;
+  }
+
   // Back button (110, 180, 100, 40)
   if (x >= 110 && x <= 210 && y >= 180 && y <= 220) {
     currentMode = MODE_MENU;
@@ -594,6 +635,8 @@ void onMasterPacketReceived(const ESPNowPacket* packet, size_t len) {
     handleOTAAck(packet->otaAck);
   } else if (packet->command == CMD_VERSION_RESPONSE) {
     handleVersionResponse(packet->versionResponse);
+  } else if (packet->command == CMD_PROFILE_RESPONSE && len >= sizeof(ProfileResponsePacket)) {
+    handleProfileResponse(packet->profileResponse);
   }
 }
 
@@ -1299,6 +1342,8 @@ void sendTwoDigitPattern(uint8_t leftDigit, uint8_t rightDigit) {
   ESPNowPacket packet;
   packet.angleCmd.command = CMD_SET_ANGLES;
 
+  packet.angleCmd.clearExtensions();
+
   // Target only the 12 pixels used for the two-digit display
   packet.angleCmd.clearTargetMask();
   for (int i = 0; i < 6; i++) {
@@ -1375,17 +1420,12 @@ void sendTwoDigitPattern(uint8_t leftDigit, uint8_t rightDigit) {
 
   // Send the packet
   if (ESPNowComm::sendPacket(&packet, sizeof(AngleCommandPacket))) {
-    const char* digitNames[] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9", ":", " "};
-    Serial.print("Sent two digits: ");
-    Serial.print(digitNames[leftDigit]);
-    Serial.print(digitNames[rightDigit]);
-    Serial.print(" with transition: ");
-    Serial.print(getTransitionName(packet.angleCmd.transition));
-    Serial.print(", duration: ");
-    Serial.print(durationToFloat(packet.angleCmd.duration), 1);
-    Serial.println("s (targeting 12 pixels only)");
+    static const char* const digitNames[] = {"0", "1", "2", "3", "4", "5", "6", "7", "8", "9", ":", " "};
+    LOG_INFO("Sent two digits: %s%s with transition: %s, duration: %.1fs (targeting 12 pixels only)",
+             digitNames[leftDigit], digitNames[rightDigit],
+             getTransitionName(packet.angleCmd.transition), durationToFloat(packet.angleCmd.duration));
   } else {
-    Serial.println("Failed to send two-digit packet!");
+    LOG_WARN("Failed to send two-digit packet!");
   }
 }
 
@@ -1395,9 +1435,9 @@ void sendPing() {
   packet.ping.timestamp = millis();
 
   if (ESPNowComm::sendPacket(&packet, sizeof(PingPacket))) {
-    Serial.println("Ping sent to keep pixels alive");
+    LOG_INFO("Ping sent to keep pixels alive");
   } else {
-    Serial.println("Failed to send ping");
+    LOG_WARN("Failed to send ping");
   }
 }
 
@@ -1900,6 +1940,36 @@ void sendGetVersionCommand() {
   }
 }
 
+// Ask one pixel for its frame stage profile (printed on both serial logs)
+void sendProfileQuery(uint8_t targetPixelId) {
+  ESPNowPacket packet;
+  packet.getProfile.command = CMD_GET_PROFILE;
+  packet.getProfile.targetPixelId = targetPixelId;
+  packet.getProfile.printOnPixel = true;
+  packet.getProfile.reset = false;
+
+  if (ESPNowComm::sendPacket(&packet, sizeof(GetProfilePacket))) {
+    LOG_INFO("Sent GET_PROFILE to pixel %u", targetPixelId);
+  } else {
+    LOG_WARN("Failed to send GET_PROFILE");
+  }
+}
+
+// Print a pixel's frame stage profile
+void handleProfileResponse(const ProfileResponsePacket& resp) {
+  if (resp.stageCount == 0) {
+    LOG_INFO("Profile from pixel %u: built without the stage profiler", resp.pixelId);
+    return;
+  }
+
+  LOG_INFO("Profile from pixel %u (us):", resp.pixelId);
+  for (uint8_t i = 0; i < resp.stageCount && i < PROFILE_MAX_STAGES; i++) {
+    const ProfileStageSummary& stage = resp.stages[i];
+    LOG_INFO("  %-7s n=%u p50=%u p95=%u p99=%u max=%u",
+             getProfileStageName(i), stage.samples, stage.p50Us, stage.p95Us, stage.p99Us, stage.maxUs);
+  }
+}
+
 // Draw version screen
 void drawVersionScreen() {
   tft.fillScreen(COLOR_BG);
@@ -1932,6 +2002,10 @@ void drawVersionScreen() {
   tft.print("/");
   tft.println(MAX_PIXELS);
 
+  tft.setTextColor(TFT_LIGHTGREY, COLOR_BG);
+  tft.setCursor(10, 55);
+  tft.print("Tap a pixel for its frame profile (serial log)");
+
   // Draw pixel version grid (6 columns x 4 rows)
   int startY = 65;
   int cellW = 52;
@@ -2002,6 +2076,12 @@ void handleVersionTouch(uint16_t x, uint16_t y) {
     drawMenu();
     return;
   }
+
+  // Pixel cell (grid from drawVersionScreen: 6 x 4 cells of 52 x 35 at (5, 65))
+  if (x >= 5 && x < 5 + 6 * 52 && y >= 65 && y < 65 + 4 * 35) {
+    uint8_t pixel = ((y - 65) / 35) * 6 + (x - 5) / 52;
+    sendProfileQuery(pixel);
+  }
 }
 
 // ===== WIFI & TIME FUNCTIONS =====
@@ -2082,6 +2162,9 @@ void setup() {
   Serial.begin(115200);
   delay(1000);
 
+  // Per-event logging (pattern sends, pings) goes through the async ring
+  AsyncLog::begin(Serial);
+
   Serial.println("\n========== MASTER CONTROLLER ==========");
   Serial.println("Twenty-Four Times - ESP-NOW Master");
   Serial.println(BOARD_NAME);
@@ -2274,7 +2357,11 @@ void loop() {
       handleVersionTouch(tx, ty);
     } else {
       // Any touch in other modes returns to animations menu (for animation modes)
-      if (currentMode == MODE_UNITY || currentMode == MODE_FLUID_TIME) {
+      if (currentMode == MODE_UNITY || currentMode == MODE_FLUID_TIME || currentMode == MODE_FLOW ||
+          currentMode == MODE_SPIN) {
+        if (currentMode == MODE_SPIN) {
+          stopSpinAnimation();  // Spinning hands would ignore the next mode's angle commands
+        }
         currentMode = MODE_ANIMATIONS;
         drawAnimationsScreen();
         Serial.println("Returned to animations menu");
@@ -2318,6 +2405,18 @@ void loop() {
       break;
     }
 
+    case MODE_FLOW: {
+      // Handle Flow animation loop
+      handleFlowLoop(currentTime);
+      break;
+    }
+
+    case MODE_SPIN: {
+      // Handle Spin animation loop
+      handleSpinLoop(currentTime);
+      break;
+    }
+
     case MODE_DIGITS: {
       // Send periodic pings to keep pixels alive
       if (currentTime - lastPingTime >= 3000) {  // Ping every 3 seconds
@@ -0,0 +1,147 @@
+#ifndef PIXEL_BAND_RENDERER_H
+#define PIXEL_BAND_RENDERER_H
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "display_bus.h"
+#include "damage.h"
+#include "circle_mask.h"
+#include "capsule_raster.h"
+#include "display_list.h"
+
+// Band Renderer - stream frames to the panel through a few short line buffers
+// Instead of a 115 KB full-screen canvas, a frame is described once (a display
+// list for mode screens, the capsule rasterizer for clock frames) and rendered a
+// band of rows at a time. Each band is pushed as soon as it is filled while the
+// next band renders into the other buffer. Bands hold panel-order pixels, so
+// they go to the bus exactly as rendered.
+
+const int16_t BAND_ROWS = 8;
+const uint8_t BAND_BUFFERS = 2;
+
+class BandRenderer {
+public:
+  // Allocate the band buffers; returns false if they do not fit
+  bool begin(int16_t screenW, int16_t screenH, uint32_t caps) {
+    width = screenW;
+    height = screenH;
+    for (uint8_t i = 0; i < BAND_BUFFERS; i++) {
+      bands[i] = (uint16_t*)heap_caps_malloc((size_t)width * BAND_ROWS * 2, caps);
+      if (!bands[i]) return false;
+      fences[i] = 0;
+    }
+    return true;
+  }
+
+  // Bytes of band memory
+  size_t bufferBytes() const { return (size_t)width * BAND_ROWS * 2 * BAND_BUFFERS; }
+
+  // Replay a recorded screen band by band and push all visible pixels
+  // (only the rows the list recorded, see DisplayList::setRows)
+  void presentList(DisplayBus& bus, const DisplayList& list, const CircleMask& mask) {
+    for (int16_t bandY = list.firstRow(); bandY < list.endRow(); bandY += BAND_ROWS) {
+      int16_t rows = min<int16_t>(BAND_ROWS, list.endRow() - bandY);
+      uint16_t* band = acquire(bus);
+
+      memset(band, 0, (size_t)width * rows * 2);  // Uncovered pixels are black
+      list.replay(band, width, bandY, rows);
+
+      bus.pushMaskedWindow(0, bandY, width, rows, band, width, mask);
+      submit(bus);
+    }
+  }
+
+  // Record a screen by calling draw() (which draws into `list`) and stream it out
+  // When the screen has more ops than the list holds, it is drawn again for half
+  // as many rows at a time, each pass recording and pushing only its own rows.
+  // Returns false if ops were still dropped with a single row per pass.
+  template <typename DrawScreen>
+  bool presentScreen(DisplayBus& bus, DisplayList& list, const CircleMask& mask, DrawScreen draw) {
+    bool complete = true;
+    int16_t passRows = height;
+    screenPasses = 0;
+    for (int16_t y = 0; y < height;) {
+      int16_t rows = min<int16_t>(passRows, height - y);
+      list.setRows(y, rows);
+      list.clear();
+      draw();
+      screenPasses++;
+      if (list.hasOverflowed()) {
+        if (rows > 1) {
+          passRows = (rows + 1) / 2;
+          continue;
+        }
+        complete = false;
+      }
+      presentList(bus, list, mask);
+      y += rows;
+    }
+    list.setRows(0, height);
+    return complete;
+  }
+
+  // Times the last screen was drawn (1 unless it overflowed the display list)
+  uint8_t screenPasses = 0;
+
+  // Rasterize the damaged regions of a clock frame band by band and push them
+  void presentClock(DisplayBus& bus, CapsuleRasterizer& rasterizer,
+                    const DamageList& regions, const CircleMask& mask) {
+    for (int16_t bandY = 0; bandY < height; bandY += BAND_ROWS) {
+      int16_t rows = min<int16_t>(BAND_ROWS, height - bandY);
+      Rect bandRect = {0, bandY, width, rows};
+
+      // A DMA bus pushes whole rows, so render whole rows there
+      Rect parts[MAX_DAMAGE_RECTS];
+      uint8_t partCount = 0;
+      for (uint8_t i = 0; i < regions.count; i++) {
+        if (!regions.rects[i].intersects(bandRect)) continue;
+        Rect r = regions.rects[i];
+        int16_t y0 = max(r.y, bandY);
+        int16_t y1 = min(r.bottom(), bandRect.bottom());
+        parts[partCount++] = {r.x, y0, r.w, (int16_t)(y1 - y0)};
+      }
+      if (partCount == 0) continue;
+
+      uint16_t* band = acquire(bus);
+      if (bus.pushesFullRows()) {
+        int16_t y0 = parts[0].y;
+        int16_t y1 = parts[0].bottom();
+        for (uint8_t i = 1; i < partCount; i++) {
+          y0 = min(y0, parts[i].y);
+          y1 = max(y1, parts[i].bottom());
+        }
+        Rect rowsRect = {0, y0, width, (int16_t)(y1 - y0)};
+        rasterizer.render(band, width, rowsRect, mask, bandY);
+        bus.pushMaskedWindow(0, y0, width, y1 - y0, band + (int32_t)(y0 - bandY) * width, width, mask);
+      } else {
+        for (uint8_t i = 0; i < partCount; i++) {
+          const Rect& p = parts[i];
+          rasterizer.render(band, width, p, mask, bandY);
+          bus.pushMaskedWindow(p.x, p.y, p.w, p.h, band + (int32_t)(p.y - bandY) * width + p.x, width, mask);
+        }
+      }
+      submit(bus);
+    }
+  }
+
+private:
+  // Next band buffer, once the bus has finished reading it
+  uint16_t* acquire(DisplayBus& bus) {
+    bus.waitFence(fences[current]);
+    return bands[current];
+  }
+
+  // Record the fence for the band just pushed and move to the other buffer
+  void submit(DisplayBus& bus) {
+    fences[current] = bus.insertFence();
+    current = (current + 1) % BAND_BUFFERS;
+  }
+
+  uint16_t* bands[BAND_BUFFERS] = {nullptr, nullptr};
+  uint32_t fences[BAND_BUFFERS] = {0, 0};
+  uint8_t current = 0;
+  int16_t width = 0;
+  int16_t height = 0;
+};
+
+#endif // PIXEL_BAND_RENDERER_H
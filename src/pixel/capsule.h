@@ -0,0 +1,145 @@
+#ifndef PIXEL_CAPSULE_H
+#define PIXEL_CAPSULE_H
+
+#include <Arduino.h>
+#include "fixed_math.h"
+
+// Capsule - the shape of a hand (a line segment with a radius) and its coverage
+// A pixel (x, y) is sampled at (x, y), like Adafruit GFX shapes. Coverage is
+// quantized to 16 levels: 0 outside, COVERAGE_FULL inside, anti-aliased levels
+// across the one-pixel band around the edge.
+
+const uint8_t COVERAGE_FULL = 15;   // Coverage levels 0..15 (4 bits)
+
+// Line segment from a to b with a round cap of the given radius at both ends
+struct Capsule {
+  float ax, ay;
+  float bx, by;
+  float radius;
+
+  // Derived by prepare(): unit direction and length of a->b
+  float ux, uy;
+  float len;
+
+  void prepare() {
+    float dx = bx - ax;
+    float dy = by - ay;
+    len = sqrt(dx * dx + dy * dy);
+    ux = len > 0 ? dx / len : 1.0f;
+    uy = len > 0 ? dy / len : 0.0f;
+  }
+
+  // Distance from (px, py) to the segment
+  float distance(float px, float py) const {
+    float x = px - ax;
+    float y = py - ay;
+    float t = constrain(x * ux + y * uy, 0.0f, len);
+    float dx = x - ux * t;
+    float dy = y - uy * t;
+    return sqrt(dx * dx + dy * dy);
+  }
+
+  // Range of x on row y whose distance to the segment is at most `rad`
+  // The capsule is convex, so this is a single interval; false when empty
+  bool rowSpan(float y, float rad, float& x0, float& x1) const {
+    float lo = 1e9f;
+    float hi = -1e9f;
+
+    // End caps
+    addCircleSpan(ax, ay, y, rad, lo, hi);
+    addCircleSpan(bx, by, y, rad, lo, hi);
+
+    // Body: |perpendicular distance| <= rad and projection within [0, len]
+    if (len > 0) {
+      float Y = y - ay;
+      float sLo = -1e9f, sHi = 1e9f;
+      if (fabs(uy) > 1e-6f) {
+        float a = (ux * Y - rad) / uy;
+        float b = (ux * Y + rad) / uy;
+        sLo = max(sLo, min(a, b));
+        sHi = min(sHi, max(a, b));
+      } else if (fabs(ux * Y) > rad) {
+        sHi = sLo - 1;
+      }
+      if (fabs(ux) > 1e-6f) {
+        float a = (-uy * Y) / ux;
+        float b = (len - uy * Y) / ux;
+        sLo = max(sLo, min(a, b));
+        sHi = min(sHi, max(a, b));
+      } else if (uy * Y < 0 || uy * Y > len) {
+        sHi = sLo - 1;
+      }
+      if (sLo <= sHi) {
+        lo = min(lo, ax + sLo);
+        hi = max(hi, ax + sHi);
+      }
+    }
+
+    x0 = lo;
+    x1 = hi;
+    return lo <= hi;
+  }
+
+private:
+  static void addCircleSpan(float cx, float cy, float y, float rad, float& lo, float& hi) {
+    float dy = y - cy;
+    float h2 = rad * rad - dy * dy;
+    if (h2 < 0) return;
+    float h = sqrt(h2);
+    lo = min(lo, cx - h);
+    hi = max(hi, cx + h);
+  }
+};
+
+// Capsule for a hand drawn from (cx, cy) at angleDeg (0 = up, clockwise)
+inline Capsule handCapsule(float cx, float cy, float angleDeg, float length, float thickness) {
+  Capsule c;
+  c.ax = cx;
+  c.ay = cy;
+#ifdef USE_FIXED_POINT_MATH
+  int32_t angle = fxAngleFromDegrees(angleDeg) - FX_QUARTER_TURN;
+  c.bx = cx + fxToFloat(fxCos(angle)) * length;
+  c.by = cy + fxToFloat(fxSin(angle)) * length;
+#else
+  float angleRad = (angleDeg - 90.0f) * PI / 180.0f;
+  c.bx = cx + cos(angleRad) * length;
+  c.by = cy + sin(angleRad) * length;
+#endif
+  c.radius = thickness / 2.0f;
+  c.prepare();
+  return c;
+}
+
+// Accumulate a capsule's coverage on row y into cov[x0, x1) (0..COVERAGE_FULL,
+// keeping the larger value where shapes overlap)
+// Returns false if the capsule does not touch the row
+inline bool coverCapsuleRow(const Capsule& c, int16_t y, int16_t x0, int16_t x1, uint8_t* cov) {
+  float o0, o1;
+  if (!c.rowSpan(y, c.radius + 0.5f, o0, o1)) return false;
+  int16_t s0 = max<int16_t>(x0, (int16_t)ceil(o0));
+  int16_t s1 = min<int16_t>(x1, (int16_t)floor(o1) + 1);
+  if (s0 >= s1) return false;
+
+  // Fully covered core: no distance evaluation needed
+  float i0, i1;
+  int16_t c0 = s1, c1 = s1;
+  if (c.radius > 0.5f && c.rowSpan(y, c.radius - 0.5f, i0, i1)) {
+    c0 = constrain((int16_t)ceil(i0), s0, s1);
+    c1 = constrain((int16_t)floor(i1) + 1, c0, s1);
+  }
+
+  for (int16_t x = s0; x < s1; x++) {
+    if (x == c0 && c1 > c0) {
+      memset(cov + c0, COVERAGE_FULL, c1 - c0);
+      x = c1 - 1;
+      continue;
+    }
+    float d = c.distance(x, y);
+    int16_t a = (int16_t)((c.radius + 0.5f - d) * COVERAGE_FULL + 0.5f);
+    if (a <= 0) continue;
+    if (a > cov[x]) cov[x] = min<int16_t>(a, COVERAGE_FULL);
+  }
+  return true;
+}
+
+#endif // PIXEL_CAPSULE_H
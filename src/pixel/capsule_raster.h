@@ -0,0 +1,157 @@
+#ifndef PIXEL_CAPSULE_RASTER_H
+#define PIXEL_CAPSULE_RASTER_H
+
+#include <Arduino.h>
+#include "damage.h"
+#include "circle_mask.h"
+#include "capsule.h"
+#include "hand_span_cache.h"
+#include "panel_canvas.h"
+
+// Capsule Rasterizer - anti-aliased hands and center dot in a single pass
+// Every hand is a capsule (a line segment with a radius), the center dot is a
+// capsule of zero length. Each damaged rectangle is walked once, row by row:
+// per-row coverage is gathered from all shapes into scratch arrays, then every
+// framebuffer pixel is written exactly once as background, hand and dot blended
+// by coverage. Pixel (x, y) is sampled at (x, y), like Adafruit GFX shapes.
+//
+// Coverage has 16 levels per shape, so a pixel is fully described by the 8-bit
+// index (handCoverage << 4 | dotCoverage). The 256 colors for the current frame
+// live in a palette (in panel byte order): RGB565 targets get palette[index],
+// indexed framebuffers get the index itself and expand it with the same palette
+// when pushing.
+
+const uint8_t CAPSULE_MAX_HANDS = 3;
+const int16_t CAPSULE_MAX_ROW = 240;
+const uint16_t RASTER_PALETTE_SIZE = 256;
+
+class CapsuleRasterizer {
+public:
+  // ---- Frame setup ----
+  void setBackground(uint16_t color) {
+    paletteDirty |= (color != bg);
+    bg = color;
+  }
+
+  void setHands(const Capsule* capsules, uint8_t count, uint16_t color) {
+    handCount = min(count, CAPSULE_MAX_HANDS);
+    for (uint8_t i = 0; i < handCount; i++) {
+      hands[i] = capsules[i];
+      cached[i].spans = nullptr;
+    }
+    paletteDirty |= (color != handColor);
+    handColor = color;
+  }
+
+  // Draw hand i from the span cache instead of its capsule (no-op if not cached)
+  // The capsule must be the one at the cached angle, for rows the cache cannot serve
+  void useCachedHand(uint8_t i, const HandSpanCache& cache, const HandSpanRef& ref) {
+    if (i >= handCount) return;
+    spanCache = &cache;
+    cached[i] = ref;
+  }
+
+  void setDot(float cx, float cy, float radius, uint16_t color) {
+    dot.ax = dot.bx = cx;
+    dot.ay = dot.by = cy;
+    dot.radius = radius;
+    dot.prepare();
+    paletteDirty |= (color != dotColor);
+    dotColor = color;
+  }
+
+  // Panel-order colors of all 256 coverage indices for the current background/hand/dot colors
+  const uint16_t* palette() {
+    if (paletteDirty) buildPalette();
+    return colorOf;
+  }
+
+  // Render the visible part of rectangle r into a panel-order RGB565 framebuffer
+  // Every pixel inside r and the circle mask is written exactly once
+  // originY is the screen row held by the first buffer row (non-zero for bands)
+  void render(uint16_t* pixels, int16_t stride, const Rect& r, const CircleMask& mask,
+              int16_t originY = 0) {
+    palette();
+    renderRect(pixels, stride, r, mask, originY);
+  }
+
+  // Same, writing coverage indices into an 8-bit indexed framebuffer
+  void renderIndexed(uint8_t* pixels, int16_t stride, const Rect& r, const CircleMask& mask) {
+    renderRect(pixels, stride, r, mask, 0);
+  }
+
+  // Pixels written since the last resetStats() (for the FPS report)
+  uint32_t pixelsWritten = 0;
+
+  void resetStats() { pixelsWritten = 0; }
+
+private:
+  void buildPalette() {
+    for (uint8_t h = 0; h <= COVERAGE_FULL; h++) {
+      uint16_t handOverBg = blend565(bg, handColor, (h * BLEND_FULL + COVERAGE_FULL / 2) / COVERAGE_FULL);
+      for (uint8_t d = 0; d <= COVERAGE_FULL; d++) {
+        uint16_t color = blend565(handOverBg, dotColor, (d * BLEND_FULL + COVERAGE_FULL / 2) / COVERAGE_FULL);
+        colorOf[(h << 4) | d] = toPanelOrder(color);
+      }
+    }
+    paletteDirty = false;
+  }
+
+  // Pixel stores: color for RGB565 targets, coverage index for indexed targets
+  void store(uint16_t* p, uint8_t index) const { *p = colorOf[index]; }
+  void store(uint8_t* p, uint8_t index) const { *p = index; }
+
+  // Runs of one index (rows no shape touches): 32-bit fills
+  void storeSpan(uint16_t* p, int16_t n, uint8_t index) const { fillSpan565(p, n, colorOf[index]); }
+  void storeSpan(uint8_t* p, int16_t n, uint8_t index) const { memset(p, index, n); }
+
+  template <typename Pixel>
+  void renderRect(Pixel* pixels, int16_t stride, const Rect& r, const CircleMask& mask, int16_t originY) {
+    for (int16_t y = r.y; y < r.bottom(); y++) {
+      int16_t x = r.x;
+      int16_t w = r.w;
+      if (!mask.clipRow(y, x, w)) continue;
+      renderRow(pixels + (int32_t)(y - originY) * stride, y, x, x + w);
+    }
+  }
+
+  template <typename Pixel>
+  void renderRow(Pixel* row, int16_t y, int16_t x0, int16_t x1) {
+    memset(handCov + x0, 0, x1 - x0);
+    memset(dotCov + x0, 0, x1 - x0);
+
+    bool touched = false;
+    for (uint8_t i = 0; i < handCount; i++) {
+      if (cached[i].spans) {
+        touched |= spanCache->coverRow(cached[i], y, x0, x1, handCov);
+      } else {
+        touched |= coverCapsuleRow(hands[i], y, x0, x1, handCov);
+      }
+    }
+    touched |= coverCapsuleRow(dot, y, x0, x1, dotCov);
+
+    if (!touched) {
+      storeSpan(row + x0, x1 - x0, 0);
+    } else {
+      for (int16_t x = x0; x < x1; x++) store(row + x, (handCov[x] << 4) | dotCov[x]);
+    }
+    pixelsWritten += x1 - x0;
+  }
+
+  Capsule hands[CAPSULE_MAX_HANDS];
+  HandSpanRef cached[CAPSULE_MAX_HANDS] = {};  // spans == nullptr: rasterize the capsule
+  const HandSpanCache* spanCache = nullptr;
+  uint8_t handCount = 0;
+  Capsule dot = {};
+  uint16_t handColor = 0;
+  uint16_t dotColor = 0;
+  uint16_t bg = 0;
+
+  uint16_t colorOf[RASTER_PALETTE_SIZE];
+  bool paletteDirty = true;
+
+  uint8_t handCov[CAPSULE_MAX_ROW];
+  uint8_t dotCov[CAPSULE_MAX_ROW];
+};
+
+#endif // PIXEL_CAPSULE_RASTER_H
@@ -0,0 +1,66 @@
+#ifndef PIXEL_CIRCLE_MASK_H
+#define PIXEL_CIRCLE_MASK_H
+
+#include <Arduino.h>
+
+// Circle Mask - per-row spans of the visible part of the round GC9A01 panel
+// The panel is a 240x240 square controller behind a round glass; roughly 21% of
+// the square (the corners) can never be seen. The span table lets the push path
+// and the rasterizer skip those pixels entirely.
+
+const int16_t CIRCLE_MASK_MAX_ROWS = 240;
+
+// Visible run of pixels on one row (len == 0 means the row is fully hidden)
+struct CircleSpan {
+  int16_t x;
+  int16_t len;
+};
+
+class CircleMask {
+public:
+  // Precompute spans for a circle centered at (cx, cy)
+  // A pixel is visible when its center lies inside the radius
+  void build(int16_t cx, int16_t cy, int16_t radius, int16_t screenW, int16_t screenH) {
+    rows = min<int16_t>(screenH, CIRCLE_MASK_MAX_ROWS);
+    visible = 0;
+
+    for (int16_t y = 0; y < rows; y++) {
+      float dy = (y + 0.5f) - cy;
+      float halfSq = (float)radius * radius - dy * dy;
+      if (halfSq <= 0) {
+        spans[y] = {0, 0};
+        continue;
+      }
+      float half = sqrt(halfSq);
+      int16_t x0 = max<int16_t>((int16_t)ceil(cx - half - 0.5f), 0);
+      int16_t x1 = min<int16_t>((int16_t)floor(cx + half - 0.5f), screenW - 1);
+      spans[y] = {x0, (int16_t)max(x1 - x0 + 1, 0)};
+      visible += spans[y].len;
+    }
+  }
+
+  const CircleSpan& row(int16_t y) const { return spans[y]; }
+
+  // Clip the run [x, x + w) on row y to the visible circle
+  // Returns false when nothing on the run is visible
+  bool clipRow(int16_t y, int16_t& x, int16_t& w) const {
+    if (y < 0 || y >= rows) return false;
+    const CircleSpan& s = spans[y];
+    int16_t x0 = max(x, s.x);
+    int16_t x1 = min<int16_t>(x + w, s.x + s.len);
+    if (x1 <= x0) return false;
+    x = x0;
+    w = x1 - x0;
+    return true;
+  }
+
+  // Number of visible pixels on the whole panel
+  uint32_t visiblePixels() const { return visible; }
+
+private:
+  CircleSpan spans[CIRCLE_MASK_MAX_ROWS];
+  int16_t rows = 0;
+  uint32_t visible = 0;
+};
+
+#endif // PIXEL_CIRCLE_MASK_H
@@ -0,0 +1,132 @@
+#ifndef PIXEL_CLOCK_FACE_H
+#define PIXEL_CLOCK_FACE_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_GC9A01A.h>
+#include "damage.h"
+#include "capsule_raster.h"
+#include "hand_span_cache.h"
+
+// Clock Face - geometry, color palette and drawing of the pixel's clock frame
+// loop() fills a ClockFrame from the transition state; the damage tracker gets
+// its description from buildFrameShapes() and the rasterizer its shapes from
+// prepareRasterizer(), so both always agree on where the hands are.
+
+// ---- Display geometry ----
+const int DISPLAY_WIDTH = 240;
+const int DISPLAY_HEIGHT = 240;
+const int CENTER_X = 120;
+const int CENTER_Y = 120;
+
+// Maximum visible radius (adjustable if needed to account for bezel)
+const int MAX_RADIUS = 120;
+
+// Hand parameters
+// Normal hands: 92% of max radius
+// Thin hand (3rd hand): 80% thickness of normal
+const float HAND_LENGTH_NORMAL = MAX_RADIUS * 0.92;
+const float HAND_THICKNESS_NORMAL = 13.0;
+const float HAND_THICKNESS_THIN = 9;  // 80% of normal
+// Tip reach is HAND_LENGTH_NORMAL + HAND_THICKNESS_NORMAL / 2 (~117 px), inside MAX_RADIUS,
+// so hands never touch the hidden corners of the round panel
+
+// Hands 1 and 2 are normal thickness, hand 3 is thin
+const float HAND_THICKNESS[FRAME_HAND_COUNT] = {HAND_THICKNESS_NORMAL, HAND_THICKNESS_NORMAL, HAND_THICKNESS_THIN};
+
+// Span cache shape of each hand (setup() registers the shapes in this order)
+const uint8_t HAND_SHAPE_NORMAL = 0;
+const uint8_t HAND_SHAPE_THIN = 1;
+const uint8_t HAND_SHAPE[FRAME_HAND_COUNT] = {HAND_SHAPE_NORMAL, HAND_SHAPE_NORMAL, HAND_SHAPE_THIN};
+
+// Center dot radius (always drawn in the foreground color)
+const int CENTER_DOT_RADIUS = 4;
+
+// ---- Color Palette ----
+// Each palette entry has {background, foreground} with good contrast
+
+// Same packing as Adafruit_SPITFT::color565(), usable in constant tables
+inline constexpr uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+  return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+struct ColorPair {
+  uint16_t bg;
+  uint16_t fg;
+  const char* name;
+};
+
+const ColorPair colorPalette[] = {
+  // Classic high contrast
+  {GC9A01A_BLACK, GC9A01A_WHITE, "White on Black"},
+  {GC9A01A_WHITE, GC9A01A_BLACK, "Black on White"},
+
+  // Earthy tones
+  {color565(245, 235, 220), color565(101, 67, 33), "Dark Brown on Cream"},  // Cream bg, dark brown fg
+  {color565(101, 67, 33), color565(245, 235, 220), "Cream on Dark Brown"},  // Dark brown bg, cream fg
+  {color565(47, 79, 79), color565(245, 222, 179), "Wheat on Dark Slate"},   // Dark slate bg, wheat fg
+  {color565(245, 222, 179), color565(47, 79, 79), "Dark Slate on Wheat"},   // Wheat bg, dark slate fg
+  {color565(139, 69, 19), color565(255, 248, 220), "Cornsilk on Saddle Brown"},  // Saddle brown bg, cornsilk fg
+  {color565(34, 49, 63), color565(236, 240, 241), "Light Gray on Navy"},    // Navy bg, light gray fg
+
+  // Bright vibrant colors
+  {color565(255, 69, 0), color565(255, 255, 224), "Light Yellow on Red-Orange"},     // Red-orange bg, light yellow fg
+  {color565(255, 215, 0), color565(139, 0, 139), "Dark Magenta on Gold"},            // Gold bg, dark magenta fg
+  {color565(0, 191, 255), color565(255, 255, 255), "White on Deep Sky Blue"},        // Deep sky blue bg, white fg
+  {color565(255, 20, 147), color565(255, 255, 240), "Ivory on Deep Pink"},           // Deep pink bg, ivory fg
+  {color565(50, 205, 50), color565(25, 25, 112), "Midnight Blue on Lime Green"},     // Lime green bg, midnight blue fg
+  {color565(138, 43, 226), color565(255, 250, 205), "Lemon Chiffon on Blue Violet"}, // Blue violet bg, lemon chiffon fg
+  {color565(255, 140, 0), color565(25, 25, 112), "Midnight Blue on Dark Orange"},    // Dark orange bg, midnight blue fg
+  {color565(0, 206, 209), color565(139, 0, 0), "Dark Red on Turquoise"},             // Turquoise bg, dark red fg
+};
+
+const int paletteSize = sizeof(colorPalette) / sizeof(ColorPair);
+
+// ---- Clock frame ----
+
+// What one clock frame shows
+struct ClockFrame {
+  float angles[FRAME_HAND_COUNT];  // Degrees, 0 = up, clockwise
+  uint16_t bg;
+  uint16_t fg;         // Center dot
+  uint16_t handColor;  // Foreground blended over background at the current opacity
+};
+
+// Describe the clock frame (hand angles, colors, bounding boxes) for damage tracking
+inline void buildFrameShapes(const ClockFrame& frame, FrameShapes& shapes) {
+  for (uint8_t i = 0; i < FRAME_HAND_COUNT; i++) {
+    shapes.angles[i] = frame.angles[i];
+    shapes.handRects[i] = handBounds(CENTER_X, CENTER_Y, frame.angles[i],
+                                     HAND_LENGTH_NORMAL, HAND_THICKNESS[i])
+                            .clipped(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  }
+
+  shapes.dotRect = {(int16_t)(CENTER_X - CENTER_DOT_RADIUS), (int16_t)(CENTER_Y - CENTER_DOT_RADIUS),
+                    (int16_t)(CENTER_DOT_RADIUS * 2 + 1), (int16_t)(CENTER_DOT_RADIUS * 2 + 1)};
+  shapes.handColor = frame.handColor;
+  shapes.dotColor = frame.fg;
+  shapes.bg = frame.bg;
+}
+
+// Load the frame's hands, center dot and colors into the rasterizer
+inline void prepareRasterizer(CapsuleRasterizer& rasterizer, const ClockFrame& frame) {
+  Capsule capsules[FRAME_HAND_COUNT];
+  for (uint8_t i = 0; i < FRAME_HAND_COUNT; i++) {
+    capsules[i] = handCapsule(CENTER_X, CENTER_Y, frame.angles[i], HAND_LENGTH_NORMAL, HAND_THICKNESS[i]);
+  }
+
+  rasterizer.setBackground(frame.bg);
+  rasterizer.setHands(capsules, FRAME_HAND_COUNT, frame.handColor);
+  rasterizer.setDot(CENTER_X, CENTER_Y, CENTER_DOT_RADIUS, frame.fg);
+}
+
+// Draw the frame's hands from the span cache (after prepareRasterizer); the
+// frame's angles must already be snapped to the cache's angle steps
+inline void useCachedHands(CapsuleRasterizer& rasterizer, HandSpanCache& cache, const ClockFrame& frame) {
+  for (uint8_t i = 0; i < FRAME_HAND_COUNT; i++) {
+    uint16_t step = HandSpanCache::angleStep(frame.angles[i]);
+    rasterizer.useCachedHand(i, cache, cache.lookup(HAND_SHAPE[i], step));
+  }
+}
+
+#endif // PIXEL_CLOCK_FACE_H
@@ -0,0 +1,70 @@
+#ifndef PIXEL_COLOR_KERNELS_H
+#define PIXEL_COLOR_KERNELS_H
+
+#include <Arduino.h>
+
+// Color Kernels - RGB565 fills and blends on 32-bit words
+// Fills store two pixels per 32-bit write. Blends spread one RGB565 pixel over a
+// 32-bit word with the 0x07E0F81F mask (green in the top half, red and blue in the
+// bottom half, each with spare bits above it), so all three channels are weighted
+// by a single multiply and scaled back with a single shift instead of three
+// unpack/divide/repack sequences. Alpha has 5 bits (0..32): the gaps between the
+// spread channels are just wide enough for a 5-bit product without carries.
+
+const uint32_t RGB565_SPREAD_MASK = 0x07E0F81F;
+const uint8_t BLEND_FULL = 32;  // Blend weight for full opacity
+
+// RGB565 -> spread word and back
+inline uint32_t spread565(uint16_t color) {
+  return (color | ((uint32_t)color << 16)) & RGB565_SPREAD_MASK;
+}
+
+inline uint16_t pack565(uint32_t spread) {
+  spread &= RGB565_SPREAD_MASK;
+  return (uint16_t)((spread >> 16) | spread);
+}
+
+// Blend two host-order RGB565 colors, alpha in 0..BLEND_FULL
+// Same result as weighting each channel separately: (fg * alpha + bg * (32 - alpha)) >> 5
+inline uint16_t blend565(uint16_t bg, uint16_t fg, uint8_t alpha) {
+  if (alpha >= BLEND_FULL) return fg;
+  if (alpha == 0) return bg;
+  return pack565((spread565(fg) * alpha + spread565(bg) * (BLEND_FULL - alpha)) >> 5);
+}
+
+// 8-bit opacity (0..255) to blend weight: /256 by shift, rounded, 255 -> full
+inline uint8_t opacityToBlend(uint8_t opacity) {
+  return (opacity + 4) >> 3;
+}
+
+// Blend with an 8-bit opacity; within 1 LSB per channel of the exact /255 blend
+inline uint16_t blend565Opacity(uint16_t bg, uint16_t fg, uint8_t opacity) {
+  return blend565(bg, fg, opacityToBlend(opacity));
+}
+
+// Blend with an 8-bit opacity, each channel weighted separately with an exact /255
+// (the original blendColor math). Three divides per call: for tables built once,
+// such as a transition's color ramp, not for per-pixel work
+inline uint16_t blend565Exact(uint16_t bg, uint16_t fg, uint8_t opacity) {
+  if (opacity == 255) return fg;
+  if (opacity == 0) return bg;
+  uint8_t r = (((fg >> 11) & 0x1F) * opacity + ((bg >> 11) & 0x1F) * (255 - opacity)) / 255;
+  uint8_t g = (((fg >> 5) & 0x3F) * opacity + ((bg >> 5) & 0x3F) * (255 - opacity)) / 255;
+  uint8_t b = ((fg & 0x1F) * opacity + (bg & 0x1F) * (255 - opacity)) / 255;
+  return (r << 11) | (g << 5) | b;
+}
+
+// Fill w pixels with one (already stored-order) color, two pixels per 32-bit write
+inline void fillSpan565(uint16_t* row, int16_t w, uint16_t color) {
+  if (w <= 0) return;
+  if ((uintptr_t)row & 2) {
+    *row++ = color;
+    w--;
+  }
+  uint32_t pair = ((uint32_t)color << 16) | color;
+  uint32_t* words = (uint32_t*)row;
+  for (int16_t i = 0; i < w / 2; i++) words[i] = pair;
+  if (w & 1) row[w - 1] = color;
+}
+
+#endif // PIXEL_COLOR_KERNELS_H
@@ -0,0 +1,66 @@
+#ifndef PIXEL_COLOR_RAMP_H
+#define PIXEL_COLOR_RAMP_H
+
+#include <Arduino.h>
+#include "fixed_math.h"
+
+// Color Ramp - a transition's colors, precomputed at fixed progress steps
+// Background, foreground and hand opacity all follow the same ease-in-out curve
+// between endpoints that are fixed when the transition starts. Instead of easing,
+// interpolating and blending every frame, startTransition() evaluates the curve
+// once per step and each frame reads the nearest step. Background, foreground and
+// opacity are the exact /255 results at each step's progress, and within one level
+// of the live values anywhere else. The hand color is blended from all three, so
+// its own rounding can add up to two levels over a step; each step instead holds
+// the middle of the hand colors across the half steps on either side, which keeps
+// it within one RGB565 level of the live blend. A finished transition takes its
+// colors from the live math, not the ramp, so it settles on the exact target.
+
+const uint16_t COLOR_RAMP_STEPS = 256;
+
+// Colors at one progress step
+struct ColorRampEntry {
+  uint16_t bg;
+  uint16_t fg;
+  uint16_t hand;     // fg blended over bg with `opacity`
+  uint8_t opacity;
+};
+
+// Per channel, the middle of the range spanned by three RGB565 colors
+inline uint16_t midrange565(uint16_t a, uint16_t b, uint16_t c) {
+  const uint8_t shifts[3] = {11, 5, 0};
+  const uint8_t masks[3] = {0x1F, 0x3F, 0x1F};
+  uint16_t out = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    uint8_t ca = (a >> shifts[i]) & masks[i];
+    uint8_t cb = (b >> shifts[i]) & masks[i];
+    uint8_t cc = (c >> shifts[i]) & masks[i];
+    uint8_t lo = min(ca, min(cb, cc));
+    uint8_t hi = max(ca, max(cb, cc));
+    out |= ((lo + hi + 1) >> 1) << shifts[i];
+  }
+  return out;
+}
+
+class ColorRamp {
+public:
+  // Store the colors for step i (0..COLOR_RAMP_STEPS, progress i / COLOR_RAMP_STEPS)
+  void set(uint16_t i, const ColorRampEntry& entry) { steps[i] = entry; }
+
+  // Nearest step for progress t in Q16 (0..Q16_ONE)
+  const ColorRampEntry& at(q16_t t) const {
+    t = constrain(t, 0, Q16_ONE);
+    return steps[((uint32_t)t * COLOR_RAMP_STEPS + Q16_HALF) >> 16];
+  }
+
+  // Nearest step for progress t in 0..1
+  const ColorRampEntry& at(float t) const {
+    t = constrain(t, 0.0f, 1.0f);
+    return steps[(uint16_t)(t * COLOR_RAMP_STEPS + 0.5f)];
+  }
+
+private:
+  ColorRampEntry steps[COLOR_RAMP_STEPS + 1];
+};
+
+#endif // PIXEL_COLOR_RAMP_H
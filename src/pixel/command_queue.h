@@ -0,0 +1,59 @@
+#ifndef PIXEL_COMMAND_QUEUE_H
+#define PIXEL_COMMAND_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// Command Queue - bounded single-producer/single-consumer ring
+// ESP-NOW packets arrive in the WiFi task while loop() is in the middle of a
+// frame. The receive callback only copies each packet into the ring; loop()
+// drains it between frames and applies the commands there, so hand, transition,
+// color and mode state is only ever touched by one task and the radio stack is
+// never blocked by command handling.
+//
+// One producer (push) and one consumer (pop) need no lock: each side owns one
+// index, and the release/acquire pair on it orders the slot copy before the
+// other side sees the index move. A full ring rejects the push (counted in
+// `dropped`) rather than overwriting a command loop() may be reading.
+
+template <typename T, uint8_t CAPACITY>
+class CommandQueue {
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+public:
+  // Producer: copy an item in; false (and counted) if the ring is full
+  bool push(const T& item) {
+    uint8_t t = tail.load(std::memory_order_relaxed);
+    if ((uint8_t)(t - head.load(std::memory_order_acquire)) == CAPACITY) {
+      dropped++;
+      return false;
+    }
+    slots[t & (CAPACITY - 1)] = item;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer: copy the oldest item out; false if the ring is empty
+  bool pop(T& item) {
+    uint8_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) return false;
+    item = slots[h & (CAPACITY - 1)];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer: nothing waiting
+  bool isEmpty() const {
+    return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+  }
+
+  // Items rejected because the ring was full (written by the producer only)
+  volatile uint32_t dropped = 0;
+
+private:
+  T slots[CAPACITY];
+  std::atomic<uint8_t> head{0};  // Next slot to pop (consumer)
+  std::atomic<uint8_t> tail{0};  // Next slot to push (producer)
+};
+
+#endif // PIXEL_COMMAND_QUEUE_H
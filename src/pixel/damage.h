@@ -0,0 +1,197 @@
+#ifndef PIXEL_DAMAGE_H
+#define PIXEL_DAMAGE_H
+
+#include <Arduino.h>
+#include "fixed_math.h"
+
+// Damage Tracking - work out which parts of the panel actually changed
+// A clock frame is just a background, three hands and a center dot. When a hand
+// moves, only the union of its old and new bounding boxes needs to be redrawn
+// and pushed; everything else on the panel is already correct.
+
+// ---- Rectangle (x/y inclusive, w/h in pixels) ----
+struct Rect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+
+  bool isEmpty() const { return w <= 0 || h <= 0; }
+  int32_t area() const { return isEmpty() ? 0 : (int32_t)w * h; }
+  int16_t right() const { return x + w; }   // Exclusive
+  int16_t bottom() const { return y + h; }  // Exclusive
+
+  bool intersects(const Rect& o) const {
+    return !isEmpty() && !o.isEmpty() &&
+           x < o.right() && o.x < right() &&
+           y < o.bottom() && o.y < bottom();
+  }
+
+  // Bounding box of both rectangles
+  Rect unite(const Rect& o) const {
+    if (isEmpty()) return o;
+    if (o.isEmpty()) return *this;
+    int16_t nx = min(x, o.x);
+    int16_t ny = min(y, o.y);
+    return {nx, ny, (int16_t)(max(right(), o.right()) - nx), (int16_t)(max(bottom(), o.bottom()) - ny)};
+  }
+
+  // Clip to a 0,0-based screen of the given size
+  Rect clipped(int16_t screenW, int16_t screenH) const {
+    int16_t nx = max<int16_t>(x, 0);
+    int16_t ny = max<int16_t>(y, 0);
+    int16_t nr = min<int16_t>(right(), screenW);
+    int16_t nb = min<int16_t>(bottom(), screenH);
+    if (nr <= nx || nb <= ny) return {0, 0, 0, 0};
+    return {nx, ny, (int16_t)(nr - nx), (int16_t)(nb - ny)};
+  }
+
+  bool operator==(const Rect& o) const {
+    return x == o.x && y == o.y && w == o.w && h == o.h;
+  }
+};
+
+// Bounding box of a hand drawn from (cx, cy) at angleDeg (0 = up, clockwise)
+// Includes the rounded caps plus one pixel of margin for rasterizer rounding
+inline Rect handBounds(float cx, float cy, float angleDeg, float length, float thickness) {
+#ifdef USE_FIXED_POINT_MATH
+  int32_t angle = fxAngleFromDegrees(angleDeg) - FX_QUARTER_TURN;
+  float endX = cx + fxToFloat(fxCos(angle)) * length;
+  float endY = cy + fxToFloat(fxSin(angle)) * length;
+#else
+  float angleRad = (angleDeg - 90.0f) * PI / 180.0f;
+  float endX = cx + cos(angleRad) * length;
+  float endY = cy + sin(angleRad) * length;
+#endif
+  float margin = thickness / 2.0f + 1.0f;
+
+  int16_t x0 = (int16_t)floor(min(cx, endX) - margin);
+  int16_t y0 = (int16_t)floor(min(cy, endY) - margin);
+  int16_t x1 = (int16_t)ceil(max(cx, endX) + margin);
+  int16_t y1 = (int16_t)ceil(max(cy, endY) + margin);
+  return {x0, y0, (int16_t)(x1 - x0 + 1), (int16_t)(y1 - y0 + 1)};
+}
+
+// ---- Frame description used for damage comparison ----
+const uint8_t FRAME_HAND_COUNT = 3;
+
+struct FrameShapes {
+  float angles[FRAME_HAND_COUNT];   // Hand angles (degrees)
+  Rect handRects[FRAME_HAND_COUNT]; // Hand bounding boxes (screen clipped)
+  Rect dotRect;                     // Center dot bounding box
+  uint16_t handColor;               // Blended hand color
+  uint16_t dotColor;                // Center dot color
+  uint16_t bg;                      // Background color
+};
+
+// ---- Damage list: non-overlapping rectangles to redraw and push ----
+const uint8_t MAX_DAMAGE_RECTS = 6;
+
+struct DamageList {
+  Rect rects[MAX_DAMAGE_RECTS];
+  uint8_t count = 0;
+  bool full = false;  // True when the whole screen must be redrawn
+  Rect screen = {0, 0, 0, 0};
+
+  void clear() {
+    count = 0;
+    full = false;
+  }
+
+  void setFull() {
+    full = true;
+    rects[0] = screen;
+    count = 1;
+  }
+
+  // Add a rectangle, merging it with any rectangles it overlaps so the
+  // list stays disjoint (no pixel is redrawn or pushed twice)
+  void add(Rect r) {
+    if (full) return;
+    r = r.clipped(screen.w, screen.h);
+    if (r.isEmpty()) return;
+
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (uint8_t i = 0; i < count; i++) {
+        if (rects[i].intersects(r)) {
+          r = r.unite(rects[i]);
+          rects[i] = rects[--count];
+          merged = true;
+          break;
+        }
+      }
+    }
+
+    if (count >= MAX_DAMAGE_RECTS) {
+      setFull();
+      return;
+    }
+    rects[count++] = r;
+  }
+
+  int32_t area() const {
+    int32_t total = 0;
+    for (uint8_t i = 0; i < count; i++) total += rects[i].area();
+    return total;
+  }
+
+  bool isEmpty() const { return count == 0; }
+};
+
+// ---- Damage tracker ----
+// Remembers what is currently on a surface (the panel, or a framebuffer)
+// and diffs each new frame against it
+class DamageTracker {
+public:
+  DamageTracker() : width(0), height(0) {}
+  DamageTracker(int16_t screenW, int16_t screenH) : width(screenW), height(screenH) {}
+
+  // Forget the surface contents (after a mode screen or OTA progress was drawn)
+  void invalidate() { valid = false; }
+
+  // Fill `out` with the regions that differ between the surface and `next`
+  void computeDamage(const FrameShapes& next, DamageList& out) const {
+    out.screen = {0, 0, width, height};
+    out.clear();
+
+    // Background change or unknown contents: everything is damaged
+    if (!valid || next.bg != last.bg) {
+      out.setFull();
+      return;
+    }
+
+    // Hand color changes repaint every hand
+    bool handColorChanged = (next.handColor != last.handColor);
+
+    for (uint8_t i = 0; i < FRAME_HAND_COUNT; i++) {
+      if (handColorChanged || next.angles[i] != last.angles[i]) {
+        out.add(last.handRects[i].unite(next.handRects[i]));
+      }
+    }
+
+    if (next.dotColor != last.dotColor) {
+      out.add(next.dotRect);
+    }
+
+    // Large damage is cheaper as one full-screen window
+    if (out.area() * 4 > (int32_t)width * height * 3) {
+      out.setFull();
+    }
+  }
+
+  // Record the frame now on the surface
+  void commit(const FrameShapes& presented) {
+    last = presented;
+    valid = true;
+  }
+
+private:
+  int16_t width;
+  int16_t height;
+  FrameShapes last;
+  bool valid = false;
+};
+
+#endif // PIXEL_DAMAGE_H
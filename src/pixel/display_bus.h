@@ -0,0 +1,107 @@
+#ifndef PIXEL_DISPLAY_BUS_H
+#define PIXEL_DISPLAY_BUS_H
+
+#include <Arduino.h>
+#include <Adafruit_GC9A01A.h>
+#include "circle_mask.h"
+
+// Display Bus - everything that leaves the MCU for the panel goes through here
+// The render loop only talks to DisplayBus, so the wire strategy (full frame,
+// partial windows, DMA) can change without touching the drawing code.
+// Pixels are always in panel byte order (see panel_canvas.h) and are sent as-is.
+
+// Command bytes spent per address window (CASET + 4, PASET + 4, RAMWR)
+const uint8_t WINDOW_OVERHEAD_BYTES = 11;
+
+class DisplayBus {
+public:
+  virtual ~DisplayBus() {}
+
+  // Push a w x h window of panel-order RGB565 pixels to panel position (x, y)
+  // src points at the window's top-left pixel, stride is the source row length in pixels
+  virtual void pushWindow(int16_t x, int16_t y, int16_t w, int16_t h,
+                          const uint16_t* src, int16_t stride) = 0;
+
+  // Push only the visible part of a window: one single-row window per scanline,
+  // clipped to the circle mask, so the hidden corners never go over the wire
+  virtual void pushMaskedWindow(int16_t x, int16_t y, int16_t w, int16_t h,
+                                const uint16_t* src, int16_t stride, const CircleMask& mask) {
+    for (int16_t row = 0; row < h; row++) {
+      int16_t sx = x;
+      int16_t sw = w;
+      if (!mask.clipRow(y + row, sx, sw)) continue;
+      pushWindow(sx, y + row, sw, 1, src + (int32_t)row * stride + (sx - x), sw);
+    }
+  }
+
+  // ---- Asynchronous buses ----
+  // A blocking bus has finished every push before returning, so its fences are always met.
+
+  // Token that is met once everything pushed so far has left the MCU
+  virtual uint32_t insertFence() { return 0; }
+
+  // Block until a fence is met; source memory pushed before it may then be reused
+  virtual void waitFence(uint32_t fence) {}
+
+  // True when pushMaskedWindow() widens windows to full rows (the caller may then
+  // just as well render whole rows)
+  virtual bool pushesFullRows() const { return false; }
+
+  // Bytes sent since the last resetStats(), pixels plus window commands (for the FPS report)
+  uint32_t bytesPushed = 0;
+  uint32_t windowsPushed = 0;
+
+  void resetStats() {
+    bytesPushed = 0;
+    windowsPushed = 0;
+  }
+};
+
+// GC9A01A panel driven through the Adafruit driver
+// Uses address-window writes, so only the window's pixels go over SPI
+// Pixels are passed as big-endian, so the driver copies them out without swapping
+class GC9A01ABus : public DisplayBus {
+public:
+  explicit GC9A01ABus(Adafruit_GC9A01A& panel) : tft(panel) {}
+
+  void pushWindow(int16_t x, int16_t y, int16_t w, int16_t h,
+                  const uint16_t* src, int16_t stride) override {
+    if (w <= 0 || h <= 0) return;
+
+    tft.startWrite();
+    tft.setAddrWindow(x, y, w, h);
+    if (stride == w) {
+      // Contiguous window - one bulk write
+      tft.writePixels((uint16_t*)src, (uint32_t)w * h, true, true);
+    } else {
+      for (int16_t row = 0; row < h; row++) {
+        tft.writePixels((uint16_t*)(src + (int32_t)row * stride), w, true, true);
+      }
+    }
+    tft.endWrite();
+
+    bytesPushed += (uint32_t)w * h * 2 + WINDOW_OVERHEAD_BYTES;
+    windowsPushed++;
+  }
+
+  // Same as the default, but keeps the SPI transaction open across all scanlines
+  void pushMaskedWindow(int16_t x, int16_t y, int16_t w, int16_t h,
+                        const uint16_t* src, int16_t stride, const CircleMask& mask) override {
+    tft.startWrite();
+    for (int16_t row = 0; row < h; row++) {
+      int16_t sx = x;
+      int16_t sw = w;
+      if (!mask.clipRow(y + row, sx, sw)) continue;
+      tft.setAddrWindow(sx, y + row, sw, 1);
+      tft.writePixels((uint16_t*)(src + (int32_t)row * stride + (sx - x)), sw, true, true);
+      bytesPushed += (uint32_t)sw * 2 + WINDOW_OVERHEAD_BYTES;
+      windowsPushed++;
+    }
+    tft.endWrite();
+  }
+
+private:
+  Adafruit_GC9A01A& tft;
+};
+
+#endif // PIXEL_DISPLAY_BUS_H
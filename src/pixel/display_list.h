@@ -0,0 +1,164 @@
+#ifndef PIXEL_DISPLAY_LIST_H
+#define PIXEL_DISPLAY_LIST_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include "panel_canvas.h"
+
+// Display List - a frame recorded as filled rectangles instead of pixels
+// DisplayList is an Adafruit_GFX target, so the existing screen code (fillScreen,
+// text, circles) draws into it unchanged. Every GFX shape ends up as pixel, line
+// or rectangle fills; those are recorded (adjacent fills of the same color are
+// merged) and replayed later, one band of rows at a time, by the band renderer.
+// Recording can be limited to a range of rows, so a screen with more ops than
+// the list holds is recorded (and streamed) in several passes.
+
+// Enough for every mode screen in one pass (the largest, HIGHLIGHT_IDLE with its
+// ring border and MAC address, is about 580 ops); 10 bytes each
+const uint16_t DISPLAY_LIST_MAX_OPS = 768;
+
+// Solid rectangle fill (color in panel byte order)
+struct DisplayOp {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+  uint16_t color;
+};
+
+class DisplayList : public Adafruit_GFX {
+public:
+  DisplayList(int16_t w, int16_t h) : Adafruit_GFX(w, h) {}
+
+  // Forget all recorded ops
+  void clear() {
+    count = 0;
+    overflowed = false;
+  }
+
+  // Record only rows [y, y + rows) from now on (the whole screen by default)
+  void setRows(int16_t y, int16_t rows) {
+    rowBegin = max<int16_t>(y, 0);
+    rowEnd = min<int16_t>(y + rows, _height);
+  }
+
+  int16_t firstRow() const { return rowBegin; }
+  int16_t endRow() const { return rowEnd; }
+
+  uint16_t size() const { return count; }
+
+  // True when ops were dropped because the list was full
+  bool hasOverflowed() const { return overflowed; }
+
+  // Draw every op that touches rows [bandY, bandY + rows) into a band buffer
+  // (row 0 of the buffer is screen row bandY, rows are `stride` pixels long)
+  void replay(uint16_t* band, int16_t stride, int16_t bandY, int16_t rows) const {
+    int16_t bandEnd = bandY + rows;
+    for (uint16_t i = 0; i < count; i++) {
+      const DisplayOp& op = ops[i];
+      int16_t y0 = max(op.y, bandY);
+      int16_t y1 = min<int16_t>(op.y + op.h, bandEnd);
+      for (int16_t y = y0; y < y1; y++) {
+        fillSpan565(band + (int32_t)(y - bandY) * stride + op.x, op.w, op.color);
+      }
+    }
+  }
+
+  // ---- Adafruit_GFX primitives: record instead of drawing ----
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override { addRect(x, y, 1, 1, color); }
+  void writePixel(int16_t x, int16_t y, uint16_t color) override { addRect(x, y, 1, 1, color); }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { addRect(x, y, w, 1, color); }
+  void writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override { addRect(x, y, w, 1, color); }
+
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override { addRect(x, y, 1, h, color); }
+  void writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override { addRect(x, y, 1, h, color); }
+
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override { addRect(x, y, w, h, color); }
+  void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override { addRect(x, y, w, h, color); }
+
+  // A full-screen fill hides everything recorded before it
+  void fillScreen(uint16_t color) override {
+    clear();
+    addRect(0, 0, _width, _height, color);
+  }
+
+private:
+  void addRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    // Normalize negative sizes and clip to the screen and the recorded rows
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    int16_t x1 = min<int16_t>(x + w, _width);
+    int16_t y1 = min<int16_t>(y + h, rowEnd);
+    x = max<int16_t>(x, 0);
+    y = max<int16_t>(y, rowBegin);
+    if (x1 <= x || y1 <= y) return;
+    w = x1 - x;
+    h = y1 - y;
+    color = toPanelOrder(color);
+
+    // Merge with the previous op when it continues it (text glyph runs, circle spans)
+    if (count > 0) {
+      DisplayOp& last = ops[count - 1];
+      if (last.color == color) {
+        if (last.y == y && last.h == h && last.x + last.w == x) {
+          last.w += w;
+          return;
+        }
+        if (last.x == x && last.w == w && last.y + last.h == y) {
+          last.h += h;
+          return;
+        }
+      }
+    }
+
+    if (count >= DISPLAY_LIST_MAX_OPS) {
+      overflowed = true;
+      return;
+    }
+    ops[count++] = {x, y, w, h, color};
+  }
+
+  DisplayOp ops[DISPLAY_LIST_MAX_OPS];
+  uint16_t count = 0;
+  bool overflowed = false;
+  int16_t rowBegin = 0;
+  int16_t rowEnd = _height;
+};
+
+// Largest dx with dx^2 + dy^2 <= limitSq (-1 when the row misses the circle)
+inline int16_t circleHalfWidth(int32_t limitSq, int16_t dy) {
+  int32_t left = limitSq - (int32_t)dy * dy;
+  if (left < 0) return -1;
+  int16_t half = (int16_t)sqrtf((float)left);
+  while ((int32_t)(half + 1) * (half + 1) <= left) half++;
+  while ((int32_t)half * half > left) half--;
+  return half;
+}
+
+// Fill the ring of pixels from radius inner to outer (both included) with row spans
+// drawCircle() outlines reach a display list one pixel (one op) at a time, so a
+// thick border drawn as concentric circles would not fit; this is two ops per row
+// at most, fewer where consecutive rows have the same span and merge.
+inline void fillRing(Adafruit_GFX& gfx, int16_t cx, int16_t cy, int16_t inner, int16_t outer, uint16_t color) {
+  int32_t outerSq = (int32_t)outer * outer + outer;  // Distance below outer + 0.5
+  int32_t innerSq = (int32_t)inner * inner - inner;  // Distance below inner - 0.5 (the hole)
+
+  // Left halves top to bottom, then right halves, so equal spans are adjacent
+  for (uint8_t side = 0; side < 2; side++) {
+    for (int16_t dy = -outer; dy <= outer; dy++) {
+      int16_t outerHalf = circleHalfWidth(outerSq, dy);
+      int16_t holeHalf = inner > 0 ? circleHalfWidth(innerSq, dy) : -1;
+      if (holeHalf < 0) {
+        if (side == 0) gfx.drawFastHLine(cx - outerHalf, cy + dy, 2 * outerHalf + 1, color);
+      } else if (side == 0) {
+        gfx.drawFastHLine(cx - outerHalf, cy + dy, outerHalf - holeHalf, color);
+      } else {
+        gfx.drawFastHLine(cx + holeHalf + 1, cy + dy, outerHalf - holeHalf, color);
+      }
+    }
+  }
+}
+
+#endif // PIXEL_DISPLAY_LIST_H
@@ -0,0 +1,151 @@
+#ifndef PIXEL_DMA_BUS_H
+#define PIXEL_DMA_BUS_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <driver/spi_master.h>
+#include <esp_lcd_panel_io.h>
+#include "display_bus.h"
+
+// DMA Display Bus (ESP32-S3) - queues pixel windows to the SPI peripheral and returns
+// The Adafruit driver initializes the panel first, then hands the SPI2 (FSPI) pins over
+// to the esp_lcd SPI panel IO, which streams color data with DMA in the background.
+// Fences tell the renderer when a framebuffer is no longer being read.
+
+// GC9A01 commands used for windowed writes
+#define GC9A01_CMD_CASET  0x2A  // Column address set
+#define GC9A01_CMD_RASET  0x2B  // Row address set
+#define GC9A01_CMD_RAMWR  0x2C  // Memory write (restarts at window origin)
+#define GC9A01_CMD_RAMWRC 0x3C  // Memory write continue (next row of the window)
+
+// Largest single DMA transaction; esp_lcd splits bigger color writes automatically
+const size_t DMA_MAX_TRANSFER_BYTES = 240 * 40 * 2;
+const size_t DMA_QUEUE_DEPTH = 10;
+
+class DmaDisplayBus : public DisplayBus {
+public:
+  DmaDisplayBus(int16_t screenW, int16_t screenH) : width(screenW), height(screenH) {}
+
+  // Take over the (already initialized) panel on SPI2 with DMA
+  // Call after tft.begin() and SPI.end(); returns false if the bus cannot be claimed
+  bool begin(int sclkPin, int mosiPin, int csPin, int dcPin, uint32_t clockHz) {
+    spi_bus_config_t buscfg = {};
+    buscfg.sclk_io_num = sclkPin;
+    buscfg.mosi_io_num = mosiPin;
+    buscfg.miso_io_num = -1;
+    buscfg.quadwp_io_num = -1;
+    buscfg.quadhd_io_num = -1;
+    buscfg.max_transfer_sz = DMA_MAX_TRANSFER_BYTES;
+    if (spi_bus_initialize(SPI2_HOST, &buscfg, SPI_DMA_CH_AUTO) != ESP_OK) {
+      return false;
+    }
+
+    esp_lcd_panel_io_spi_config_t iocfg = {};
+    iocfg.cs_gpio_num = csPin;
+    iocfg.dc_gpio_num = dcPin;
+    iocfg.spi_mode = 0;
+    iocfg.pclk_hz = clockHz;
+    iocfg.trans_queue_depth = DMA_QUEUE_DEPTH;
+    iocfg.on_color_trans_done = onColorDone;
+    iocfg.user_ctx = this;
+    iocfg.lcd_cmd_bits = 8;
+    iocfg.lcd_param_bits = 8;
+    if (esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)SPI2_HOST, &iocfg, &io) != ESP_OK) {
+      spi_bus_free(SPI2_HOST);
+      return false;
+    }
+
+    doneSignal = xSemaphoreCreateBinary();
+    return doneSignal != nullptr;
+  }
+
+  // Queue a window; returns as soon as the color data is queued for DMA
+  // The source must stay untouched until a fence inserted afterwards is met
+  void pushWindow(int16_t x, int16_t y, int16_t w, int16_t h,
+                  const uint16_t* src, int16_t stride) override {
+    if (w <= 0 || h <= 0) return;
+
+    setWindow(x, y, w, h);
+    if (stride == w) {
+      queueColor(GC9A01_CMD_RAMWR, src, (size_t)w * h * 2);
+    } else {
+      // Non-contiguous rows: first row restarts at the window origin, the rest continue
+      for (int16_t row = 0; row < h; row++) {
+        queueColor(row == 0 ? GC9A01_CMD_RAMWR : GC9A01_CMD_RAMWRC,
+                   src + (int32_t)row * stride, (size_t)w * 2);
+      }
+    }
+
+    bytesPushed += (uint32_t)w * h * 2 + WINDOW_OVERHEAD_BYTES;
+    windowsPushed++;
+  }
+
+  // Per-scanline windows would serialize the queue (every address command waits for
+  // the DMA queue to drain), so push the damaged rows as one full-width band instead.
+  // The extra corner pixels are hidden behind the round glass anyway; rows the mask
+  // hides completely are left off the top and bottom of the band.
+  // Source rows must cover the whole panel width: src is column x of row y, and
+  // rows are `stride` pixels apart (one contiguous write when stride == width).
+  void pushMaskedWindow(int16_t x, int16_t y, int16_t w, int16_t h,
+                        const uint16_t* src, int16_t stride, const CircleMask& mask) override {
+    if (w <= 0 || h <= 0) return;
+
+    int16_t first = 0;
+    int16_t last = h;
+    while (first < last && !rowVisible(mask, y + first)) first++;
+    while (last > first && !rowVisible(mask, y + last - 1)) last--;
+    if (first == last) return;
+
+    pushWindow(0, y + first, width, last - first, src - x + (int32_t)first * stride, stride);
+  }
+
+  uint32_t insertFence() override { return queued; }
+
+  void waitFence(uint32_t fence) override {
+    while ((int32_t)(done - fence) < 0) {
+      xSemaphoreTake(doneSignal, pdMS_TO_TICKS(5));
+    }
+  }
+
+  bool pushesFullRows() const override { return true; }
+
+private:
+  bool rowVisible(const CircleMask& mask, int16_t y) const {
+    int16_t x = 0;
+    int16_t w = width;
+    return mask.clipRow(y, x, w);
+  }
+
+  void setWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+    uint16_t x1 = x + w - 1;
+    uint16_t y1 = y + h - 1;
+    uint8_t caset[4] = {(uint8_t)(x >> 8), (uint8_t)x, (uint8_t)(x1 >> 8), (uint8_t)x1};
+    uint8_t raset[4] = {(uint8_t)(y >> 8), (uint8_t)y, (uint8_t)(y1 >> 8), (uint8_t)y1};
+    esp_lcd_panel_io_tx_param(io, GC9A01_CMD_CASET, caset, 4);
+    esp_lcd_panel_io_tx_param(io, GC9A01_CMD_RASET, raset, 4);
+  }
+
+  void queueColor(int cmd, const void* data, size_t bytes) {
+    queued++;
+    esp_lcd_panel_io_tx_color(io, cmd, data, bytes);
+  }
+
+  // Called from the SPI ISR once the last chunk of a color write is out
+  static bool IRAM_ATTR onColorDone(esp_lcd_panel_io_handle_t panelIo,
+                                    esp_lcd_panel_io_event_data_t* edata, void* ctx) {
+    DmaDisplayBus* bus = (DmaDisplayBus*)ctx;
+    bus->done++;
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(bus->doneSignal, &woken);
+    return woken == pdTRUE;
+  }
+
+  int16_t width;
+  int16_t height;
+  esp_lcd_panel_io_handle_t io = nullptr;
+  SemaphoreHandle_t doneSignal = nullptr;
+  volatile uint32_t queued = 0;  // Color writes queued (fence tokens)
+  volatile uint32_t done = 0;    // Color writes completed
+};
+
+#endif // PIXEL_DMA_BUS_H
@@ -0,0 +1,80 @@
+#ifndef PIXEL_EASING_H
+#define PIXEL_EASING_H
+
+#include <Arduino.h>
+#include "ESPNowComm.h"
+
+// Easing - the float easing curves behind every TransitionType
+// All easing functions take t in range [0, 1] and return eased value in range [0, 1].
+// Builds with USE_FIXED_POINT_MATH use the Q16 versions in fixed_math.h, which
+// the host tests check against these.
+
+inline float easeLinear(float t) {
+  return t;
+}
+
+inline float easeInOut(float t) {
+  // Smoothstep (S-curve)
+  return t < 0.5 ? 2 * t * t : 1 - pow(-2 * t + 2, 2) / 2;
+}
+
+inline float easeElasticOut(float t) {
+  if (t == 0 || t == 1) return t;
+  const float c4 = (2 * PI) / 3;
+  return pow(2, -10 * t) * sin((t * 10 - 0.75) * c4) + 1;
+}
+
+inline float easeBounceOut(float t) {
+  // Robert Penner's bounce ease out
+  if (t < (1.0 / 2.75)) {
+    return 7.5625 * t * t;
+  } else if (t < (2.0 / 2.75)) {
+    t -= (1.5 / 2.75);
+    return 7.5625 * t * t + 0.75;
+  } else if (t < (2.5 / 2.75)) {
+    t -= (2.25 / 2.75);
+    return 7.5625 * t * t + 0.9375;
+  } else {
+    t -= (2.625 / 2.75);
+    return 7.5625 * t * t + 0.984375;
+  }
+}
+
+inline float easeBackIn(float t) {
+  // Robert Penner's back ease in
+  const float c1 = 1.70158;
+  const float c3 = c1 + 1;
+  return c3 * t * t * t - c1 * t * t;
+}
+
+inline float easeBackOut(float t) {
+  // Robert Penner's back ease out
+  const float c1 = 1.70158;
+  const float c3 = c1 + 1;
+  return 1 + c3 * pow(t - 1, 3) + c1 * pow(t - 1, 2);
+}
+
+inline float easeBackInOut(float t) {
+  // Robert Penner's back ease in-out
+  const float c1 = 1.70158 * 1.525;
+  return t < 0.5
+    ? (pow(2 * t, 2) * ((c1 + 1) * 2 * t - c1)) / 2
+    : (pow(2 * t - 2, 2) * ((c1 + 1) * (t * 2 - 2) + c1) + 2) / 2;
+}
+
+// Apply the current easing function
+inline float applyEasing(float t, TransitionType easing) {
+  switch (easing) {
+    case TRANSITION_LINEAR: return easeLinear(t);
+    case TRANSITION_EASE_IN_OUT: return easeInOut(t);
+    case TRANSITION_ELASTIC: return easeElasticOut(t);
+    case TRANSITION_BOUNCE: return easeBounceOut(t);
+    case TRANSITION_BACK_IN: return easeBackIn(t);
+    case TRANSITION_BACK_OUT: return easeBackOut(t);
+    case TRANSITION_BACK_IN_OUT: return easeBackInOut(t);
+    case TRANSITION_INSTANT: return 1.0;  // Jump immediately to target
+    default: return t;
+  }
+}
+
+#endif // PIXEL_EASING_H
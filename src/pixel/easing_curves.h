@@ -0,0 +1,133 @@
+#ifndef PIXEL_EASING_CURVES_H
+#define PIXEL_EASING_CURVES_H
+
+#include <Arduino.h>
+#include <ESPNowComm.h>
+#include "fixed_math.h"
+
+// Easing Curves - custom easings uploaded at runtime (CMD_UPLOAD_EASING)
+// The built-in easings are code, so a new one means reflashing every pixel. An
+// uploaded curve (cubic Bezier control points or 64 samples) goes into one of
+// EASING_SLOTS slots and is used by transitions TRANSITION_CUSTOM_1 + slot.
+//
+// At upload the curve is baked into a table of EASING_TABLE_STEPS + 1 values over
+// t = 0..1: a Bezier is solved for each table t (x(s) = t by bisection, then y(s)),
+// samples are interpolated with Catmull-Rom. Evaluating is then a lookup and a
+// lerp, whatever the curve's format. Tables are Q16 with USE_FIXED_POINT_MATH,
+// float otherwise. A slot that was never uploaded eases linearly.
+//
+// Uploads are applied in loop() (the command queue), so a table never changes
+// under a frame; a transition already running with the slot continues on the
+// new curve.
+
+const uint16_t EASING_TABLE_STEPS = 256;  // Table intervals over t = 0..1
+
+#ifdef USE_FIXED_POINT_MATH
+typedef q16_t easing_value_t;   // Q16 progress and eased value
+#else
+typedef float easing_value_t;   // 0.0-1.0 progress and eased value
+#endif
+
+class EasingCurves {
+public:
+  // Bake an uploaded curve into its slot; false if the upload is not usable
+  bool upload(const EasingUploadPacket& packet) {
+    if (packet.slot >= EASING_SLOTS) return false;
+    easing_value_t* table = tables[packet.slot];
+
+    // The packed packet's points are not 2-byte aligned: work on an aligned copy
+    int16_t points[EASING_CURVE_SAMPLES];
+    memcpy(points, packet.points, sizeof(points));
+
+    if (packet.format == EASING_FORMAT_BEZIER) {
+      float x1 = curveValueToFloat(points[0]);
+      float y1 = curveValueToFloat(points[1]);
+      float x2 = curveValueToFloat(points[2]);
+      float y2 = curveValueToFloat(points[3]);
+      if (x1 < 0.0f || x1 > 1.0f || x2 < 0.0f || x2 > 1.0f) return false;  // x must stay monotonic
+      for (uint16_t k = 0; k <= EASING_TABLE_STEPS; k++) {
+        float s = bezierParameterAt((float)k / EASING_TABLE_STEPS, x1, x2);
+        table[k] = toValue(bezierAt(s, y1, y2));
+      }
+    } else if (packet.format == EASING_FORMAT_SAMPLES) {
+      for (uint16_t k = 0; k <= EASING_TABLE_STEPS; k++) {
+        table[k] = toValue(sampleAt(points, (float)k / EASING_TABLE_STEPS));
+      }
+    } else {
+      return false;
+    }
+
+    loaded[packet.slot] = true;
+    return true;
+  }
+
+  bool isLoaded(uint8_t slot) const { return slot < EASING_SLOTS && loaded[slot]; }
+
+  // Eased value of a custom transition at progress t (clamped to 0..1)
+  easing_value_t evaluate(TransitionType transition, easing_value_t t) const {
+    uint8_t slot = transition - TRANSITION_CUSTOM_1;
+    if (slot >= EASING_SLOTS || !loaded[slot]) return t;
+    const easing_value_t* table = tables[slot];
+  #ifdef USE_FIXED_POINT_MATH
+    if (t <= 0) return table[0];
+    if (t >= Q16_ONE) return table[EASING_TABLE_STEPS];
+    uint32_t position = (uint32_t)t * EASING_TABLE_STEPS;  // Q16 table index
+    uint16_t index = position >> 16;
+    q16_t frac = position & 0xFFFF;
+    return table[index] + fxMul(table[index + 1] - table[index], frac);
+  #else
+    if (t <= 0.0f) return table[0];
+    if (t >= 1.0f) return table[EASING_TABLE_STEPS];
+    float position = t * EASING_TABLE_STEPS;
+    uint16_t index = (uint16_t)position;
+    float frac = position - index;
+    return table[index] + (table[index + 1] - table[index]) * frac;
+  #endif
+  }
+
+private:
+  static easing_value_t toValue(float v) {
+  #ifdef USE_FIXED_POINT_MATH
+    return fxFromFloat(v);
+  #else
+    return v;
+  #endif
+  }
+
+  // One coordinate of the cubic Bezier (0, p1, p2, 1) at parameter s
+  static float bezierAt(float s, float p1, float p2) {
+    float u = 1.0f - s;
+    return 3.0f * u * u * s * p1 + 3.0f * u * s * s * p2 + s * s * s;
+  }
+
+  // Parameter s where the curve's x reaches `x` (x(s) rises monotonically for x1, x2 in 0..1)
+  static float bezierParameterAt(float x, float x1, float x2) {
+    float lo = 0.0f, hi = 1.0f;
+    for (uint8_t i = 0; i < 20; i++) {  // Within 1e-6
+      float mid = 0.5f * (lo + hi);
+      if (bezierAt(mid, x1, x2) < x) lo = mid; else hi = mid;
+    }
+    return 0.5f * (lo + hi);
+  }
+
+  // Catmull-Rom through the uploaded samples (neighbours past the ends extrapolated
+  // linearly, so a curve that starts or ends steeply keeps its slope there)
+  static float sampleAt(const int16_t* samples, float t) {
+    const uint8_t last = EASING_CURVE_SAMPLES - 1;
+    float position = t * last;
+    uint8_t i = (uint8_t)position;
+    if (i >= last) return curveValueToFloat(samples[last]);
+    float s = position - i;
+    float p1 = curveValueToFloat(samples[i]);
+    float p2 = curveValueToFloat(samples[i + 1]);
+    float p0 = (i > 0) ? curveValueToFloat(samples[i - 1]) : 2.0f * p1 - p2;
+    float p3 = (i + 2 <= last) ? curveValueToFloat(samples[i + 2]) : 2.0f * p2 - p1;
+    return p1 + 0.5f * s * (p2 - p0 + s * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3 +
+                                           s * (3.0f * (p1 - p2) + p3 - p0)));
+  }
+
+  easing_value_t tables[EASING_SLOTS][EASING_TABLE_STEPS + 1];
+  bool loaded[EASING_SLOTS] = {false};
+};
+
+#endif // PIXEL_EASING_CURVES_H
@@ -0,0 +1,166 @@
+#ifndef PIXEL_FIXED_MATH_H
+#define PIXEL_FIXED_MATH_H
+
+#include <Arduino.h>
+#include "ESPNowComm.h"
+
+// Fixed-Point Math - trig, easing and angle wrapping without the FPU
+// The ESP32-C3 has no floating point unit, so every sin/cos/pow in the transition
+// and raster paths is a soft-float library call. With USE_FIXED_POINT_MATH defined
+// (set for the pixel_c3 build in platformio.ini) those paths use this layer instead:
+//   - Q16.16 values (65536 == 1.0) for progress and easing
+//   - Angles in 1/256 degree, wrapped with a single modulo
+//   - Sine from a quarter-wave table (1/4 degree steps, linear interpolation)
+// Call fxMathBegin() once in setup() to fill the tables.
+
+typedef int32_t q16_t;
+
+const q16_t Q16_ONE = 65536;
+const q16_t Q16_HALF = 32768;
+
+const int32_t FX_ANGLE_ONE = 256;                       // 1 degree
+const int32_t FX_QUARTER_TURN = 90 * FX_ANGLE_ONE;
+const int32_t FX_FULL_TURN = 360 * FX_ANGLE_ONE;
+
+const uint8_t FX_SIN_STEP_SHIFT = 6;                     // Table step = 64 units = 1/4 degree
+const int16_t FX_SIN_ENTRIES = (FX_QUARTER_TURN >> FX_SIN_STEP_SHIFT) + 1;
+const uint8_t FX_EXP2_ENTRIES = 65;                      // 2^-f for f in [0, 1], 1/64 steps
+
+static q16_t fxSinTable[FX_SIN_ENTRIES];
+static q16_t fxExp2Table[FX_EXP2_ENTRIES];
+
+inline void fxMathBegin() {
+  for (int16_t i = 0; i < FX_SIN_ENTRIES; i++) {
+    float rad = (float)(i << FX_SIN_STEP_SHIFT) / FX_ANGLE_ONE * PI / 180.0f;
+    fxSinTable[i] = (q16_t)lroundf(sinf(rad) * Q16_ONE);
+  }
+  for (uint8_t i = 0; i < FX_EXP2_ENTRIES; i++) {
+    fxExp2Table[i] = (q16_t)lroundf(powf(2.0f, -(float)i / (FX_EXP2_ENTRIES - 1)) * Q16_ONE);
+  }
+}
+
+// ---- Arithmetic ----
+
+inline q16_t fxMul(q16_t a, q16_t b) {
+  return (q16_t)(((int64_t)a * b) >> 16);
+}
+
+inline q16_t fxFromFloat(float v) { return (q16_t)lroundf(v * Q16_ONE); }
+inline float fxToFloat(q16_t v) { return v * (1.0f / Q16_ONE); }
+
+// ---- Angles (1/256 degree) ----
+
+inline int32_t fxAngleFromDegrees(float deg) { return (int32_t)lroundf(deg * FX_ANGLE_ONE); }
+inline float fxAngleToDegrees(int32_t a) { return a * (1.0f / FX_ANGLE_ONE); }
+
+// Wrap to [0, 360) degrees
+inline int32_t fxWrapAngle(int32_t a) {
+  a %= FX_FULL_TURN;
+  return a < 0 ? a + FX_FULL_TURN : a;
+}
+
+// Sine of an angle in [0, 90] degrees, interpolated between table entries
+inline q16_t fxSinQuarter(int32_t a) {
+  int32_t i = a >> FX_SIN_STEP_SHIFT;
+  int32_t frac = a & ((1 << FX_SIN_STEP_SHIFT) - 1);
+  if (i >= FX_SIN_ENTRIES - 1) return fxSinTable[FX_SIN_ENTRIES - 1];
+  q16_t s0 = fxSinTable[i];
+  return s0 + (((fxSinTable[i + 1] - s0) * frac) >> FX_SIN_STEP_SHIFT);
+}
+
+inline q16_t fxSin(int32_t a) {
+  a = fxWrapAngle(a);
+  int32_t quadrant = a / FX_QUARTER_TURN;
+  int32_t r = a - quadrant * FX_QUARTER_TURN;
+  switch (quadrant) {
+    case 0: return fxSinQuarter(r);
+    case 1: return fxSinQuarter(FX_QUARTER_TURN - r);
+    case 2: return -fxSinQuarter(r);
+    default: return -fxSinQuarter(FX_QUARTER_TURN - r);
+  }
+}
+
+inline q16_t fxCos(int32_t a) { return fxSin(a + FX_QUARTER_TURN); }
+
+// 2^-x for x >= 0
+inline q16_t fxExp2Neg(q16_t x) {
+  int32_t whole = x >> 16;
+  if (whole >= 16) return 0;
+  int32_t f = x & 0xFFFF;
+  int32_t i = f >> 10;                 // 64 steps per unit
+  int32_t frac = f & 0x3FF;
+  q16_t v = fxExp2Table[i] + (((fxExp2Table[i + 1] - fxExp2Table[i]) * frac) >> 10);
+  return v >> whole;
+}
+
+// ---- Easing (Q16 in, Q16 out; same curves as the float versions in main.cpp) ----
+
+inline q16_t fxEaseInOut(q16_t t) {
+  if (t < Q16_HALF) return 2 * fxMul(t, t);
+  q16_t u = 2 * Q16_ONE - 2 * t;
+  return Q16_ONE - fxMul(u, u) / 2;
+}
+
+inline q16_t fxEaseElasticOut(q16_t t) {
+  if (t <= 0 || t >= Q16_ONE) return t;
+  // sin((10t - 0.75) * 2pi/3) with the argument in degrees: 1200t - 90
+  int32_t angle = (int32_t)(((int64_t)t * 1200 * FX_ANGLE_ONE) >> 16) - 90 * FX_ANGLE_ONE;
+  return fxMul(fxExp2Neg(10 * t), fxSin(angle)) + Q16_ONE;
+}
+
+inline q16_t fxEaseBounceOut(q16_t t) {
+  const q16_t n1 = 495616;  // 7.5625
+  if (t >= Q16_ONE) return Q16_ONE;  // The truncated constants land 4 short of 1.0
+  if (t < 23831) {          // 1 / 2.75
+    return fxMul(n1, fxMul(t, t));
+  } else if (t < 47663) {   // 2 / 2.75
+    t -= 35747;             // 1.5 / 2.75
+    return fxMul(n1, fxMul(t, t)) + 49152;
+  } else if (t < 59578) {   // 2.5 / 2.75
+    t -= 53620;             // 2.25 / 2.75
+    return fxMul(n1, fxMul(t, t)) + 61440;
+  } else {
+    t -= 62557;             // 2.625 / 2.75
+    return fxMul(n1, fxMul(t, t)) + 64512;
+  }
+}
+
+const q16_t FX_BACK_C1 = 111514;   // 1.70158
+const q16_t FX_BACK_C3 = 177050;   // c1 + 1
+const q16_t FX_BACK_C2 = 170059;   // c1 * 1.525
+
+inline q16_t fxEaseBackIn(q16_t t) {
+  q16_t t2 = fxMul(t, t);
+  return fxMul(FX_BACK_C3, fxMul(t2, t)) - fxMul(FX_BACK_C1, t2);
+}
+
+inline q16_t fxEaseBackOut(q16_t t) {
+  q16_t u = t - Q16_ONE;
+  q16_t u2 = fxMul(u, u);
+  return Q16_ONE + fxMul(FX_BACK_C3, fxMul(u2, u)) + fxMul(FX_BACK_C1, u2);
+}
+
+inline q16_t fxEaseBackInOut(q16_t t) {
+  if (t < Q16_HALF) {
+    q16_t s = 2 * t;
+    return fxMul(fxMul(s, s), fxMul(FX_BACK_C2 + Q16_ONE, s) - FX_BACK_C2) / 2;
+  }
+  q16_t s = 2 * t - 2 * Q16_ONE;
+  return (fxMul(fxMul(s, s), fxMul(FX_BACK_C2 + Q16_ONE, s) + FX_BACK_C2) + 2 * Q16_ONE) / 2;
+}
+
+inline q16_t fxApplyEasing(q16_t t, TransitionType easing) {
+  switch (easing) {
+    case TRANSITION_LINEAR: return t;
+    case TRANSITION_EASE_IN_OUT: return fxEaseInOut(t);
+    case TRANSITION_ELASTIC: return fxEaseElasticOut(t);
+    case TRANSITION_BOUNCE: return fxEaseBounceOut(t);
+    case TRANSITION_BACK_IN: return fxEaseBackIn(t);
+    case TRANSITION_BACK_OUT: return fxEaseBackOut(t);
+    case TRANSITION_BACK_IN_OUT: return fxEaseBackInOut(t);
+    case TRANSITION_INSTANT: return Q16_ONE;
+    default: return t;
+  }
+}
+
+#endif // PIXEL_FIXED_MATH_H
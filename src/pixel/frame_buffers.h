@@ -0,0 +1,263 @@
+#ifndef PIXEL_FRAME_BUFFERS_H
+#define PIXEL_FRAME_BUFFERS_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <esp_heap_caps.h>
+#include "display_bus.h"
+#include "damage.h"
+#include "circle_mask.h"
+#include "panel_canvas.h"
+
+// Frame Buffers - one or two panel-order RGB565 canvases rotated through the display bus
+// With two buffers and an asynchronous (DMA) bus, the next frame renders into the
+// back buffer while the previous one is still streaming out of the front buffer.
+// Each buffer remembers which frame it holds, so partial redraws stay correct even
+// though a buffer is two frames behind when it comes back around.
+//
+// With USE_INDEXED_FRAMEBUFFER the canvases hold 8-bit palette indices instead
+// (half the memory and fill bandwidth). Pixels are expanded to RGB565 through the
+// buffer's (panel-order) palette into short line buffers while pushing.
+
+const uint8_t MAX_FRAME_BUFFERS = 2;
+const int16_t FRAME_BUFFER_MAX_ROWS = 240;
+
+#ifdef USE_INDEXED_FRAMEBUFFER
+typedef uint8_t FramePixel;
+
+const uint16_t FRAME_PALETTE_SIZE = 256;
+const int16_t EXPAND_ROWS = 8;       // Rows per line buffer
+const uint8_t EXPAND_BUFFERS = 4;    // Line buffers in flight on an asynchronous bus
+
+// GFXcanvas8 whose values index a palette of panel-order RGB565 colors
+// Clock frames load the rasterizer's fixed coverage palette with usePalette();
+// screen drawing (text, fills) assigns palette entries to colors as they are used.
+class FrameCanvas : public GFXcanvas8 {
+public:
+  FrameCanvas(uint16_t w, uint16_t h, uint8_t* pixels) : GFXcanvas8(w, h, false) {
+    buffer = pixels;
+    buffer_owned = false;
+  }
+
+  const uint16_t* palette() const { return colors; }
+
+  // Take over a full 256-entry palette (clock frames)
+  void usePalette(const uint16_t* source) {
+    memcpy(colors, source, sizeof(colors));
+    colorCount = FRAME_PALETTE_SIZE;
+  }
+
+  // ---- Adafruit_GFX primitives: map RGB565 colors to palette indices ----
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    GFXcanvas8::drawPixel(x, y, indexOf(color));
+  }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    GFXcanvas8::drawFastHLine(x, y, w, indexOf(color));
+  }
+
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+    GFXcanvas8::drawFastVLine(x, y, h, indexOf(color));
+  }
+
+  // A full-screen fill starts a new screen palette
+  void fillScreen(uint16_t color) override {
+    colorCount = 0;
+    GFXcanvas8::fillScreen(indexOf(color));
+  }
+
+private:
+  // Palette index for a color, adding it if there is room (else the closest match)
+  uint8_t indexOf(uint16_t hostColor) {
+    uint16_t color = toPanelOrder(hostColor);
+    if (lastIndex < colorCount && colors[lastIndex] == color) return lastIndex;
+    for (uint16_t i = 0; i < colorCount; i++) {
+      if (colors[i] == color) return lastIndex = i;
+    }
+    if (colorCount < FRAME_PALETTE_SIZE) {
+      colors[colorCount] = color;
+      return lastIndex = colorCount++;
+    }
+    return lastIndex = closest(color);
+  }
+
+  uint8_t closest(uint16_t color) const {
+    uint8_t best = 0;
+    int32_t bestDist = INT32_MAX;
+    color = fromPanelOrder(color);
+    for (uint16_t i = 0; i < colorCount; i++) {
+      uint16_t c = fromPanelOrder(colors[i]);
+      int32_t dr = ((c >> 11) & 0x1F) - ((color >> 11) & 0x1F);
+      int32_t dg = ((c >> 5) & 0x3F) - ((color >> 5) & 0x3F);
+      int32_t db = (c & 0x1F) - (color & 0x1F);
+      int32_t dist = dr * dr * 4 + dg * dg + db * db * 4;
+      if (dist < bestDist) {
+        bestDist = dist;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  uint16_t colors[FRAME_PALETTE_SIZE];
+  uint16_t colorCount = 0;
+  uint8_t lastIndex = 0;
+};
+#else
+typedef uint16_t FramePixel;
+
+// Panel-order canvas drawing into caller-provided memory (DMA-capable heap)
+class FrameCanvas : public PanelCanvas {
+public:
+  FrameCanvas(uint16_t w, uint16_t h, uint16_t* pixels) : PanelCanvas(w, h, pixels) {}
+};
+#endif
+
+class FrameBuffers {
+public:
+  // Allocate up to `wanted` buffers from heap with the given capabilities
+  // Returns the number allocated (0 means not even one fit)
+  uint8_t begin(uint8_t wanted, int16_t w, int16_t h, uint32_t caps) {
+    width = w;
+    height = min(h, FRAME_BUFFER_MAX_ROWS);
+    count = 0;
+#ifdef USE_INDEXED_FRAMEBUFFER
+    for (uint8_t i = 0; i < EXPAND_BUFFERS; i++) {
+      lines[i] = (uint16_t*)heap_caps_malloc((size_t)w * EXPAND_ROWS * 2, caps);
+      if (!lines[i]) return 0;
+      lineFences[i] = 0;
+    }
+#endif
+    for (uint8_t i = 0; i < wanted && i < MAX_FRAME_BUFFERS; i++) {
+      FramePixel* pixels = (FramePixel*)heap_caps_malloc((size_t)w * h * sizeof(FramePixel), caps);
+      if (!pixels) break;
+      canvases[i] = new FrameCanvas(w, h, pixels);
+      contentsOf[i] = DamageTracker(w, h);
+      fences[i] = 0;
+      count++;
+    }
+    back = 0;
+    return count;
+  }
+
+  uint8_t size() const { return count; }
+
+  // Bytes per framebuffer
+  size_t bufferBytes() const { return (size_t)width * height * sizeof(FramePixel); }
+
+  // Canvas to draw the next frame into (safe to write: its last push is complete)
+  FrameCanvas* canvas() const { return canvases[back]; }
+
+  // What the back buffer currently holds
+  DamageTracker& contents() { return contentsOf[back]; }
+
+  // Index of the back buffer (the one canvas() draws into)
+  uint8_t backIndex() const { return back; }
+
+  // Move on to the next buffer (the caller makes sure it is free before drawing)
+  void advance() { back = (back + 1) % count; }
+
+  // Push the damaged regions of the back buffer and rotate to the next buffer
+  // Returns once the next buffer is no longer being read by the bus
+  void present(DisplayBus& bus, const DamageList& regions, const CircleMask& mask) {
+    push(back, bus, regions, mask);
+    advance();
+    release(back, bus);
+  }
+
+#ifdef USE_INDEXED_FRAMEBUFFER
+  // Expand the damaged regions of buffer `index` through its palette and push them
+  // The indexed buffer itself is never read by the bus, so it is free on return
+  void push(uint8_t index, DisplayBus& bus, const DamageList& regions, const CircleMask& mask) {
+    const uint8_t* pixels = canvases[index]->getBuffer();
+    const uint16_t* palette = canvases[index]->palette();
+    bool fullRows = bus.pushesFullRows();
+
+    for (uint8_t i = 0; i < regions.count; i++) {
+      // A DMA bus pushes whole rows, so expand whole rows for it
+      Rect r = regions.rects[i];
+      if (fullRows) {
+        r.x = 0;
+        r.w = width;
+      }
+
+      for (int16_t y = r.y; y < r.bottom(); y += EXPAND_ROWS) {
+        int16_t rows = min<int16_t>(EXPAND_ROWS, r.bottom() - y);
+        bus.waitFence(lineFences[nextLine]);
+        uint16_t* line = lines[nextLine];
+
+        for (int16_t row = 0; row < rows; row++) {
+          int16_t x = r.x;
+          int16_t w = r.w;
+          if (!mask.clipRow(y + row, x, w)) continue;
+          const uint8_t* src = pixels + (int32_t)(y + row) * width + x;
+          uint16_t* dst = line + (int32_t)row * r.w + (x - r.x);
+          for (int16_t k = 0; k < w; k++) dst[k] = palette[src[k]];
+        }
+
+        bus.pushMaskedWindow(r.x, y, r.w, rows, line, r.w, mask);
+        lineFences[nextLine] = bus.insertFence();
+        nextLine = (nextLine + 1) % EXPAND_BUFFERS;
+      }
+    }
+  }
+
+  // Nothing to wait for: pushes read the line buffers, not the framebuffer
+  void release(uint8_t index, DisplayBus& bus) {}
+#else
+  // Push the damaged regions of buffer `index` and remember the fence that covers them
+  // The canvas is already in panel order, so pixels go straight from the buffer
+  void push(uint8_t index, DisplayBus& bus, const DamageList& regions, const CircleMask& mask) {
+    uint16_t* pixels = canvases[index]->getBuffer();
+
+    if (bus.pushesFullRows()) {
+      // Full-row buses: one band per run of damaged rows, so overlapping
+      // regions do not push the same rows twice
+      uint8_t rows[(FRAME_BUFFER_MAX_ROWS + 7) / 8] = {};
+      for (uint8_t i = 0; i < regions.count; i++) {
+        const Rect& r = regions.rects[i];
+        for (int16_t y = r.y; y < r.bottom(); y++) rows[y >> 3] |= (1 << (y & 7));
+      }
+
+      int16_t y = 0;
+      while (y < height) {
+        if (!(rows[y >> 3] & (1 << (y & 7)))) {
+          y++;
+          continue;
+        }
+        int16_t start = y;
+        while (y < height && (rows[y >> 3] & (1 << (y & 7)))) y++;
+        bus.pushMaskedWindow(0, start, width, y - start, pixels + (int32_t)start * width, width, mask);
+      }
+    } else {
+      for (uint8_t i = 0; i < regions.count; i++) {
+        const Rect& r = regions.rects[i];
+        bus.pushMaskedWindow(r.x, r.y, r.w, r.h, pixels + (int32_t)r.y * width + r.x, width, mask);
+      }
+    }
+    fences[index] = bus.insertFence();
+  }
+
+  // Wait until buffer `index` has left the MCU, so it can be drawn into again
+  void release(uint8_t index, DisplayBus& bus) {
+    bus.waitFence(fences[index]);
+  }
+#endif
+
+private:
+  FrameCanvas* canvases[MAX_FRAME_BUFFERS] = {nullptr, nullptr};
+  DamageTracker contentsOf[MAX_FRAME_BUFFERS];
+  uint32_t fences[MAX_FRAME_BUFFERS] = {0, 0};
+#ifdef USE_INDEXED_FRAMEBUFFER
+  uint16_t* lines[EXPAND_BUFFERS] = {};  // RGB565 line buffers for expansion
+  uint32_t lineFences[EXPAND_BUFFERS] = {};
+  uint8_t nextLine = 0;
+#endif
+  uint8_t count = 0;
+  uint8_t back = 0;
+  int16_t width = 0;
+  int16_t height = 0;
+};
+
+#endif // PIXEL_FRAME_BUFFERS_H
@@ -0,0 +1,155 @@
+#ifndef PIXEL_FRAME_PIPELINE_H
+#define PIXEL_FRAME_PIPELINE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "display_bus.h"
+#include "damage.h"
+#include "circle_mask.h"
+#include "frame_buffers.h"
+#include "stage_profiler.h"
+
+// Frame Pipeline - render on one core, push to the panel on the other
+// loop() updates the transition and rasterizes into the back framebuffer, then
+// submits it. A transfer task pinned to the other core pushes the frame through
+// the display bus and hands the buffer back once its fence is met. Frames travel
+// through a single-producer/single-consumer ring, so neither side takes a lock.
+// On single-core chips (C3) there is no transfer task and submit() pushes inline.
+
+// Jobs in flight never exceed the number of framebuffers
+const uint8_t FRAME_JOB_SLOTS = MAX_FRAME_BUFFERS;
+
+const uint32_t TRANSFER_TASK_STACK = 4096;
+const UBaseType_t TRANSFER_TASK_PRIORITY = 2;  // Above loop() so queued frames go out promptly
+
+// One submitted frame: which buffer, and which regions of it to push
+struct FrameJob {
+  uint8_t buffer;
+  DamageList regions;
+};
+
+// Per-stage time accumulated since the last takeStats() (microseconds)
+struct PipelineStats {
+  uint32_t transferUs;  // Transfer stage busy (pushing and waiting for the bus)
+  uint32_t stallUs;     // Render stage blocked waiting for a free buffer
+  uint32_t frames;      // Frames submitted
+};
+
+class FramePipeline {
+public:
+  FramePipeline(FrameBuffers& frameBuffers, const CircleMask& circleMask)
+    : buffers(frameBuffers), mask(circleMask) {}
+
+  // Start the transfer task on the core loop() is not running on
+  // Returns false on single-core chips or when the task cannot be created;
+  // frames are then pushed inline from submit()
+  bool begin(DisplayBus& displayBus) {
+    bus = &displayBus;
+  #if CONFIG_FREERTOS_UNICORE
+    return false;
+  #else
+    renderTask = xTaskGetCurrentTaskHandle();
+    BaseType_t core = (xPortGetCoreID() == 0) ? 1 : 0;
+    if (xTaskCreatePinnedToCore(transferTaskEntry, "frame_xfer", TRANSFER_TASK_STACK, this,
+                                TRANSFER_TASK_PRIORITY, &transferTask, core) != pdPASS) {
+      transferTask = nullptr;
+      return false;
+    }
+    return true;
+  #endif
+  }
+
+  bool isPipelined() const { return transferTask != nullptr; }
+
+  // Hand the back buffer to the transfer stage, then wait until the next buffer
+  // may be drawn into. With two buffers this overlaps the push of this frame
+  // with the rendering of the next one.
+  void submit(const DamageList& regions) {
+    uint32_t start = micros();
+
+    if (!transferTask) {
+      PROFILE_BEGIN(pushStart);
+      buffers.present(*bus, regions, mask);
+      PROFILE_END(PROFILE_PUSH, pushStart);
+      uint32_t spent = micros() - start;
+      transferUs.fetch_add(spent, std::memory_order_relaxed);
+      stallUs.fetch_add(spent, std::memory_order_relaxed);
+      frames.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    uint8_t index = buffers.backIndex();
+    busy[index].store(true, std::memory_order_relaxed);
+
+    uint32_t head = jobHead.load(std::memory_order_relaxed);
+    FrameJob& job = jobs[head % FRAME_JOB_SLOTS];
+    job.buffer = index;
+    job.regions = regions;
+    jobHead.store(head + 1, std::memory_order_release);
+    xTaskNotifyGive(transferTask);
+
+    buffers.advance();
+    while (busy[buffers.backIndex()].load(std::memory_order_acquire)) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(5));
+    }
+
+    stallUs.fetch_add(micros() - start, std::memory_order_relaxed);
+    frames.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Read and reset the stage timings (for the FPS report)
+  PipelineStats takeStats() {
+    PipelineStats stats;
+    stats.transferUs = transferUs.exchange(0, std::memory_order_relaxed);
+    stats.stallUs = stallUs.exchange(0, std::memory_order_relaxed);
+    stats.frames = frames.exchange(0, std::memory_order_relaxed);
+    return stats;
+  }
+
+private:
+  static void transferTaskEntry(void* ctx) {
+    ((FramePipeline*)ctx)->transferLoop();
+  }
+
+  // Transfer stage: push each submitted frame, wait for its fence, return the buffer
+  void transferLoop() {
+    for (;;) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+      uint32_t tail = jobTail;
+      while (tail != jobHead.load(std::memory_order_acquire)) {
+        const FrameJob& job = jobs[tail % FRAME_JOB_SLOTS];
+        uint8_t index = job.buffer;
+
+        uint32_t start = micros();
+        PROFILE_BEGIN(pushStart);
+        buffers.push(index, *bus, job.regions, mask);
+        buffers.release(index, *bus);
+        PROFILE_END(PROFILE_PUSH, pushStart);
+        transferUs.fetch_add(micros() - start, std::memory_order_relaxed);
+
+        jobTail = ++tail;
+        busy[index].store(false, std::memory_order_release);
+        xTaskNotifyGive(renderTask);
+      }
+    }
+  }
+
+  FrameBuffers& buffers;
+  const CircleMask& mask;
+  DisplayBus* bus = nullptr;
+
+  TaskHandle_t renderTask = nullptr;
+  TaskHandle_t transferTask = nullptr;
+
+  FrameJob jobs[FRAME_JOB_SLOTS];
+  std::atomic<uint32_t> jobHead{0};            // Written by the render stage only
+  uint32_t jobTail = 0;                        // Owned by the transfer stage
+  std::atomic<bool> busy[MAX_FRAME_BUFFERS] = {};  // Buffer handed to the transfer stage
+
+  std::atomic<uint32_t> transferUs{0};
+  std::atomic<uint32_t> stallUs{0};
+  std::atomic<uint32_t> frames{0};
+};
+
+#endif // PIXEL_FRAME_PIPELINE_H
@@ -0,0 +1,88 @@
+#ifndef PIXEL_FRAME_SCHEDULER_H
+#define PIXEL_FRAME_SCHEDULER_H
+
+#include <Arduino.h>
+
+// Frame Scheduler - render only when something on screen changed
+// Between transitions the clock image is static (the master holds each digit for
+// seconds), and the mode screens never change on their own. Instead of redrawing
+// an identical frame every loop, loop() asks the scheduler whether the screen it
+// is about to show differs from the one on the panel:
+//   - a different screen kind, or different content for it (state, pixel ID)
+//   - a running transition (the clock animates)
+//   - an explicit invalidate() after something else drew over the panel
+// When nothing changed the frame is skipped and loop() sleeps in idle() until a
+// packet arrives (wake()) or the next deadline passes.
+
+// What the panel is showing
+enum ScreenKind : uint8_t {
+  SCREEN_NONE = 0,        // Unknown (boot, or drawn over by something else)
+  SCREEN_CLOCK,
+  SCREEN_UNPROVISIONED,
+  SCREEN_VERSION,
+  SCREEN_HIGHLIGHT,
+  SCREEN_ERROR,
+};
+
+// Longest idle sleep, so loop() housekeeping still runs without packets
+const uint32_t SCHEDULER_MAX_IDLE_MS = 1000;
+
+class FrameScheduler {
+public:
+  // Create the wake-up semaphore; call once in setup() before packets arrive
+  void begin() {
+    wakeSignal = xSemaphoreCreateBinary();
+  }
+
+  // Should this screen be drawn? True if it differs from what the panel shows.
+  // `content` identifies the screen's variable content (0 if it has none);
+  // `animating` forces a redraw every frame (running clock transition).
+  bool needsFrame(ScreenKind kind, uint32_t content = 0, bool animating = false) {
+    bool changed = invalidated || animating || kind != shownKind || content != shownContent;
+    invalidated = false;
+    shownKind = kind;
+    shownContent = content;
+    if (changed) {
+      rendered++;
+    } else {
+      skipped++;
+    }
+    return changed;
+  }
+
+  // Forget what the panel shows, so the next screen is drawn in full
+  void invalidate() { invalidated = true; }
+
+  // Sleep until wake() or for at most `maxWaitMs`
+  void idle(uint32_t maxWaitMs) {
+    maxWaitMs = min(maxWaitMs, SCHEDULER_MAX_IDLE_MS);
+    if (maxWaitMs == 0) return;
+    if (wakeSignal) {
+      xSemaphoreTake(wakeSignal, pdMS_TO_TICKS(maxWaitMs));
+    } else {
+      delay(maxWaitMs);
+    }
+  }
+
+  // Cut an idle() short (called from the ESP-NOW receive callback)
+  void wake() {
+    if (wakeSignal) xSemaphoreGive(wakeSignal);
+  }
+
+  // Frames rendered and skipped since the last resetStats() (for the FPS report)
+  uint32_t rendered = 0;
+  uint32_t skipped = 0;
+
+  void resetStats() {
+    rendered = 0;
+    skipped = 0;
+  }
+
+private:
+  SemaphoreHandle_t wakeSignal = nullptr;
+  volatile bool invalidated = true;
+  ScreenKind shownKind = SCREEN_NONE;
+  uint32_t shownContent = 0;
+};
+
+#endif // PIXEL_FRAME_SCHEDULER_H
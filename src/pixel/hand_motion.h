@@ -0,0 +1,335 @@
+#ifndef PIXEL_HAND_MOTION_H
+#define PIXEL_HAND_MOTION_H
+
+#include <Arduino.h>
+#include "ESPNowComm.h"
+#include "easing.h"
+#include "fixed_math.h"
+#include "spring_motion.h"
+#include "easing_curves.h"
+#include "spin_motion.h"
+#include "hand_path.h"
+
+// Hand Motion - per-hand transition state and the per-frame angle update
+// Structure of arrays: each field holds all three hands, so the per-frame update
+// is one tight loop over contiguous arrays. Every hand has its own easing,
+// duration and start time (staggered motion within a pixel). What stays fixed for
+// a transition - the hand's path (extra turns, waypoint: see hand_path.h), the
+// fixed-point start angle and the progress scale - is worked out once in
+// startHands(); a frame only eases each hand's progress and scales the distance
+// along its path. When all hands share start time, duration and
+// easing (any command without per-hand timing), progress and easing are computed
+// once per frame instead of once per hand. TRANSITION_SPRING hands are driven by
+// their spring state instead of a curve (see spring_motion.h); spinning hands
+// (CMD_SPIN_HANDS) by their phase and velocity, and ignore targets until stopped.
+
+// One movement of all hands, as startHands() takes it
+struct HandMotion {
+  float targets[HANDS_PER_PIXEL];            // Degrees
+  int8_t dirs[HANDS_PER_PIXEL];              // 1 for CW, -1 for CCW (to the waypoint, if any)
+  uint8_t turns[HANDS_PER_PIXEL];            // Extra whole turns on the way
+  uint8_t waypointMask;                      // Bit i: hand i goes via waypoints[i]
+  float waypoints[HANDS_PER_PIXEL];          // Degrees
+  int8_t waypointDirs[HANDS_PER_PIXEL];      // From the waypoint to the target
+  TransitionType easings[HANDS_PER_PIXEL];
+  uint32_t durationsMs[HANDS_PER_PIXEL];     // Ignored by spring hands, which run until settled
+  float springFrequencyHz;                   // Spring of TRANSITION_SPRING hands
+  float springDampingRatio;
+};
+
+struct HandStates {
+  float currentAngle[HANDS_PER_PIXEL];
+  float targetAngle[HANDS_PER_PIXEL];
+  float startAngle[HANDS_PER_PIXEL];
+  int8_t direction[HANDS_PER_PIXEL];       // 1 for CW, -1 for CCW (to the waypoint, if any)
+  int8_t directionAfter[HANDS_PER_PIXEL];  // From the waypoint on (same as direction without one)
+  TransitionType easing[HANDS_PER_PIXEL];
+  uint32_t startTime[HANDS_PER_PIXEL];     // millis() the hand starts moving
+  uint32_t durationMs[HANDS_PER_PIXEL];
+#ifdef USE_FIXED_POINT_MATH
+  int32_t startFx[HANDS_PER_PIXEL];        // Start angle (1/256 degree)
+  int32_t legFx[HANDS_PER_PIXEL];          // Path length to the waypoint (1/256 degree)
+  int32_t travelFx[HANDS_PER_PIXEL];       // Path length to the target (1/256 degree)
+  uint32_t progressScale[HANDS_PER_PIXEL]; // 2^32 / durationMs: progress by multiply, not divide
+#else
+  float leg[HANDS_PER_PIXEL];              // Path length to the waypoint (degrees)
+  float travel[HANDS_PER_PIXEL];           // Path length to the target (degrees)
+  float progressScale[HANDS_PER_PIXEL];    // 1 / durationMs
+#endif
+  spring_t springPosition[HANDS_PER_PIXEL];  // Travelled along the path (the target is the travel)
+  spring_t springVelocity[HANDS_PER_PIXEL];  // Along the path; kept when a spring hand is retargeted
+  spring_t springStiffness[HANDS_PER_PIXEL];
+  spring_t springDamping[HANDS_PER_PIXEL];
+  uint32_t springSteps[HANDS_PER_PIXEL];     // Steps integrated since startTime
+  spin_angle_t spinPhase[HANDS_PER_PIXEL];   // Spinning hands: angle at startTime
+  int64_t spinVelocity[HANDS_PER_PIXEL];     // Q32.32 turn units per ms (durationMs: stop after, 0 = never)
+  uint8_t spinMask;                        // Bit i: hand i spinning
+  uint8_t activeMask;                      // Bit i: hand i still moving
+  bool sharedTiming;                       // Every hand has the same start, duration and (curve) easing
+};
+
+const uint8_t ALL_HANDS_MASK = (1 << HANDS_PER_PIXEL) - 1;
+
+// Rotation direction for startHands()
+// DIR_SHORTEST (0) = choose shortest path based on angle difference
+// DIR_CW (1) = clockwise (1)
+// DIR_CCW (2) = counter-clockwise (-1)
+inline int8_t resolveDirection(RotationDirection dir, float target, float current) {
+  if (dir == DIR_SHORTEST) {
+    float diff = target - current;
+    while (diff > 180.0) diff -= 360.0;
+    while (diff < -180.0) diff += 360.0;
+    return (diff >= 0) ? 1 : -1;
+  }
+  return (dir == DIR_CW) ? 1 : -1;
+}
+
+// Wrap an angle into 0-360 degrees
+inline float wrapDegrees(float angle) {
+  while (angle < 0) angle += 360.0;
+  while (angle >= 360.0) angle -= 360.0;
+  return angle;
+}
+
+#ifdef USE_FIXED_POINT_MATH
+// Eased progress of hand i `elapsedMs` into its transition (before its end), Q16
+// Uploaded easings (TRANSITION_CUSTOM_1..4) come from `curves`
+inline q16_t handEasedProgress(const HandStates& hands, uint8_t i, uint32_t elapsedMs, const EasingCurves& curves) {
+  q16_t t = (q16_t)(((uint64_t)elapsedMs * hands.progressScale[i]) >> 16);
+  return isCustomTransition(hands.easing[i]) ? curves.evaluate(hands.easing[i], t)
+                                             : fxApplyEasing(t, hands.easing[i]);
+}
+
+// Wrap a hand angle (1/256 degree) into [0, 360): within a turn of that range
+// (any path without extra turns) one add or subtract replaces fxWrapAngle's divide
+inline int32_t wrapHandAngleFx(int32_t a) {
+  if (a >= FX_FULL_TURN) a -= FX_FULL_TURN;
+  else if (a < 0) a += FX_FULL_TURN;
+  return ((uint32_t)a < (uint32_t)FX_FULL_TURN) ? a : fxWrapAngle(a);
+}
+
+// Angle of hand i `travelledFx` along its path
+inline float handPathAngle(const HandStates& hands, uint8_t i, int32_t travelledFx) {
+  return fxAngleToDegrees(wrapHandAngleFx(fxPathAngle(hands.startFx[i], hands.direction[i], hands.directionAfter[i],
+                                                      hands.legFx[i], travelledFx)));
+}
+
+// Angle of hand i at eased progress easedT
+inline float handAngleAt(const HandStates& hands, uint8_t i, q16_t easedT) {
+  return handPathAngle(hands, i, fxMul(hands.travelFx[i], easedT));
+}
+
+// Spring target of hand i: the end of its path, in Q16 degrees
+inline spring_t springTargetOf(const HandStates& hands, uint8_t i) {
+  return hands.travelFx[i] * (Q16_ONE / FX_ANGLE_ONE);
+}
+
+// Angle of spring hand i at its current spring position
+inline float springAngleAt(const HandStates& hands, uint8_t i) {
+  return handPathAngle(hands, i, hands.springPosition[i] / (Q16_ONE / FX_ANGLE_ONE));
+}
+
+// Direction spring hand i is heading along its path (1 CW, -1 CCW)
+inline int8_t springHeading(const HandStates& hands, uint8_t i) {
+  return hands.springPosition[i] < hands.legFx[i] * (Q16_ONE / FX_ANGLE_ONE) ? hands.direction[i]
+                                                                               : hands.directionAfter[i];
+}
+#else
+// Eased progress of hand i `elapsedMs` into its transition (before its end)
+// Uploaded easings (TRANSITION_CUSTOM_1..4) come from `curves`
+inline float handEasedProgress(const HandStates& hands, uint8_t i, uint32_t elapsedMs, const EasingCurves& curves) {
+  float t = elapsedMs * hands.progressScale[i];
+  return isCustomTransition(hands.easing[i]) ? curves.evaluate(hands.easing[i], t)
+                                             : applyEasing(t, hands.easing[i]);
+}
+
+// Angle of hand i `travelled` degrees along its path, kept in 0-360 range
+inline float handPathAngle(const HandStates& hands, uint8_t i, float travelled) {
+  return wrapDegrees(pathAngle(hands.startAngle[i], hands.direction[i], hands.directionAfter[i],
+                               hands.leg[i], travelled));
+}
+
+// Angle of hand i at eased progress easedT
+inline float handAngleAt(const HandStates& hands, uint8_t i, float easedT) {
+  return handPathAngle(hands, i, hands.travel[i] * easedT);
+}
+
+// Spring target of hand i: the end of its path
+inline spring_t springTargetOf(const HandStates& hands, uint8_t i) {
+  return hands.travel[i];
+}
+
+// Angle of spring hand i at its current spring position
+inline float springAngleAt(const HandStates& hands, uint8_t i) {
+  return handPathAngle(hands, i, hands.springPosition[i]);
+}
+
+// Direction spring hand i is heading along its path (1 CW, -1 CCW)
+inline int8_t springHeading(const HandStates& hands, uint8_t i) {
+  return hands.springPosition[i] < hands.leg[i] ? hands.direction[i] : hands.directionAfter[i];
+}
+#endif
+
+// Integrate spring hand i up to `now` in fixed steps from its start
+// True once it has settled on its target (or is too far behind to catch up)
+inline bool advanceSpring(HandStates& hands, uint8_t i, uint32_t now) {
+  int32_t elapsedMs = (int32_t)(now - hands.startTime[i]);
+  if (elapsedMs < 0) return false;  // Not started yet
+  uint32_t due = (uint32_t)elapsedMs / SPRING_STEP_MS;
+  if (due > hands.springSteps[i] + SPRING_MAX_STEPS_PER_UPDATE) return true;
+
+  spring_t target = springTargetOf(hands, i);
+  for (; hands.springSteps[i] < due; hands.springSteps[i]++) {
+    springStep(hands.springPosition[i], hands.springVelocity[i], target,
+               hands.springStiffness[i], hands.springDamping[i]);
+  }
+  return springSettled(hands.springPosition[i], hands.springVelocity[i], target);
+}
+
+// Angle of spinning hand i at `now` into currentAngle; true once its stop time has passed
+inline bool advanceSpin(HandStates& hands, uint8_t i, uint32_t now) {
+  int32_t elapsedMs = (int32_t)(now - hands.startTime[i]);
+  if (elapsedMs < 0) elapsedMs = 0;
+  uint32_t stopAfterMs = hands.durationMs[i];
+  bool stopped = stopAfterMs != 0 && (uint32_t)elapsedMs >= stopAfterMs;
+  if (stopped) {
+    elapsedMs = stopAfterMs;
+  } else if (stopAfterMs == 0 && (uint32_t)elapsedMs >= SPIN_REBASE_MS) {
+    // Move the start up so the elapsed time never wraps
+    hands.spinPhase[i] = spinAngleAt(hands.spinPhase[i], hands.spinVelocity[i], elapsedMs);
+    hands.startTime[i] = now;
+    elapsedMs = 0;
+  }
+  spin_angle_t angle = spinAngleAt(hands.spinPhase[i], hands.spinVelocity[i], elapsedMs);
+  hands.currentAngle[i] = wrapDegrees(spinAngleToDegrees(angle));
+  return stopped;
+}
+
+// Spin hand i at a constant velocity from startTime, starting at `phase`
+// (fromPhase) or where the hand is then; stopAfterMs 0 = until stopped
+inline void startSpin(HandStates& hands, uint8_t i, int32_t arcsecPerSecond, bool fromPhase, spin_angle_t phase,
+                      uint32_t startTime, uint32_t stopAfterMs) {
+  if (!fromPhase) {
+    if (hands.spinMask & (1 << i)) advanceSpin(hands, i, startTime);  // Change speed without a jump
+    phase = spinAngleFromDegrees(hands.currentAngle[i]);
+  }
+  hands.spinPhase[i] = phase;
+  hands.spinVelocity[i] = spinVelocityFromArcsec(arcsecPerSecond);
+  hands.startTime[i] = startTime;
+  hands.durationMs[i] = stopAfterMs;
+  hands.spinMask |= (1 << i);
+  hands.activeMask |= (1 << i);
+  hands.sharedTiming = false;
+}
+
+// Stop spinning hand i where it is (it rests there until the next movement)
+inline void stopSpin(HandStates& hands, uint8_t i) {
+  hands.targetAngle[i] = hands.currentAngle[i];
+  hands.spinMask &= ~(1 << i);
+  hands.activeMask &= ~(1 << i);
+}
+
+// Start every hand moving from its current angle; spinning hands carry on until stopped
+// A spring hand still moving that gets a spring movement carries its velocity
+// into the new target
+inline void startHands(HandStates& hands, const HandMotion& motion, uint32_t startTime) {
+  hands.sharedTiming = motion.easings[0] != TRANSITION_SPRING && hands.spinMask == 0;
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    if (hands.spinMask & (1 << i)) continue;
+
+    // Bring a moving spring hand up to startTime and start from where it is then
+    spring_t velocity = 0;  // Clockwise
+    bool wasSpring = (hands.activeMask & (1 << i)) && hands.easing[i] == TRANSITION_SPRING;
+    if (wasSpring && motion.easings[i] == TRANSITION_SPRING) {
+      advanceSpring(hands, i, startTime);
+      hands.currentAngle[i] = springAngleAt(hands, i);
+      velocity = hands.springVelocity[i] * springHeading(hands, i);
+    }
+
+    // Normalize current angle to 0-360 range before starting new transition
+    hands.currentAngle[i] = wrapDegrees(hands.currentAngle[i]);
+    hands.startAngle[i] = hands.currentAngle[i];
+    hands.targetAngle[i] = motion.targets[i];
+    hands.easing[i] = motion.easings[i];
+    hands.startTime[i] = startTime;
+    hands.durationMs[i] = motion.durationsMs[i];
+    if (motion.easings[i] != motion.easings[0] || motion.durationsMs[i] != motion.durationsMs[0]) {
+      hands.sharedTiming = false;
+    }
+
+    // Path and progress scale are fixed for the whole transition: work them out once
+    // (a hand already on its target with no extra turns makes a full turn)
+    bool viaWaypoint = motion.waypointMask & (1 << i);
+    HandPath path = HandPath::plan(hands.startAngle[i], motion.targets[i], motion.dirs[i], motion.turns[i],
+                                   viaWaypoint, motion.waypoints[i], motion.waypointDirs[i]);
+    hands.direction[i] = motion.dirs[i];
+    hands.directionAfter[i] = viaWaypoint ? motion.waypointDirs[i] : motion.dirs[i];
+#ifdef USE_FIXED_POINT_MATH
+    hands.startFx[i] = fxAngleFromDegrees(hands.startAngle[i]);
+    hands.legFx[i] = fxAngleFromDegrees(path.leg);
+    hands.travelFx[i] = fxAngleFromDegrees(path.travel);
+    hands.progressScale[i] = motion.durationsMs[i] ? (uint32_t)(UINT32_MAX / motion.durationsMs[i]) : 0;
+#else
+    hands.leg[i] = path.leg;
+    hands.travel[i] = path.travel;
+    hands.progressScale[i] = motion.durationsMs[i] ? 1.0f / motion.durationsMs[i] : 0.0f;
+#endif
+
+    if (motion.easings[i] == TRANSITION_SPRING) {
+      // Slower for long paths: frequency x travel is capped (see spring_motion.h)
+      SpringCoefficients spring = SpringCoefficients::of(motion.springFrequencyHz, motion.springDampingRatio,
+                                                         path.travel);
+      hands.springPosition[i] = 0;
+      hands.springVelocity[i] = velocity * motion.dirs[i];
+      hands.springStiffness[i] = spring.stiffness;
+      hands.springDamping[i] = spring.damping;
+      hands.springSteps[i] = 0;
+    }
+  }
+  hands.activeMask = ALL_HANDS_MASK;
+}
+
+// Advance every moving hand to `now`; hands that reach the end of their span
+// (spring hands: that settle) land exactly on their targets (normalized to 0-360)
+inline void updateHands(HandStates& hands, const EasingCurves& curves, uint32_t now) {
+  if (hands.sharedTiming && hands.activeMask == ALL_HANDS_MASK) {
+    // One progress and one easing for all three hands
+    int32_t elapsedMs = (int32_t)(now - hands.startTime[0]);
+    if (elapsedMs < 0) return;  // Not started yet
+    if ((uint32_t)elapsedMs >= hands.durationMs[0]) {
+      for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) hands.currentAngle[i] = wrapDegrees(hands.targetAngle[i]);
+      hands.activeMask = 0;
+      return;
+    }
+    auto easedT = handEasedProgress(hands, 0, elapsedMs, curves);
+    for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) hands.currentAngle[i] = handAngleAt(hands, i, easedT);
+    return;
+  }
+
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    if (!(hands.activeMask & (1 << i))) continue;
+    if (hands.spinMask & (1 << i)) {
+      if (advanceSpin(hands, i, now)) stopSpin(hands, i);
+      continue;
+    }
+    if (hands.easing[i] == TRANSITION_SPRING) {
+      if (advanceSpring(hands, i, now)) {
+        hands.currentAngle[i] = wrapDegrees(hands.targetAngle[i]);
+        hands.activeMask &= ~(1 << i);
+      } else {
+        hands.currentAngle[i] = springAngleAt(hands, i);
+      }
+      continue;
+    }
+    int32_t elapsedMs = (int32_t)(now - hands.startTime[i]);
+    if (elapsedMs < 0) continue;  // Not started yet
+    if ((uint32_t)elapsedMs >= hands.durationMs[i]) {
+      hands.currentAngle[i] = wrapDegrees(hands.targetAngle[i]);
+      hands.activeMask &= ~(1 << i);
+    } else {
+      hands.currentAngle[i] = handAngleAt(hands, i, handEasedProgress(hands, i, elapsedMs, curves));
+    }
+  }
+}
+
+#endif // PIXEL_HAND_MOTION_H
@@ -0,0 +1,64 @@
+#ifndef PIXEL_HAND_PATH_H
+#define PIXEL_HAND_PATH_H
+
+#include <Arduino.h>
+#include "fixed_math.h"
+
+// Hand Path - the route a hand takes through one transition
+// A transition eases a single distance travelled along the path, so extra turns
+// and a waypoint cost nothing per frame beyond one compare: the hand goes `leg`
+// degrees in its direction (to the waypoint, with its extra turns), then the
+// rest of `travel` in the direction after the waypoint. Without a waypoint the
+// leg is the whole travel and both directions are the same. Easings that
+// overshoot (back, elastic) carry on past the ends of the path in the direction
+// of that end.
+//
+// A hand whose path comes out empty (target already reached, no extra turns)
+// makes one full turn, so a repeated command still shows movement.
+
+// Distance from `from` to `to` going in `dir` (1 CW, -1 CCW), 0-360 degrees
+// Angles within 0.1 degree count as the same
+inline float pathArc(float from, float to, int8_t dir) {
+  float arc = dir > 0 ? to - from : from - to;
+  while (arc < 0) arc += 360.0f;
+  while (arc >= 360.0f) arc -= 360.0f;
+  return (arc < 0.1f || arc > 359.9f) ? 0.0f : arc;
+}
+
+struct HandPath {
+  float leg;     // Degrees to the waypoint (the whole travel without one)
+  float travel;  // Degrees in total
+
+  // Path from `start` to `target` in `dir` with `turns` extra whole turns,
+  // through `waypoint` (then on in `dirAfter`) when viaWaypoint
+  static HandPath plan(float start, float target, int8_t dir, uint8_t turns,
+                       bool viaWaypoint, float waypoint, int8_t dirAfter) {
+    HandPath path;
+    if (viaWaypoint) {
+      path.leg = pathArc(start, waypoint, dir) + 360.0f * turns;
+      path.travel = path.leg + pathArc(waypoint, target, dirAfter);
+    } else {
+      path.leg = pathArc(start, target, dir) + 360.0f * turns;
+      path.travel = path.leg;
+    }
+    if (path.travel == 0.0f) {
+      path.leg = 360.0f;
+      path.travel = 360.0f;
+    }
+    return path;
+  }
+};
+
+// Angle (unwrapped) `travelled` degrees along a path
+inline float pathAngle(float start, int8_t dir, int8_t dirAfter, float leg, float travelled) {
+  float toWaypoint = min(travelled, leg);
+  return start + dir * toWaypoint + dirAfter * (travelled - toWaypoint);
+}
+
+// Same in 1/256 degree
+inline int32_t fxPathAngle(int32_t startFx, int8_t dir, int8_t dirAfter, int32_t legFx, int32_t travelledFx) {
+  int32_t toWaypoint = min(travelledFx, legFx);
+  return startFx + dir * toWaypoint + dirAfter * (travelledFx - toWaypoint);
+}
+
+#endif // PIXEL_HAND_PATH_H
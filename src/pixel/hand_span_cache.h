@@ -0,0 +1,223 @@
+#ifndef PIXEL_HAND_SPAN_CACHE_H
+#define PIXEL_HAND_SPAN_CACHE_H
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "capsule.h"
+
+// Hand Span Cache - pre-rasterized hand coverage per quantized angle
+// The hands only ever have a few shapes (length and thickness) and rotate about
+// the center, so their coverage depends on nothing but shape and angle. Angles
+// are snapped to HAND_SPAN_ANGLE_STEPS steps per turn; the coverage of each
+// (shape, step) is rasterized once with coverCapsuleRow() and stored as one
+// record per row: the covered span, its fully covered core, and the coverage of
+// the anti-aliased pixels on either side of the core. Drawing a hand is then a
+// row lookup, a memset for the core and a few byte copies - no square roots.
+//
+// Hands at a and at 180 - a, 180 + a, 360 - a are mirror images about the center
+// pixel, so only angles in [0, 90] degrees are stored and mirrored on lookup.
+// Records are built lazily into a pool; when the pool is full, lookups fail and
+// the caller rasterizes that hand live.
+
+const uint16_t HAND_SPAN_ANGLE_STEPS = 1024;                      // Per full turn
+const uint16_t HAND_SPAN_QUARTER_STEPS = HAND_SPAN_ANGLE_STEPS / 4;
+const uint8_t HAND_SPAN_MAX_SHAPES = 2;
+const int16_t HAND_SPAN_REACH = 128;  // Largest |dx| or |dy| a hand reaches from the center
+
+// One row of a cached hand, relative to the center pixel
+struct HandSpanRow {
+  int8_t dx;           // First covered pixel
+  uint8_t leftEdge;    // Partially covered pixels before the core
+  uint8_t core;        // Fully covered pixels
+  uint8_t rightEdge;   // Partially covered pixels after the core
+  uint16_t edgeOffset; // Edge coverage bytes (left then right) in the record's edge area
+};
+
+// Record header; followed by `rows` HandSpanRows and then the edge coverage bytes
+struct HandSpans {
+  int16_t dyMin;       // Row of the first record row, relative to the center
+  uint16_t rows;
+};
+
+// A cached hand ready to draw: canonical record plus the mirroring that maps it
+struct HandSpanRef {
+  const HandSpans* spans;  // nullptr: not cached, rasterize live
+  bool mirrorX;
+  bool mirrorY;
+};
+
+class HandSpanCache {
+public:
+  // Set up the cache for hands rotating about (cx, cy) with a pool of poolBytes
+  // from heap with the given capabilities; returns false if it cannot be allocated
+  bool begin(int16_t centerX, int16_t centerY, uint32_t poolBytes, uint32_t caps) {
+    cx = centerX;
+    cy = centerY;
+    pool = (uint8_t*)heap_caps_malloc(poolBytes, caps);
+    if (!pool) return false;
+    poolSize = poolBytes;
+    poolUsed = 0;
+    memset(records, 0, sizeof(records));
+    return true;
+  }
+
+  bool isReady() const { return pool != nullptr; }
+
+  // Register a hand shape; returns its id (or 0xFF when all slots are taken)
+  uint8_t addShape(float length, float thickness) {
+    if (shapeCount >= HAND_SPAN_MAX_SHAPES) return 0xFF;
+    lengths[shapeCount] = length;
+    thicknesses[shapeCount] = thickness;
+    return shapeCount++;
+  }
+
+  // Nearest angle step (0..HAND_SPAN_ANGLE_STEPS-1) for an angle in degrees
+  static uint16_t angleStep(float angleDeg) {
+    int32_t step = lroundf(angleDeg * (HAND_SPAN_ANGLE_STEPS / 360.0f));
+    return (uint16_t)(step & (HAND_SPAN_ANGLE_STEPS - 1));
+  }
+
+  // Angle in degrees of a step (where a cached hand is actually drawn)
+  static float stepAngle(uint16_t step) {
+    return step * (360.0f / HAND_SPAN_ANGLE_STEPS);
+  }
+
+  // Cached coverage of `shape` at `step`, building it on first use
+  HandSpanRef lookup(uint8_t shape, uint16_t step) {
+    step &= HAND_SPAN_ANGLE_STEPS - 1;
+    uint8_t quadrant = step / HAND_SPAN_QUARTER_STEPS;
+    uint16_t r = step % HAND_SPAN_QUARTER_STEPS;
+
+    // Quadrants 1 and 3 run backwards through the canonical [0, 90] degree range
+    uint16_t canonical = (quadrant & 1) ? HAND_SPAN_QUARTER_STEPS - r : r;
+    HandSpanRef ref = {nullptr, quadrant >= 2, quadrant == 1 || quadrant == 2};
+    if (shape >= shapeCount || !pool) return ref;
+
+    uint32_t& offset = records[shape][canonical];
+    if (offset == 0 && !build(shape, canonical, offset)) return ref;
+    ref.spans = (const HandSpans*)(pool + offset - 1);
+    return ref;
+  }
+
+  // Accumulate a cached hand's coverage on row y into cov[x0, x1)
+  // Same values as coverCapsuleRow() on the hand's capsule; false if the row is not touched
+  bool coverRow(const HandSpanRef& ref, int16_t y, int16_t x0, int16_t x1, uint8_t* cov) const {
+    const HandSpans* spans = ref.spans;
+    int16_t dy = ref.mirrorY ? cy - y : y - cy;
+    int16_t i = dy - spans->dyMin;
+    if (i < 0 || i >= spans->rows) return false;
+
+    const HandSpanRow& row = ((const HandSpanRow*)(spans + 1))[i];
+    if (row.leftEdge + row.core + row.rightEdge == 0) return false;
+    const uint8_t* edges = (const uint8_t*)((const HandSpanRow*)(spans + 1) + spans->rows) + row.edgeOffset;
+
+    // Screen x of canonical pixel k is cx + dx + k, or cx - dx - k when mirrored
+    int16_t n = row.leftEdge + row.core + row.rightEdge;
+    int16_t spanX0 = ref.mirrorX ? cx - row.dx - n + 1 : cx + row.dx;
+    if (spanX0 >= x1 || spanX0 + n <= x0) return true;
+
+    // Edges: left and right in canonical order, swapped when mirrored
+    const uint8_t* leftCov = edges;
+    const uint8_t* rightCov = edges + row.leftEdge;
+    int16_t coreX = spanX0 + (ref.mirrorX ? row.rightEdge : row.leftEdge);
+    if (ref.mirrorX) {
+      addEdge(cov, spanX0, rightCov, row.rightEdge, true, x0, x1);
+      addEdge(cov, coreX + row.core, leftCov, row.leftEdge, true, x0, x1);
+    } else {
+      addEdge(cov, spanX0, leftCov, row.leftEdge, false, x0, x1);
+      addEdge(cov, coreX + row.core, rightCov, row.rightEdge, false, x0, x1);
+    }
+
+    int16_t c0 = max(coreX, x0);
+    int16_t c1 = min<int16_t>(coreX + row.core, x1);
+    if (c1 > c0) memset(cov + c0, COVERAGE_FULL, c1 - c0);
+    return true;
+  }
+
+  // Pool bytes used by the records built so far
+  uint32_t bytesUsed() const { return poolUsed; }
+
+private:
+  // Max-combine `count` edge coverage bytes into cov starting at screen x, clipped
+  // to [x0, x1); reversed walks the bytes backwards (mirrored hands)
+  static void addEdge(uint8_t* cov, int16_t x, const uint8_t* values, uint8_t count,
+                      bool reversed, int16_t x0, int16_t x1) {
+    int16_t k0 = max<int16_t>(0, x0 - x);
+    int16_t k1 = min<int16_t>(count, x1 - x);
+    for (int16_t k = k0; k < k1; k++) {
+      uint8_t v = reversed ? values[count - 1 - k] : values[k];
+      if (v > cov[x + k]) cov[x + k] = v;
+    }
+  }
+
+  // Rasterize the canonical record for (shape, canonical step) into the pool
+  // offset is set to the record's pool offset + 1 (0 means not built)
+  bool build(uint8_t shape, uint16_t canonical, uint32_t& offset) {
+    Capsule c = handCapsule(cx, cy, stepAngle(canonical), lengths[shape], thicknesses[shape]);
+    int16_t reach = (int16_t)ceil(c.radius + 1);
+    int16_t dyMin = (int16_t)floor(min(c.ay, c.by)) - reach - cy;
+    int16_t dyMax = (int16_t)ceil(max(c.ay, c.by)) + reach - cy;
+    uint16_t rows = dyMax - dyMin + 1;
+
+    uint32_t rowBytes = (uint32_t)rows * sizeof(HandSpanRow);
+    uint32_t at = (poolUsed + 3) & ~3u;
+    if (at + sizeof(HandSpans) + rowBytes > poolSize) return false;
+
+    HandSpans* spans = (HandSpans*)(pool + at);
+    HandSpanRow* rowOut = (HandSpanRow*)(spans + 1);
+    uint8_t* edgeOut = (uint8_t*)(rowOut + rows);
+    uint32_t edgeLimit = poolSize - (at + sizeof(HandSpans) + rowBytes);
+    uint32_t edgeUsed = 0;
+
+    uint8_t cov[2 * HAND_SPAN_REACH];
+    int16_t xBase = cx - HAND_SPAN_REACH;
+    for (uint16_t i = 0; i < rows; i++) {
+      memset(cov, 0, sizeof(cov));
+      HandSpanRow& out = rowOut[i];
+      out = {0, 0, 0, 0, (uint16_t)edgeUsed};
+      if (!coverCapsuleRow(c, cy + dyMin + i, xBase, xBase + 2 * HAND_SPAN_REACH, cov - xBase)) continue;
+
+      // Coverage along a row of a convex shape rises, plateaus, then falls:
+      // left edge, a run of full coverage, right edge
+      int16_t first = 0;
+      while (first < 2 * HAND_SPAN_REACH && cov[first] == 0) first++;
+      if (first == 2 * HAND_SPAN_REACH) continue;
+      int16_t last = 2 * HAND_SPAN_REACH - 1;
+      while (cov[last] == 0) last--;
+      int16_t core0 = first;
+      while (core0 <= last && cov[core0] != COVERAGE_FULL) core0++;
+      int16_t core1 = core0;
+      while (core1 <= last && cov[core1] == COVERAGE_FULL) core1++;
+
+      uint16_t edgeCount = (core0 - first) + (last + 1 - core1);
+      if (edgeUsed + edgeCount > edgeLimit) return false;
+      memcpy(edgeOut + edgeUsed, cov + first, core0 - first);
+      memcpy(edgeOut + edgeUsed + (core0 - first), cov + core1, last + 1 - core1);
+
+      out.dx = first - HAND_SPAN_REACH;
+      out.leftEdge = core0 - first;
+      out.core = core1 - core0;
+      out.rightEdge = last + 1 - core1;
+      edgeUsed += edgeCount;
+    }
+
+    spans->dyMin = dyMin;
+    spans->rows = rows;
+    poolUsed = at + sizeof(HandSpans) + rowBytes + edgeUsed;
+    offset = at + 1;
+    return true;
+  }
+
+  int16_t cx = 0;
+  int16_t cy = 0;
+  float lengths[HAND_SPAN_MAX_SHAPES];
+  float thicknesses[HAND_SPAN_MAX_SHAPES];
+  uint8_t shapeCount = 0;
+
+  uint8_t* pool = nullptr;
+  uint32_t poolSize = 0;
+  uint32_t poolUsed = 0;
+  uint32_t records[HAND_SPAN_MAX_SHAPES][HAND_SPAN_QUARTER_STEPS + 1];  // Pool offset + 1, 0 = not built
+};
+
+#endif // PIXEL_HAND_SPAN_CACHE_H
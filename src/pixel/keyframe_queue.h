@@ -0,0 +1,124 @@
+#ifndef PIXEL_KEYFRAME_QUEUE_H
+#define PIXEL_KEYFRAME_QUEUE_H
+
+#include <Arduino.h>
+#include <ESPNowComm.h>
+#include "spring_motion.h"
+
+// Keyframe Queue - choreography sent ahead of time and played back locally
+// CMD_QUEUE_KEYFRAMES uploads a pixel's upcoming movements; each keyframe starts
+// `delayMs` after the previous one ends (0 = back-to-back). Start times are kept
+// on a schedule rather than taken from when loop() gets around to a keyframe:
+// every keyframe starts at the previous scheduled start plus its span and
+// delay, and its transition is started at that scheduled time. A loop() that runs
+// late shortens the first frame of a keyframe instead of pushing everything after
+// it back, so timing error never accumulates over a sequence.
+
+const uint8_t KEYFRAME_QUEUE_SIZE = 32;  // Keyframes held ahead of playback
+
+// A queued movement, decoded from a KeyframeEntry or a delayed CMD_SET_ANGLES
+struct Keyframe {
+  float targets[HANDS_PER_PIXEL];            // Degrees
+  RotationDirection dirs[HANDS_PER_PIXEL];
+  uint8_t turns[HANDS_PER_PIXEL];            // Extra whole turns on the way
+  uint8_t waypointMask;                      // Bit i: hand i goes via waypoints[i]
+  float waypoints[HANDS_PER_PIXEL];          // Degrees
+  RotationDirection waypointDirs[HANDS_PER_PIXEL];  // From the waypoint to the target
+  TransitionType easings[HANDS_PER_PIXEL];
+  uint32_t durationsMs[HANDS_PER_PIXEL];     // Spring hands: estimated settle time
+  uint32_t colorDurationMs;                  // Opacity and colors
+  float springFrequencyHz;                   // Spring of TRANSITION_SPRING hands
+  float springDampingRatio;
+  uint8_t colorIndex;
+  uint8_t opacity;
+  uint16_t delayMs;                          // Gap after the previous keyframe ends
+
+  // How long the keyframe runs (its slowest hand, or the colors)
+  uint32_t spanMs() const {
+    uint32_t span = colorDurationMs;
+    for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) span = max(span, durationsMs[i]);
+    return span;
+  }
+
+  // Set hand i's easing and duration (a spring hand runs until it settles instead)
+  // Set the hand's turns and waypoint first: a spring's settle time depends on them
+  void setHandTiming(uint8_t i, TransitionType easing, uint32_t durationMs) {
+    easings[i] = easing;
+    durationsMs[i] = (easing == TRANSITION_SPRING)
+      ? springSettleMs(springFrequencyHz, springDampingRatio, travelEstimate(i))
+      : durationMs;
+  }
+
+  // Typical distance hand i travels (the start angle is only known when it plays)
+  float travelEstimate(uint8_t i) const {
+    return 180.0f + 360.0f * turns[i] + ((waypointMask & (1 << i)) ? 180.0f : 0.0f);
+  }
+
+  // A keyframe as sent: all hands share the easing and duration (springs use the default)
+  static Keyframe fromEntry(const KeyframeEntry& entry) {
+    Keyframe keyframe;
+    keyframe.springFrequencyHz = SPRING_DEFAULT_FREQUENCY_HZ;
+    keyframe.springDampingRatio = SPRING_DEFAULT_DAMPING_RATIO;
+    keyframe.waypointMask = 0;
+    for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+      keyframe.targets[i] = angleToFloat(entry.angles[i]);
+      keyframe.dirs[i] = entry.getDirection(i);
+      keyframe.turns[i] = 0;
+      keyframe.setHandTiming(i, entry.transition, entry.durationMs);
+    }
+    keyframe.colorDurationMs = entry.durationMs;
+    keyframe.colorIndex = entry.colorIndex;
+    keyframe.opacity = entry.opacity;
+    keyframe.delayMs = entry.delayMs;
+    return keyframe;
+  }
+};
+
+class KeyframeQueue {
+public:
+  // Drop all queued keyframes; a sequence queued later starts no earlier than
+  // `busyUntilMs` (end of whatever transition is running now)
+  void clear(uint32_t busyUntilMs) {
+    head = tail;
+    scheduleMs = busyUntilMs;
+  }
+
+  // Append a keyframe; false if the queue is full
+  // A keyframe queued while nothing is scheduled starts counting from now
+  bool push(const Keyframe& keyframe, uint32_t nowMs) {
+    if ((uint8_t)(tail - head) == KEYFRAME_QUEUE_SIZE) return false;
+    if (isEmpty() && (int32_t)(nowMs - scheduleMs) > 0) scheduleMs = nowMs;
+    slots[tail % KEYFRAME_QUEUE_SIZE] = keyframe;
+    tail++;
+    return true;
+  }
+
+  bool isEmpty() const { return head == tail; }
+  uint8_t size() const { return tail - head; }
+
+  // Scheduled start of the next keyframe (only meaningful when not empty)
+  uint32_t nextStartMs() const {
+    return scheduleMs + slots[head % KEYFRAME_QUEUE_SIZE].delayMs;
+  }
+
+  // Take the next keyframe if it is due at nowMs; startMs is its scheduled start
+  bool popDue(uint32_t nowMs, Keyframe& keyframe, uint32_t& startMs) {
+    if (isEmpty()) return false;
+    uint32_t start = nextStartMs();
+    if ((int32_t)(nowMs - start) < 0) return false;
+
+    keyframe = slots[head % KEYFRAME_QUEUE_SIZE];
+    head++;
+    startMs = start;
+    scheduleMs = start + keyframe.spanMs();
+    return true;
+  }
+
+private:
+  Keyframe slots[KEYFRAME_QUEUE_SIZE];
+  uint8_t head = 0;         // Next keyframe to play
+  uint8_t tail = 0;         // Next free slot
+  uint32_t scheduleMs = 0;  // Scheduled end of the last keyframe taken (or busy-until time)
+};
+
+#endif // PIXEL_KEYFRAME_QUEUE_H
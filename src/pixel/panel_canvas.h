@@ -0,0 +1,76 @@
+#ifndef PIXEL_PANEL_CANVAS_H
+#define PIXEL_PANEL_CANVAS_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include "color_kernels.h"
+
+// Panel Canvas - RGB565 pixels stored in GC9A01 wire order
+// The panel takes each pixel high byte first, while the ESP32 stores uint16_t low
+// byte first. Every RGB565 buffer in the pixel firmware (framebuffers, band buffers,
+// line buffers, rasterizer palettes) keeps its pixels byte-swapped instead, so any
+// run of memory can be handed to the SPI peripheral as one contiguous block with
+// no conversion pass. Colors are swapped once, when they are chosen, not per pixel.
+//
+// Drawing code keeps using normal RGB565 constants: PanelCanvas converts at the
+// GFX entry points and getPixel() converts back.
+
+// Host RGB565 <-> panel order (the same byte swap both ways)
+inline uint16_t toPanelOrder(uint16_t color) { return (color >> 8) | (color << 8); }
+inline uint16_t fromPanelOrder(uint16_t color) { return (color >> 8) | (color << 8); }
+
+// blend565() for two panel-order colors; the result is in panel order too
+inline uint16_t blendPanel(uint16_t bg, uint16_t fg, uint8_t alpha) {
+  return toPanelOrder(blend565(fromPanelOrder(bg), fromPanelOrder(fg), alpha));
+}
+
+// GFXcanvas16 over caller-provided memory, storing pixels in panel order
+class PanelCanvas : public GFXcanvas16 {
+public:
+  PanelCanvas(uint16_t w, uint16_t h, uint16_t* pixels) : GFXcanvas16(w, h, false) {
+    buffer = pixels;
+    buffer_owned = false;
+  }
+
+  // Host-order color of a pixel
+  uint16_t getPixel(int16_t x, int16_t y) const {
+    return fromPanelOrder(GFXcanvas16::getPixel(x, y));
+  }
+
+  // ---- Adafruit_GFX primitives: swap the color once, then store it as-is ----
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    GFXcanvas16::drawPixel(x, y, toPanelOrder(color));
+  }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    GFXcanvas16::drawFastHLine(x, y, w, toPanelOrder(color));
+  }
+
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+    GFXcanvas16::drawFastVLine(x, y, h, toPanelOrder(color));
+  }
+
+  void fillScreen(uint16_t color) override {
+    GFXcanvas16::fillScreen(toPanelOrder(color));
+  }
+
+  // Rectangles (text backgrounds, progress bars) as 32-bit span fills
+  // (frame canvases are never rotated, so rows map straight onto the buffer)
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    int16_t x1 = min<int16_t>(x + w, _width);
+    int16_t y1 = min<int16_t>(y + h, _height);
+    x = max<int16_t>(x, 0);
+    y = max<int16_t>(y, 0);
+    if (x1 <= x || y1 <= y) return;
+
+    uint16_t panelColor = toPanelOrder(color);
+    for (int16_t row = y; row < y1; row++) {
+      fillSpan565(buffer + (int32_t)row * _width + x, x1 - x, panelColor);
+    }
+  }
+};
+
+#endif // PIXEL_PANEL_CANVAS_H
@@ -0,0 +1,49 @@
+#ifndef PIXEL_SPIN_MOTION_H
+#define PIXEL_SPIN_MOTION_H
+
+#include <Arduino.h>
+#include <ESPNowComm.h>
+
+// Spin Motion - hands turning at a constant angular velocity (CMD_SPIN_HANDS)
+// A spinning hand's angle is a function of time rather than something stepped
+// frame by frame: angle = phase + velocity * (now - start). Summing per-frame
+// increments in float would drift (each frame's rounding adds up over hours);
+// this never accumulates anything, so the angle after ten minutes or ten days is
+// as exact as after one frame.
+//
+// Angles are 32-bit fractions of a turn (2^32 = 360 degrees), so wrapping is the
+// integer overflow. Velocity is in those units per millisecond with 32 more
+// fraction bits (Q32.32), so a 64 x 32-bit multiply gives the travelled angle
+// with no division; the velocity's rounding error stays under 2^-32 units per ms
+// (about 1e-7 degrees over the 49 days millis() takes to wrap). Spins without a
+// stop are rebased every SPIN_REBASE_MS so the elapsed time never wraps.
+
+typedef uint32_t spin_angle_t;                   // 2^32 = one turn
+
+const uint32_t SPIN_REBASE_MS = 1UL << 30;       // ~12 days
+const int32_t SPIN_MAX_ARCSEC_PER_S = 36000L * SPIN_ARCSEC_PER_DEGREE;  // 100 turns/s
+
+// Velocity from arcseconds per second (Q32.32 turn units per ms)
+inline int64_t spinVelocityFromArcsec(int32_t arcsecPerSecond) {
+  arcsecPerSecond = constrain(arcsecPerSecond, -SPIN_MAX_ARCSEC_PER_S, SPIN_MAX_ARCSEC_PER_S);
+  // 2^64 per turn, 360 * 3600 arcsec per turn, 1000 ms per second (worked out once per command)
+  return (int64_t)llround((double)arcsecPerSecond * (18446744073709551616.0 / (360.0 * 3600.0 * 1000.0)));
+}
+
+// Angle `elapsedMs` after starting at `phase`
+inline spin_angle_t spinAngleAt(spin_angle_t phase, int64_t velocity, uint32_t elapsedMs) {
+  // Two's complement: a negative velocity wraps the product the right way round
+  return phase + (spin_angle_t)(((uint64_t)velocity * elapsedMs) >> 32);
+}
+
+inline spin_angle_t spinAngleFromDegrees(float degrees) {
+  while (degrees < 0) degrees += 360.0f;
+  while (degrees >= 360.0f) degrees -= 360.0f;
+  return (spin_angle_t)(uint64_t)(degrees * (4294967296.0f / 360.0f));
+}
+
+inline float spinAngleToDegrees(spin_angle_t angle) {
+  return angle * (360.0f / 4294967296.0f);
+}
+
+#endif // PIXEL_SPIN_MOTION_H
@@ -0,0 +1,119 @@
+#ifndef PIXEL_SPRING_MOTION_H
+#define PIXEL_SPRING_MOTION_H
+
+#include <Arduino.h>
+#include <ESPNowComm.h>
+#include "fixed_math.h"
+
+// Spring Motion - hands pulled to their targets by a damped spring
+// Easing curves run a fixed duration from rest: a command that arrives mid-flight
+// restarts the hand with zero velocity, which shows as a kink. A TRANSITION_SPRING
+// hand instead integrates x'' = -w^2 (x - target) - 2 zeta w x' (w = 2 pi frequency),
+// so a new target only changes the force and the hand carries its velocity into
+// the new movement. zeta = 1 is critically damped (fastest approach without
+// overshoot), below 1 it overshoots and rings.
+//
+// Integration is semi-implicit Euler in fixed SPRING_STEP_MS steps counted from
+// the transition's start, so the motion depends only on elapsed time, not on the
+// frame rate: a frame integrates the steps that fell due since the last one. With
+// USE_FIXED_POINT_MATH the state is Q16 (degrees, degrees/s) and a step is four
+// multiplies; otherwise float.
+//
+// Multi-turn travel is one spring too (the position runs along the hand's whole
+// path); its frequency is capped so frequency x travel stays within what a
+// single turn at SPRING_MAX_FREQUENCY_HZ reaches, keeping the Q16 velocity in range.
+//
+// A spring has no fixed duration. It ends when it has settled (within
+// SPRING_SETTLE_DEGREES, slower than SPRING_SETTLE_DPS); for scheduling keyframes
+// after it, springSettleMs() estimates when that is.
+
+const uint32_t SPRING_STEP_MS = 4;                 // Integration step (250 Hz)
+const uint16_t SPRING_MAX_STEPS_PER_UPDATE = 500;  // Catch-up limit (2 s): further behind, land on target
+const float SPRING_MAX_FREQUENCY_HZ = 6.0f;        // Keeps velocities within Q16 range over a turn (and the step stable)
+const float SPRING_MIN_DAMPING_RATIO = 0.05f;      // Always settles eventually
+const float SPRING_SETTLE_DEGREES = 0.05f;
+const float SPRING_SETTLE_DPS = 1.0f;
+
+// Highest frequency for a spring travelling `travelDegrees`
+inline float springMaxFrequencyHz(float travelDegrees) {
+  return SPRING_MAX_FREQUENCY_HZ * 360.0f / max(travelDegrees, 360.0f);
+}
+
+// Estimated time to settle after a sweep from rest (at least half a turn):
+// ln(180 / 0.05) = 8.2 time constants of the slowest decaying mode, a third more
+// near critical damping where the two modes merge and decay more slowly
+// (measured at most ~7% short; up to ~45% long, which only delays what follows)
+inline uint32_t springSettleMs(float frequencyHz, float dampingRatio, float travelDegrees = 180.0f) {
+  frequencyHz = constrain(frequencyHz, 0.1f, springMaxFrequencyHz(travelDegrees));
+  dampingRatio = max(dampingRatio, SPRING_MIN_DAMPING_RATIO);
+  float omega = 2.0f * PI * frequencyHz;
+  float decay = dampingRatio < 1.0f
+    ? dampingRatio * omega
+    : omega * (dampingRatio - sqrtf(dampingRatio * dampingRatio - 1.0f));
+  float timeConstants = logf(max(travelDegrees, 180.0f) / SPRING_SETTLE_DEGREES);
+  if (dampingRatio > 0.85f && dampingRatio < 1.2f) timeConstants *= 11.0f / 8.2f;
+  return (uint32_t)(timeConstants * 1000.0f / decay);
+}
+
+#ifdef USE_FIXED_POINT_MATH
+typedef q16_t spring_t;  // Q16 degrees, degrees/s and per-step coefficients
+
+const q16_t SPRING_STEP_FX = (q16_t)((SPRING_STEP_MS << 16) / 1000);  // Step in Q16 seconds
+const spring_t SPRING_SETTLE_DISTANCE = (spring_t)(SPRING_SETTLE_DEGREES * Q16_ONE);
+const spring_t SPRING_SETTLE_SPEED = (spring_t)(SPRING_SETTLE_DPS * Q16_ONE);
+
+inline spring_t springFromDegrees(float degrees) { return fxFromFloat(degrees); }
+inline float springToDegrees(spring_t value) { return fxToFloat(value); }
+#else
+typedef float spring_t;  // Degrees, degrees/s and per-step coefficients
+
+const float SPRING_STEP_S = SPRING_STEP_MS / 1000.0f;
+const spring_t SPRING_SETTLE_DISTANCE = SPRING_SETTLE_DEGREES;
+const spring_t SPRING_SETTLE_SPEED = SPRING_SETTLE_DPS;
+
+inline spring_t springFromDegrees(float degrees) { return degrees; }
+inline float springToDegrees(spring_t value) { return value; }
+#endif
+
+// Per-step coefficients of a spring: stiffness w^2 * dt, damping 2 zeta w * dt
+struct SpringCoefficients {
+  spring_t stiffness;
+  spring_t damping;
+
+  static SpringCoefficients of(float frequencyHz, float dampingRatio, float travelDegrees = 0.0f) {
+    frequencyHz = constrain(frequencyHz, 0.1f, springMaxFrequencyHz(travelDegrees));
+    dampingRatio = max(dampingRatio, SPRING_MIN_DAMPING_RATIO);
+    float omega = 2.0f * PI * frequencyHz;
+    float dt = SPRING_STEP_MS / 1000.0f;
+    SpringCoefficients k;
+  #ifdef USE_FIXED_POINT_MATH
+    k.stiffness = fxFromFloat(omega * omega * dt);
+    k.damping = fxFromFloat(2.0f * dampingRatio * omega * dt);
+  #else
+    k.stiffness = omega * omega * dt;
+    k.damping = 2.0f * dampingRatio * omega * dt;
+  #endif
+    return k;
+  }
+};
+
+// Advance position/velocity one step toward target
+inline void springStep(spring_t& position, spring_t& velocity, spring_t target,
+                       spring_t stiffness, spring_t damping) {
+#ifdef USE_FIXED_POINT_MATH
+  velocity -= fxMul(stiffness, position - target) + fxMul(damping, velocity);
+  position += fxMul(velocity, SPRING_STEP_FX);
+#else
+  velocity -= stiffness * (position - target) + damping * velocity;
+  position += velocity * SPRING_STEP_S;
+#endif
+}
+
+// At rest on the target
+inline bool springSettled(spring_t position, spring_t velocity, spring_t target) {
+  spring_t offset = position - target;
+  return offset < SPRING_SETTLE_DISTANCE && offset > -SPRING_SETTLE_DISTANCE &&
+         velocity < SPRING_SETTLE_SPEED && velocity > -SPRING_SETTLE_SPEED;
+}
+
+#endif // PIXEL_SPRING_MOTION_H
@@ -0,0 +1,143 @@
+#ifndef PIXEL_STAGE_PROFILER_H
+#define PIXEL_STAGE_PROFILER_H
+
+#include <Arduino.h>
+
+// Stage Profiler - per-frame stage times as cycle-count histograms
+// The FPS report only gives per-second averages, which hide the slow frames that
+// show up as stutter. With USE_STAGE_PROFILER each clock frame records how many
+// CPU cycles every stage took into a fixed-bucket histogram per stage: a bucket
+// index from the cycle count's leading bit and the two bits below it (4 buckets
+// per octave, 14-25% wide), so recording is a subtraction, a count-leading-zeros
+// and an increment. p50/p95/p99 are read from the buckets (reported as the
+// bucket's upper bound), max is exact.
+//
+// The histograms live in one static block so the transfer task on the other core
+// can record into it without a handle. Reads are not synchronized with recording;
+// a snapshot taken while a frame is in flight may be off by that frame.
+//
+// Without USE_STAGE_PROFILER the profiler and its histograms compile out and the
+// PROFILE_* macros are empty.
+
+// Frame stages (also the order of ProfileResponsePacket::stages)
+enum ProfileStage : uint8_t {
+  PROFILE_UPDATE = 0,   // Transition update: hand angles and colors
+  PROFILE_DAMAGE,       // Frame shapes and damage against panel and framebuffer
+  PROFILE_RASTER,       // Background, hands and center dot (one fused pass)
+  PROFILE_PUSH,         // Panel transfer of every frame (band renderer: clock raster and push, interleaved)
+  PROFILE_FRAME,        // Whole clock frame in loop(), including waiting for a buffer
+  PROFILE_STAGE_COUNT
+};
+
+#ifdef USE_STAGE_PROFILER
+
+const uint8_t PROFILE_MIN_OCTAVE = 10;   // Bucket 0: under 2^10 cycles (~4-6 us)
+const uint8_t PROFILE_MAX_OCTAVE = 29;   // Last bucket: 2^30 cycles (~4-7 s) and above
+const uint8_t PROFILE_SUB_BUCKETS = 4;   // Per octave
+const uint8_t PROFILE_BUCKETS = 1 + (PROFILE_MAX_OCTAVE - PROFILE_MIN_OCTAVE + 1) * PROFILE_SUB_BUCKETS;
+
+// One stage's distribution, in microseconds
+struct StageSummary {
+  uint32_t samples;
+  uint32_t p50Us;
+  uint32_t p95Us;
+  uint32_t p99Us;
+  uint32_t maxUs;
+};
+
+class StageProfiler {
+public:
+  // Current cycle count (start of a stage)
+  static inline uint32_t now() { return ESP.getCycleCount(); }
+
+  // Add one sample of `cycles` to a stage
+  static inline void record(ProfileStage stage, uint32_t cycles) {
+    Histogram& h = histograms()[stage];
+    h.counts[bucketOf(cycles)]++;
+    if (cycles > h.maxCycles) h.maxCycles = cycles;
+  }
+
+  // Percentiles and max of a stage
+  static StageSummary summarize(ProfileStage stage) {
+    const Histogram& h = histograms()[stage];
+    StageSummary s = {0, 0, 0, 0, 0};
+    for (uint8_t b = 0; b < PROFILE_BUCKETS; b++) s.samples += h.counts[b];
+    if (s.samples == 0) return s;
+
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    s.p50Us = percentileCycles(h, s.samples, 50) / mhz;
+    s.p95Us = percentileCycles(h, s.samples, 95) / mhz;
+    s.p99Us = percentileCycles(h, s.samples, 99) / mhz;
+    s.maxUs = h.maxCycles / mhz;
+    return s;
+  }
+
+  static void reset() { memset(histograms(), 0, sizeof(Histogram) * PROFILE_STAGE_COUNT); }
+
+  static const char* stageName(ProfileStage stage) {
+    switch (stage) {
+      case PROFILE_UPDATE: return "update";
+      case PROFILE_DAMAGE: return "damage";
+      case PROFILE_RASTER: return "raster";
+    #ifdef USE_BAND_RENDERER
+      case PROFILE_PUSH:   return "bands";
+    #else
+      case PROFILE_PUSH:   return "push";
+    #endif
+      case PROFILE_FRAME:  return "frame";
+      default:             return "?";
+    }
+  }
+
+private:
+  struct Histogram {
+    uint32_t counts[PROFILE_BUCKETS];
+    uint32_t maxCycles;
+  };
+
+  // Bucket 0 below 2^MIN_OCTAVE; then 4 buckets per octave from the two bits under the leading one
+  static inline uint8_t bucketOf(uint32_t cycles) {
+    if (cycles < (1u << PROFILE_MIN_OCTAVE)) return 0;
+    uint8_t octave = 31 - __builtin_clz(cycles);
+    if (octave > PROFILE_MAX_OCTAVE) return PROFILE_BUCKETS - 1;
+    uint8_t sub = (cycles >> (octave - 2)) & (PROFILE_SUB_BUCKETS - 1);
+    return 1 + (octave - PROFILE_MIN_OCTAVE) * PROFILE_SUB_BUCKETS + sub;
+  }
+
+  // Largest cycle count that falls into bucket b
+  static uint32_t bucketLimit(uint8_t b) {
+    if (b == 0) return (1u << PROFILE_MIN_OCTAVE) - 1;
+    if (b == PROFILE_BUCKETS - 1) return UINT32_MAX;
+    uint8_t octave = PROFILE_MIN_OCTAVE + (b - 1) / PROFILE_SUB_BUCKETS;
+    uint8_t sub = (b - 1) % PROFILE_SUB_BUCKETS;
+    return ((uint32_t)(PROFILE_SUB_BUCKETS + sub + 1) << (octave - 2)) - 1;
+  }
+
+  // Upper bound of the bucket holding the given percentile (never above the max)
+  static uint32_t percentileCycles(const Histogram& h, uint32_t samples, uint8_t percent) {
+    uint32_t rank = ((uint64_t)samples * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < PROFILE_BUCKETS; b++) {
+      seen += h.counts[b];
+      if (seen >= rank) return min(bucketLimit(b), h.maxCycles);
+    }
+    return h.maxCycles;
+  }
+
+  // The static block (zero-initialized, so no construction guard)
+  static Histogram* histograms() {
+    static Histogram table[PROFILE_STAGE_COUNT];
+    return table;
+  }
+};
+
+// Start timing: declares a cycle-count variable
+#define PROFILE_BEGIN(var) uint32_t var = StageProfiler::now()
+// Record the cycles since `var` into a stage
+#define PROFILE_END(stage, var) StageProfiler::record(stage, StageProfiler::now() - (var))
+#else
+#define PROFILE_BEGIN(var) do {} while (0)
+#define PROFILE_END(stage, var) do {} while (0)
+#endif
+
+#endif // PIXEL_STAGE_PROFILER_H
@@ -0,0 +1,178 @@
+#ifndef PIXEL_STREAM_PLAYER_H
+#define PIXEL_STREAM_PLAYER_H
+
+#include <Arduino.h>
+#include <ESPNowComm.h>
+
+// Stream Player - hand angles streamed as timestamped samples
+// For interactive or generative control the master streams targets at 20-50 Hz
+// (CMD_STREAM_TARGETS). Restarting a transition on every packet would stop and
+// restart the hands each time; instead the samples are played back as a curve.
+//
+// Each sample carries the master's millis(). The offset between the two clocks
+// is estimated as the smallest (receipt - timestamp) seen over a sliding window,
+// i.e. the master clock plus the fastest delivery, so radio and loop() latency
+// jitter does not move samples around. Playback runs STREAM_PLAYBACK_DELAY_MS
+// behind the newest sample time: the hands follow a cubic Hermite curve through
+// the samples (continuous velocity), and one or two lost packets are bridged by
+// interpolating across the gap. When samples stop arriving the hands dead-reckon
+// along the last velocity for up to STREAM_EXTRAPOLATE_MS, then hold.
+//
+// Angles are unwrapped as they arrive (each sample within 180 degrees of the
+// previous one), so curves run through 0/360 without a jump; callers wrap them.
+
+const uint8_t STREAM_SAMPLES = 8;                // Samples kept for interpolation (power of two)
+const uint32_t STREAM_PLAYBACK_DELAY_MS = 100;   // Playback lag behind the newest sample (2 samples at 20 Hz)
+const uint32_t STREAM_EXTRAPOLATE_MS = 250;      // Longest dead-reckoning past the newest sample
+const uint32_t STREAM_TIMEOUT_MS = 1000;         // Streaming ends this long after the last sample
+const uint32_t STREAM_CLOCK_WINDOW_MS = 2000;    // Window of the clock offset minimum
+
+class StreamPlayer {
+public:
+  // Forget the stream (a transition or keyframe takes the hands over)
+  void reset() {
+    count = 0;
+    synced = false;
+  }
+
+  // Add one packet's targets for this pixel
+  // masterMs: the packet's timestamp; receivedMs: local millis() at receipt
+  void addSample(uint16_t sequence, uint32_t masterMs, uint32_t receivedMs,
+                 const float angles[HANDS_PER_PIXEL]) {
+    updateClock(masterMs, receivedMs);
+    lastReceivedMs = receivedMs;
+
+    if (count > 0) {
+      int16_t gap = (int16_t)(sequence - lastSequence);
+      if (gap <= 0) return;  // Duplicate or out of order: already played past it
+      lostCount += gap - 1;
+    }
+    lastSequence = sequence;
+
+    Sample& sample = samples[(first + count) % STREAM_SAMPLES];
+    if (count == STREAM_SAMPLES) {
+      first = (first + 1) % STREAM_SAMPLES;
+    } else {
+      count++;
+    }
+    sample.masterMs = masterMs;
+    for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+      float angle = angles[h];
+      if (count > 1) {
+        // Continue from the previous sample by the shortest way round
+        float previous = at(count - 2).angles[h];
+        float delta = angle - previous;
+        delta -= 360.0f * floorf((delta + 180.0f) / 360.0f);
+        angle = previous + delta;
+      }
+      sample.angles[h] = angle;
+    }
+  }
+
+  // Samples are arriving (or stopped less than STREAM_TIMEOUT_MS ago)
+  bool isActive(uint32_t nowMs) const {
+    return count > 0 && nowMs - lastReceivedMs < STREAM_TIMEOUT_MS;
+  }
+
+  // Unwrapped hand angles at local time nowMs; false when not streaming
+  bool anglesAt(uint32_t nowMs, float angles[HANDS_PER_PIXEL]) const {
+    if (!isActive(nowMs)) return false;
+
+    // Playback position in master time
+    int32_t t = (int32_t)(nowMs - clockOffset - STREAM_PLAYBACK_DELAY_MS);
+
+    // Before the oldest sample: hold it
+    if (count == 1 || t <= timeOf(0)) {
+      copyAngles(at(0), angles);
+      return true;
+    }
+
+    // Past the newest sample: dead-reckon along the last velocity, then hold
+    uint8_t last = count - 1;
+    if (t >= timeOf(last)) {
+      int32_t ahead = min<int32_t>(t - timeOf(last), STREAM_EXTRAPOLATE_MS);
+      float span = (float)(timeOf(last) - timeOf(last - 1));
+      for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+        float velocity = (at(last).angles[h] - at(last - 1).angles[h]) / span;
+        angles[h] = at(last).angles[h] + velocity * ahead;
+      }
+      return true;
+    }
+
+    // Between samples i and i+1: cubic Hermite with Catmull-Rom tangents
+    uint8_t i = 0;
+    while (timeOf(i + 1) <= t) i++;
+    float t1 = (float)timeOf(i);
+    float t2 = (float)timeOf(i + 1);
+    float dt = t2 - t1;
+    float s = (t - t1) / dt;
+    float s2 = s * s;
+    float s3 = s2 * s;
+    float h00 = 2 * s3 - 3 * s2 + 1;
+    float h10 = s3 - 2 * s2 + s;
+    float h01 = -2 * s3 + 3 * s2;
+    float h11 = s3 - s2;
+
+    for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+      float p1 = at(i).angles[h];
+      float p2 = at(i + 1).angles[h];
+      float m1 = (i > 0) ? (p2 - at(i - 1).angles[h]) / (t2 - timeOf(i - 1)) : (p2 - p1) / dt;
+      float m2 = (i + 2 < count) ? (at(i + 2).angles[h] - p1) / (timeOf(i + 2) - t1) : (p2 - p1) / dt;
+      angles[h] = h00 * p1 + h10 * dt * m1 + h01 * p2 + h11 * dt * m2;
+    }
+    return true;
+  }
+
+  // Samples skipped since boot (lost, or arrived after a newer one)
+  uint32_t lost() const { return lostCount; }
+
+private:
+  struct Sample {
+    uint32_t masterMs;
+    float angles[HANDS_PER_PIXEL];  // Unwrapped degrees
+  };
+
+  // k-th oldest sample
+  const Sample& at(uint8_t k) const { return samples[(first + k) % STREAM_SAMPLES]; }
+
+  // k-th oldest sample's time (master clock, signed so spans can be subtracted)
+  int32_t timeOf(uint8_t k) const { return (int32_t)at(k).masterMs; }
+
+  static void copyAngles(const Sample& sample, float angles[HANDS_PER_PIXEL]) {
+    for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) angles[h] = sample.angles[h];
+  }
+
+  // Offset = local - master, from the fastest delivery in the current window;
+  // a new window lets the estimate follow clock drift upward as well
+  void updateClock(uint32_t masterMs, uint32_t receivedMs) {
+    uint32_t offset = receivedMs - masterMs;
+    if (!synced) {
+      clockOffset = offset;
+      windowMin = offset;
+      windowStart = receivedMs;
+      synced = true;
+      return;
+    }
+    if ((int32_t)(offset - windowMin) < 0) windowMin = offset;
+    if ((int32_t)(offset - clockOffset) < 0) clockOffset = offset;
+    if (receivedMs - windowStart >= STREAM_CLOCK_WINDOW_MS) {
+      clockOffset = windowMin;
+      windowMin = offset;
+      windowStart = receivedMs;
+    }
+  }
+
+  Sample samples[STREAM_SAMPLES];
+  uint8_t first = 0;             // Oldest sample
+  uint8_t count = 0;             // Samples held
+  uint16_t lastSequence = 0;
+  uint32_t lastReceivedMs = 0;
+  uint32_t lostCount = 0;
+
+  bool synced = false;
+  uint32_t clockOffset = 0;      // Local millis() minus master millis()
+  uint32_t windowMin = 0;        // Smallest offset in the current window
+  uint32_t windowStart = 0;
+};
+
+#endif // PIXEL_STREAM_PLAYER_H
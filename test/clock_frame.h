@@ -0,0 +1,45 @@
+#ifndef HOST_CLOCK_FRAME_H
+#define HOST_CLOCK_FRAME_H
+
+// Clock Frame - reference rendering for host tests of the pixel's clock face
+// Frames are described and rasterized with pixel/clock_face.h, exactly as
+// loop() does; the reference is the same frame rasterized in one go.
+
+#include <Arduino.h>
+#include "pixel/circle_mask.h"
+#include "pixel/clock_face.h"
+
+const int32_t DISPLAY_PIXELS = (int32_t)DISPLAY_WIDTH * DISPLAY_HEIGHT;
+
+// The panel's circle mask, as setup() builds it
+inline CircleMask& panelMask() {
+  static CircleMask mask;
+  static bool built = false;
+  if (!built) {
+    mask.build(CENTER_X, CENTER_Y, MAX_RADIUS, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    built = true;
+  }
+  return mask;
+}
+
+// Whole frame rasterized in one go (panel-order RGB565): what the panel should show
+inline void renderReference(const ClockFrame& frame, uint16_t* pixels) {
+  static CapsuleRasterizer rasterizer;
+  prepareRasterizer(rasterizer, frame);
+  rasterizer.render(pixels, DISPLAY_WIDTH, {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT}, panelMask());
+}
+
+// Visible pixels where a panel image (host order) differs from a panel-order frame
+inline int32_t countVisibleMismatches(const uint16_t* panel, const uint16_t* expected) {
+  int32_t mismatches = 0;
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+    const CircleSpan& span = panelMask().row(y);
+    for (int16_t x = span.x; x < span.x + span.len; x++) {
+      int32_t i = (int32_t)y * DISPLAY_WIDTH + x;
+      if (panel[i] != fromPanelOrder(expected[i])) mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+#endif // HOST_CLOCK_FRAME_H
@@ -0,0 +1,58 @@
+#include "host_test.h"
+
+static HostTestCase* firstTest = nullptr;
+static HostTestCase* lastTest = nullptr;
+static int failedChecks = 0;
+
+HostTestRegistrar::HostTestRegistrar(HostTestCase& test) {
+  if (lastTest) {
+    lastTest->next = &test;
+  } else {
+    firstTest = &test;
+  }
+  lastTest = &test;
+}
+
+bool hostCheck(bool passed, const char* expr, const char* file, int line) {
+  if (!passed) {
+    failedChecks++;
+    printf("    FAILED %s:%d: %s\n", file, line, expr);
+  }
+  return passed;
+}
+
+bool hostCheckEqual(long long actual, long long expected, const char* expr, const char* file, int line) {
+  bool passed = actual == expected;
+  if (!passed) {
+    failedChecks++;
+    printf("    FAILED %s:%d: %s (got %lld, expected %lld)\n", file, line, expr, actual, expected);
+  }
+  return passed;
+}
+
+bool hostCheckNear(double actual, double expected, double tolerance, const char* expr,
+                   const char* file, int line) {
+  double diff = actual - expected;
+  bool passed = diff <= tolerance && diff >= -tolerance;
+  if (!passed) {
+    failedChecks++;
+    printf("    FAILED %s:%d: %s (got %g, expected %g +- %g)\n", file, line, expr, actual, expected, tolerance);
+  }
+  return passed;
+}
+
+int main() {
+  int failedTests = 0;
+  int total = 0;
+  for (HostTestCase* test = firstTest; test; test = test->next) {
+    int before = failedChecks;
+    printf("[ RUN  ] %s\n", test->name);
+    test->run();
+    bool passed = failedChecks == before;
+    printf("[ %s ] %s\n", passed ? " OK " : "FAIL", test->name);
+    failedTests += passed ? 0 : 1;
+    total++;
+  }
+  printf("%d of %d tests passed\n", total - failedTests, total);
+  return failedTests == 0 ? 0 : 1;
+}
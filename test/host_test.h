@@ -0,0 +1,61 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// Host Test - a tiny test runner for the firmware modules
+// Each test file defines TEST_CASE()s; host_test.cpp provides main(), runs them
+// all and fails the process when any CHECK failed. REPORT() prints benchmark
+// numbers next to the results so they show up in `ctest --output-on-failure -V`.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <chrono>
+
+struct HostTestCase {
+  const char* name;
+  void (*run)();
+  HostTestCase* next;
+};
+
+// Registers a test case at static initialization time
+struct HostTestRegistrar {
+  HostTestRegistrar(HostTestCase& test);
+};
+
+// Record a check result; returns `passed`
+bool hostCheck(bool passed, const char* expr, const char* file, int line);
+bool hostCheckEqual(long long actual, long long expected, const char* expr, const char* file, int line);
+bool hostCheckNear(double actual, double expected, double tolerance, const char* expr,
+                   const char* file, int line);
+
+#define TEST_CASE(name)                                                \
+  static void name();                                                  \
+  static HostTestCase name##_case = {#name, name, nullptr};            \
+  static HostTestRegistrar name##_registrar(name##_case);              \
+  static void name()
+
+#define CHECK(cond) hostCheck((cond), #cond, __FILE__, __LINE__)
+#define CHECK_EQ(actual, expected) \
+  hostCheckEqual((long long)(actual), (long long)(expected), #actual " == " #expected, __FILE__, __LINE__)
+#define CHECK_NEAR(actual, expected, tolerance) \
+  hostCheckNear((actual), (expected), (tolerance), #actual " ~ " #expected, __FILE__, __LINE__)
+
+#define REPORT(...)          \
+  do {                       \
+    printf("    ");          \
+    printf(__VA_ARGS__);     \
+    printf("\n");            \
+  } while (0)
+
+// Wall-clock stopwatch for benchmarks (the Arduino clock is simulated)
+class HostStopwatch {
+public:
+  HostStopwatch() : start(std::chrono::steady_clock::now()) {}
+  double elapsedNs() const {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  }
+
+private:
+  std::chrono::steady_clock::time_point start;
+};
+
+#endif // HOST_TEST_H
@@ -0,0 +1,36 @@
+#include <Adafruit_GC9A01A.h>
+
+SPIClass SPI;
+
+Adafruit_GC9A01A::Adafruit_GC9A01A(int8_t cs, int8_t dc, int8_t rst)
+    : Adafruit_GFX(GC9A01A_TFTWIDTH, GC9A01A_TFTHEIGHT) {}
+
+void Adafruit_GC9A01A::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+  winX = x;
+  winY = y;
+  winW = w;
+  winH = h;
+  cursor = 0;
+  windows++;
+}
+
+void Adafruit_GC9A01A::writePixels(uint16_t* colors, uint32_t len, bool block, bool bigEndian) {
+  bulkWrites++;
+  pixelsSent += len;
+  if (!bigEndian) pixelsSwapped += len;
+  for (uint32_t i = 0; i < len; i++, cursor++) {
+    if (winW <= 0 || cursor >= (int32_t)winW * winH) return;  // Past the window: the panel ignores it
+    uint16_t color = bigEndian ? (uint16_t)((colors[i] >> 8) | (colors[i] << 8)) : colors[i];
+    int16_t x = winX + cursor % winW;
+    int16_t y = winY + cursor / winW;
+    if (x < GC9A01A_TFTWIDTH && y < GC9A01A_TFTHEIGHT) pixels[y * GC9A01A_TFTWIDTH + x] = color;
+  }
+}
+
+void Adafruit_GC9A01A::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  pixelWrites++;
+  pixelsSent++;
+  pixelsSwapped++;
+  if (x < 0 || y < 0 || x >= GC9A01A_TFTWIDTH || y >= GC9A01A_TFTHEIGHT) return;
+  pixels[y * GC9A01A_TFTWIDTH + x] = color;
+}
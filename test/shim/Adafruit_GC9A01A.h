@@ -0,0 +1,58 @@
+#ifndef HOST_SHIM_ADAFRUIT_GC9A01A_H
+#define HOST_SHIM_ADAFRUIT_GC9A01A_H
+
+// Host GC9A01A shim - a panel that keeps its pixels in memory
+// Address windows and pixel writes land in `pixels` (host-order RGB565, what the
+// glass would show); call counters let tests compare bulk and per-pixel pushes.
+
+#include <Adafruit_GFX.h>
+#include <SPI.h>
+
+#define GC9A01A_BLACK 0x0000
+#define GC9A01A_WHITE 0xFFFF
+#define GC9A01A_RED 0xF800
+#define GC9A01A_GREEN 0x07E0
+#define GC9A01A_BLUE 0x001F
+#define GC9A01A_MAGENTA 0xF81F
+
+#define GC9A01A_TFTWIDTH 240
+#define GC9A01A_TFTHEIGHT 240
+
+class Adafruit_GC9A01A : public Adafruit_GFX {
+public:
+  Adafruit_GC9A01A(int8_t cs = -1, int8_t dc = -1, int8_t rst = -1);
+
+  void begin(uint32_t freq = 0) {}
+  void setRotation(uint8_t m) override {}
+
+  void startWrite() override { transactions++; }
+  void endWrite() override {}
+
+  // Set the window that following writePixels() calls fill, row by row
+  void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+  // bigEndian: colors are stored high byte first (panel order) and are sent unswapped
+  void writePixels(uint16_t* colors, uint32_t len, bool block = true, bool bigEndian = false);
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+
+  uint16_t pixel(int16_t x, int16_t y) const { return pixels[y * GC9A01A_TFTWIDTH + x]; }
+
+  // ---- Bus activity ----
+  uint32_t windows = 0;       // setAddrWindow() calls
+  uint32_t bulkWrites = 0;    // writePixels() calls
+  uint32_t pixelWrites = 0;   // drawPixel() calls
+  uint32_t pixelsSent = 0;    // Pixels received by any write
+  uint32_t pixelsSwapped = 0; // Little-endian pixels the real driver byte-swaps one by one
+  uint32_t transactions = 0;  // startWrite() calls
+
+  void resetCounters() { windows = bulkWrites = pixelWrites = pixelsSent = pixelsSwapped = transactions = 0; }
+
+  uint16_t pixels[GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT] = {};
+
+private:
+  int16_t winX = 0, winY = 0, winW = 0, winH = 0;
+  int32_t cursor = 0;  // Pixels written into the current window
+};
+
+#endif // HOST_SHIM_ADAFRUIT_GC9A01A_H
@@ -0,0 +1,416 @@
+#include <Adafruit_GFX.h>
+
+// Glyph column for the stand-in font: 7 rows (bit 0 on top), fixed per character
+static uint8_t glyphColumn(unsigned char c, uint8_t column) {
+  if (c == ' ') return 0;
+  uint32_t h = (c * 2654435761u) ^ (column * 40503u);
+  h ^= h >> 13;
+  return (uint8_t)((h * 0x5bd1e995u) >> 24) & 0x7F;
+}
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h), _width(w), _height(h) {}
+
+// ---- Primitives: same fallbacks as the library ----
+
+void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  drawFastVLine(x, y, h, color);
+}
+
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  drawFastHLine(x, y, w, color);
+}
+
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  fillRect(x, y, w, h, color);
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+
+  int16_t dx = x1 - x0;
+  int16_t dy = abs(y1 - y0);
+  int16_t err = dx / 2;
+  int16_t ystep = y0 < y1 ? 1 : -1;
+
+  for (; x0 <= x1; x0++) {
+    if (steep) {
+      writePixel(y0, x0, color);
+    } else {
+      writePixel(x0, y0, color);
+    }
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  startWrite();
+  writeLine(x, y, x, y + h - 1, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  startWrite();
+  writeLine(x, y, x + w - 1, y, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  startWrite();
+  for (int16_t i = x; i < x + w; i++) writeFastVLine(i, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+  if (x0 == x1) {
+    if (y0 > y1) std::swap(y0, y1);
+    drawFastVLine(x0, y0, y1 - y0 + 1, color);
+  } else if (y0 == y1) {
+    if (x0 > x1) std::swap(x0, x1);
+    drawFastHLine(x0, y0, x1 - x0 + 1, color);
+  } else {
+    startWrite();
+    writeLine(x0, y0, x1, y1, color);
+    endWrite();
+  }
+}
+
+void Adafruit_GFX::setRotation(uint8_t r) {
+  rotation = r & 3;
+  _width = (rotation & 1) ? HEIGHT : WIDTH;
+  _height = (rotation & 1) ? WIDTH : HEIGHT;
+}
+
+// ---- Shapes ----
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  startWrite();
+  writePixel(x0, y0 + r, color);
+  writePixel(x0, y0 - r, color);
+  writePixel(x0 + r, y0, color);
+  writePixel(x0 - r, y0, color);
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+
+    writePixel(x0 + x, y0 + y, color);
+    writePixel(x0 - x, y0 + y, color);
+    writePixel(x0 + x, y0 - y, color);
+    writePixel(x0 - x, y0 - y, color);
+    writePixel(x0 + y, y0 + x, color);
+    writePixel(x0 - y, y0 + x, color);
+    writePixel(x0 + y, y0 - x, color);
+    writePixel(x0 - y, y0 - x, color);
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color) {
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (cornername & 0x4) {
+      writePixel(x0 + x, y0 + y, color);
+      writePixel(x0 + y, y0 + x, color);
+    }
+    if (cornername & 0x2) {
+      writePixel(x0 + x, y0 - y, color);
+      writePixel(x0 + y, y0 - x, color);
+    }
+    if (cornername & 0x8) {
+      writePixel(x0 - y, y0 + x, color);
+      writePixel(x0 - x, y0 + y, color);
+    }
+    if (cornername & 0x1) {
+      writePixel(x0 - y, y0 - x, color);
+      writePixel(x0 - x, y0 - y, color);
+    }
+  }
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+  startWrite();
+  writeFastVLine(x0, y0 - r, 2 * r + 1, color);
+  fillCircleHelper(x0, y0, r, 3, 0, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta,
+                                    uint16_t color) {
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+
+  delta++;  // Avoid some +1's in the loop
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    // These checks avoid double-drawing certain lines
+    if (x < (y + 1)) {
+      if (corners & 1) writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+      if (corners & 2) writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+    }
+    if (y != py) {
+      if (corners & 1) writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+      if (corners & 2) writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+      py = y;
+    }
+    px = x;
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  startWrite();
+  writeFastHLine(x, y, w, color);
+  writeFastHLine(x, y + h - 1, w, color);
+  writeFastVLine(x, y, h, color);
+  writeFastVLine(x + w - 1, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                                uint16_t color) {
+  int16_t a, b, y, last;
+
+  // Sort coordinates by Y order (y2 >= y1 >= y0)
+  if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+  if (y1 > y2) { std::swap(y2, y1); std::swap(x2, x1); }
+  if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+
+  startWrite();
+  if (y0 == y2) {  // All on the same line
+    a = b = x0;
+    if (x1 < a) a = x1; else if (x1 > b) b = x1;
+    if (x2 < a) a = x2; else if (x2 > b) b = x2;
+    writeFastHLine(a, y0, b - a + 1, color);
+    endWrite();
+    return;
+  }
+
+  int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+          dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t sa = 0, sb = 0;
+
+  last = (y1 == y2) ? y1 : y1 - 1;
+  for (y = y0; y <= last; y++) {
+    a = x0 + sa / dy01;
+    b = x0 + sb / dy02;
+    sa += dx01;
+    sb += dx02;
+    if (a > b) std::swap(a, b);
+    writeFastHLine(a, y, b - a + 1, color);
+  }
+
+  sa = (int32_t)dx12 * (y - y1);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= y2; y++) {
+    a = x1 + sa / dy12;
+    b = x0 + sb / dy02;
+    sa += dx12;
+    sb += dx02;
+    if (a > b) std::swap(a, b);
+    writeFastHLine(a, y, b - a + 1, color);
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t* bitmap, int16_t w, int16_t h) {
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) writePixel(x + i, y, bitmap[j * w + i]);
+  }
+  endWrite();
+}
+
+// ---- Text (classic 6x8 cell font) ----
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg,
+                            uint8_t sizeX, uint8_t sizeY) {
+  if (x >= _width || y >= _height || (x + 6 * sizeX - 1) < 0 || (y + 8 * sizeY - 1) < 0) return;
+
+  startWrite();
+  for (int8_t i = 0; i < 5; i++) {
+    uint8_t line = glyphColumn(c, i);
+    for (int8_t j = 0; j < 8; j++, line >>= 1) {
+      if (line & 1) {
+        if (sizeX == 1 && sizeY == 1) {
+          writePixel(x + i, y + j, color);
+        } else {
+          writeFillRect(x + i * sizeX, y + j * sizeY, sizeX, sizeY, color);
+        }
+      } else if (bg != color) {
+        if (sizeX == 1 && sizeY == 1) {
+          writePixel(x + i, y + j, bg);
+        } else {
+          writeFillRect(x + i * sizeX, y + j * sizeY, sizeX, sizeY, bg);
+        }
+      }
+    }
+  }
+  if (bg != color) {  // Opaque text: last column is background
+    if (sizeX == 1 && sizeY == 1) {
+      writeFastVLine(x + 5, y, 8, bg);
+    } else {
+      writeFillRect(x + 5 * sizeX, y, sizeX, 8 * sizeY, bg);
+    }
+  }
+  endWrite();
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += textsize_y * 8;
+  } else if (c != '\r') {
+    if (wrap && (cursor_x + textsize_x * 6) > _width) {
+      cursor_x = 0;
+      cursor_y += textsize_y * 8;
+    }
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+    cursor_x += textsize_x * 6;
+  }
+  return 1;
+}
+
+// ---- GFXcanvas8 ----
+
+GFXcanvas8::GFXcanvas8(uint16_t w, uint16_t h, bool allocate_buffer) : Adafruit_GFX(w, h) {
+  if (allocate_buffer) {
+    buffer = (uint8_t*)calloc((size_t)w * h, 1);
+    buffer_owned = true;
+  }
+}
+
+GFXcanvas8::~GFXcanvas8() {
+  if (buffer_owned) free(buffer);
+}
+
+void GFXcanvas8::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+  buffer[(int32_t)y * WIDTH + x] = color;
+}
+
+void GFXcanvas8::fillScreen(uint16_t color) {
+  if (buffer) memset(buffer, color, (size_t)WIDTH * HEIGHT);
+}
+
+// Clipped, then straight into the buffer (rotation 0 only)
+void GFXcanvas8::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (h < 0) { y += h + 1; h = -h; }
+  if (!buffer || x < 0 || x >= _width) return;
+  int16_t y1 = min<int16_t>(y + h, _height);
+  for (y = max<int16_t>(y, 0); y < y1; y++) buffer[(int32_t)y * WIDTH + x] = color;
+}
+
+void GFXcanvas8::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (w < 0) { x += w + 1; w = -w; }
+  if (!buffer || y < 0 || y >= _height) return;
+  int16_t x1 = min<int16_t>(x + w, _width);
+  uint8_t* row = buffer + (int32_t)y * WIDTH;
+  for (x = max<int16_t>(x, 0); x < x1; x++) row[x] = color;
+}
+
+uint8_t GFXcanvas8::getPixel(int16_t x, int16_t y) const {
+  if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+  return buffer[(int32_t)y * WIDTH + x];
+}
+
+// ---- GFXcanvas16 ----
+
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h, bool allocate_buffer) : Adafruit_GFX(w, h) {
+  if (allocate_buffer) {
+    buffer = (uint16_t*)calloc((size_t)w * h, 2);
+    buffer_owned = true;
+  }
+}
+
+GFXcanvas16::~GFXcanvas16() {
+  if (buffer_owned) free(buffer);
+}
+
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+  buffer[(int32_t)y * WIDTH + x] = color;
+}
+
+void GFXcanvas16::fillScreen(uint16_t color) {
+  if (!buffer) return;
+  for (int32_t i = 0; i < (int32_t)WIDTH * HEIGHT; i++) buffer[i] = color;
+}
+
+void GFXcanvas16::byteSwap() {
+  if (!buffer) return;
+  for (int32_t i = 0; i < (int32_t)WIDTH * HEIGHT; i++) buffer[i] = (buffer[i] >> 8) | (buffer[i] << 8);
+}
+
+// Clipped, then straight into the buffer (rotation 0 only)
+void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  if (h < 0) { y += h + 1; h = -h; }
+  if (!buffer || x < 0 || x >= _width) return;
+  int16_t y1 = min<int16_t>(y + h, _height);
+  for (y = max<int16_t>(y, 0); y < y1; y++) buffer[(int32_t)y * WIDTH + x] = color;
+}
+
+void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  if (w < 0) { x += w + 1; w = -w; }
+  if (!buffer || y < 0 || y >= _height) return;
+  int16_t x1 = min<int16_t>(x + w, _width);
+  uint16_t* row = buffer + (int32_t)y * WIDTH;
+  for (x = max<int16_t>(x, 0); x < x1; x++) row[x] = color;
+}
+
+uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const {
+  if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+  return buffer[(int32_t)y * WIDTH + x];
+}
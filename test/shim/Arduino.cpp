@@ -0,0 +1,91 @@
+#include <Arduino.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// ---- Time ----
+
+static std::atomic<uint32_t> hostMicros(0);
+static HostIdleHook idleHook = nullptr;
+
+unsigned long millis() { return hostMicros / 1000; }
+unsigned long micros() { return hostMicros; }
+
+void hostSetMicros(uint32_t us) { hostMicros = us; }
+void hostAdvanceMicros(uint32_t us) { hostMicros += us; }
+
+void hostSetIdleHook(HostIdleHook hook) { idleHook = hook; }
+bool hostIdle() { return idleHook && idleHook(); }
+
+void delay(unsigned long ms) {
+  hostIdle();
+  hostAdvanceMicros(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  hostIdle();
+  hostAdvanceMicros(us);
+}
+
+// ---- Random ----
+
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed) { randomState = seed ? seed : 1; }
+
+long random(long maxValue) {
+  if (maxValue <= 0) return 0;
+  randomState = randomState * 1664525u + 1013904223u;
+  return (randomState >> 8) % maxValue;
+}
+
+long random(long minValue, long maxValue) {
+  if (maxValue <= minValue) return minValue;
+  return minValue + random(maxValue - minValue);
+}
+
+// ---- Print ----
+
+size_t Print::write(const uint8_t* data, size_t n) {
+  size_t written = 0;
+  while (n--) written += write(*data++);
+  return written;
+}
+
+size_t Print::print(long v, int base) {
+  if (base == DEC) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "%ld", v);
+    return write(buf);
+  }
+  return print((unsigned long)v, base);
+}
+
+size_t Print::print(unsigned long v, int base) {
+  char buf[40];
+  char* p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  if (base < 2) base = DEC;
+  do {
+    int digit = v % base;
+    *--p = digit < 10 ? '0' + digit : 'A' + digit - 10;
+    v /= base;
+  } while (v);
+  return write(p);
+}
+
+size_t Print::print(double v, int digits) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  return write(buf);
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (n < 0) return 0;
+  return write((const uint8_t*)buf, min<size_t>(n, sizeof(buf) - 1));
+}
@@ -0,0 +1,143 @@
+#ifndef HOST_SHIM_ARDUINO_H
+#define HOST_SHIM_ARDUINO_H
+
+// Host Arduino shim - just enough of the Arduino core to compile src/pixel and
+// lib/ on a desktop compiler for the host tests in test/
+// Time is simulated: millis()/micros() only move when a test (or delay()) moves them.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+using std::min;
+using std::max;
+
+#define PI 3.1415926535897932384626433832795
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+#define INPUT 0
+#define INPUT_PULLUP 2
+#define DEC 10
+#define HEX 16
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define IRAM_ATTR
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// ---- Time (simulated) ----
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// Host-only clock control
+void hostSetMicros(uint32_t us);
+void hostAdvanceMicros(uint32_t us);
+
+// Called while host code waits (delay(), semaphore takes) so simulated
+// peripherals can make progress; returns false when there is nothing to do
+typedef bool (*HostIdleHook)();
+void hostSetIdleHook(HostIdleHook hook);
+bool hostIdle();
+
+// ---- Random (deterministic) ----
+long random(long maxValue);
+long random(long minValue, long maxValue);
+void randomSeed(unsigned long seed);
+
+// ---- Critical sections ----
+typedef std::mutex portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) (mux)->lock()
+#define portEXIT_CRITICAL(mux) (mux)->unlock()
+#define portENTER_CRITICAL_ISR(mux) (mux)->lock()
+#define portEXIT_CRITICAL_ISR(mux) (mux)->unlock()
+
+// ---- String ----
+class String {
+public:
+  String(const char* s = "") : text(s ? s : "") {}
+  String(const std::string& s) : text(s) {}
+  String(int v) : text(std::to_string(v)) {}
+  String(unsigned int v) : text(std::to_string(v)) {}
+  String(long v) : text(std::to_string(v)) {}
+  String(unsigned long v) : text(std::to_string(v)) {}
+
+  const char* c_str() const { return text.c_str(); }
+  unsigned length() const { return text.size(); }
+  bool operator==(const String& o) const { return text == o.text; }
+  String operator+(const String& o) const { return String(text + o.text); }
+  String& operator+=(const String& o) { text += o.text; return *this; }
+
+private:
+  std::string text;
+};
+
+// ---- Print ----
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* data, size_t n);
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+  size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC);
+  size_t print(unsigned long v, int base = DEC);
+  size_t print(double v, int digits = 2);
+
+  size_t println() { return write("\r\n"); }
+  template <typename T> size_t println(T v) { return print(v) + println(); }
+  template <typename T> size_t println(T v, int format) { return print(v, format) + println(); }
+
+  size_t printf(const char* format, ...);
+};
+
+// Serial writes to stdout
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  void flush() { fflush(stdout); }
+  int available() { return 0; }
+  int read() { return -1; }
+  int availableForWrite() { return 128; }
+  operator bool() const { return true; }
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// ---- ESP ----
+
+// A 160 MHz core whose cycle counter follows the simulated clock
+class EspClass {
+public:
+  uint32_t getCycleCount() { return (uint32_t)micros() * getCpuFreqMHz(); }
+  uint32_t getCpuFreqMHz() { return 160; }
+};
+
+extern EspClass ESP;
+
+// The ESP32 core pulls FreeRTOS in with Arduino.h
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#endif // HOST_SHIM_ARDUINO_H
@@ -0,0 +1,18 @@
+#ifndef HOST_SHIM_SPI_H
+#define HOST_SHIM_SPI_H
+
+#include <Arduino.h>
+
+#define FSPI 1
+#define HSPI 2
+
+class SPIClass {
+public:
+  SPIClass(int bus = 0) {}
+  void begin(int sck = -1, int miso = -1, int mosi = -1, int ss = -1) {}
+  void end() {}
+};
+
+extern SPIClass SPI;
+
+#endif // HOST_SHIM_SPI_H
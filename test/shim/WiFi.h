@@ -0,0 +1,8 @@
+#ifndef HOST_SHIM_WIFI_H
+#define HOST_SHIM_WIFI_H
+
+// Host WiFi: nothing - the protocol header includes it for the sketches
+
+#include <Arduino.h>
+
+#endif // HOST_SHIM_WIFI_H
@@ -0,0 +1,120 @@
+#include <Arduino.h>
+#include <esp_lcd_panel_io.h>
+#include <deque>
+
+struct HostLcdIo {
+  esp_lcd_panel_io_spi_config_t config;
+};
+
+struct HostLcdTransfer {
+  int cmd;
+  const uint8_t* data;
+  size_t size;
+  uint32_t hash;   // Source contents when queued
+  uint32_t endUs;  // Simulated completion time
+};
+
+static HostLcdIo lcdIo;
+static HostLcdPanel panel;
+static std::deque<HostLcdTransfer> queue;
+static uint32_t busFreeUs = 0;  // When the last queued transfer ends
+static int16_t windowX0 = 0, windowX1 = 0, windowY0 = 0, windowY1 = 0;
+static int32_t cursor = 0;
+
+HostLcdPanel& hostLcdPanel() { return panel; }
+
+static uint32_t hashBytes(const uint8_t* data, size_t size) {
+  uint32_t h = 2166136261u;
+  for (size_t i = 0; i < size; i++) h = (h ^ data[i]) * 16777619u;
+  return h;
+}
+
+static uint32_t transferUs(size_t bytes) {
+  uint32_t hz = lcdIo.config.pclk_hz ? lcdIo.config.pclk_hz : 80000000;
+  return (uint32_t)(((uint64_t)bytes * 8 * 1000000 + hz - 1) / hz);
+}
+
+// Pixels land on the glass now, read from the source as it is at this moment
+static void complete(const HostLcdTransfer& t) {
+  if (hashBytes(t.data, t.size) != t.hash) panel.modifiedInFlight++;
+  if (t.cmd == 0x2C) cursor = 0;  // RAMWR restarts at the window origin, RAMWRC continues
+
+  int16_t windowW = windowX1 - windowX0 + 1;
+  int32_t windowPixels = (int32_t)windowW * (windowY1 - windowY0 + 1);
+  for (size_t i = 0; i + 1 < t.size && cursor < windowPixels; i += 2, cursor++) {
+    int16_t x = windowX0 + cursor % windowW;
+    int16_t y = windowY0 + cursor / windowW;
+    if (x < HOST_LCD_WIDTH && y < HOST_LCD_HEIGHT) {
+      panel.pixels[y * HOST_LCD_WIDTH + x] = (uint16_t)(t.data[i] << 8 | t.data[i + 1]);
+    }
+  }
+  panel.colorWrites++;
+  if (lcdIo.config.on_color_trans_done) {
+    lcdIo.config.on_color_trans_done(&lcdIo, nullptr, lcdIo.config.user_ctx);
+  }
+}
+
+// Complete the oldest transfer, waiting (in simulated time) for it to end
+static bool completeNext() {
+  if (queue.empty()) return false;
+  HostLcdTransfer t = queue.front();
+  queue.pop_front();
+  if ((int32_t)(t.endUs - micros()) > 0) hostSetMicros(t.endUs);
+  complete(t);
+  return true;
+}
+
+// Complete everything whose end time has passed
+static void catchUp() {
+  while (!queue.empty() && (int32_t)(queue.front().endUs - micros()) <= 0) completeNext();
+}
+
+void hostLcdReset() {
+  queue.clear();
+  memset(&panel, 0, sizeof(panel));
+  busFreeUs = micros();
+  cursor = 0;
+}
+
+void hostLcdDrain() {
+  while (completeNext()) {}
+}
+
+esp_err_t esp_lcd_new_panel_io_spi(esp_lcd_spi_bus_handle_t bus, const esp_lcd_panel_io_spi_config_t* config,
+                                   esp_lcd_panel_io_handle_t* io) {
+  lcdIo.config = *config;
+  hostLcdReset();
+  hostSetIdleHook(completeNext);
+  *io = &lcdIo;
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_io_tx_param(esp_lcd_panel_io_handle_t io, int cmd, const void* param, size_t size) {
+  // Polling transaction: waits for every queued color write first
+  hostLcdDrain();
+  hostAdvanceMicros(transferUs(1 + size));
+  busFreeUs = micros();
+
+  const uint8_t* p = (const uint8_t*)param;
+  if (size == 4 && cmd == 0x2A) {
+    windowX0 = p[0] << 8 | p[1];
+    windowX1 = p[2] << 8 | p[3];
+  } else if (size == 4 && cmd == 0x2B) {
+    windowY0 = p[0] << 8 | p[1];
+    windowY1 = p[2] << 8 | p[3];
+  }
+  panel.paramWrites++;
+  return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_io_tx_color(esp_lcd_panel_io_handle_t io, int cmd, const void* color, size_t size) {
+  catchUp();
+  while (queue.size() >= max<size_t>(io->config.trans_queue_depth, 1)) completeNext();
+
+  uint32_t start = (int32_t)(busFreeUs - micros()) > 0 ? busFreeUs : micros();
+  uint32_t duration = transferUs(size);
+  busFreeUs = start + duration;
+  panel.busyUs += duration;
+  queue.push_back({cmd, (const uint8_t*)color, size, hashBytes((const uint8_t*)color, size), busFreeUs});
+  return ESP_OK;
+}
@@ -0,0 +1,58 @@
+#ifndef HOST_SHIM_ESP_LCD_PANEL_IO_H
+#define HOST_SHIM_ESP_LCD_PANEL_IO_H
+
+// Host esp_lcd SPI panel IO - a simulated GC9A01 on a DMA SPI bus
+// Color writes are queued like the real driver: each one takes bytes * 8 / pclk_hz
+// of simulated time after the one before it, and its source memory is read when it
+// completes (as DMA would), so a buffer reused before its fence shows up as wrong
+// pixels and in `modifiedInFlight`. Parameter writes wait for the queue to drain.
+// Completions run when simulated time reaches them, or from hostIdle() while the
+// CPU waits.
+
+#include <esp_now.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct HostLcdIo* esp_lcd_panel_io_handle_t;
+typedef void* esp_lcd_spi_bus_handle_t;
+typedef struct {
+} esp_lcd_panel_io_event_data_t;
+typedef bool (*esp_lcd_panel_io_color_trans_done_cb_t)(esp_lcd_panel_io_handle_t io,
+                                                       esp_lcd_panel_io_event_data_t* edata, void* ctx);
+
+typedef struct {
+  int cs_gpio_num;
+  int dc_gpio_num;
+  int spi_mode;
+  unsigned int pclk_hz;
+  size_t trans_queue_depth;
+  esp_lcd_panel_io_color_trans_done_cb_t on_color_trans_done;
+  void* user_ctx;
+  int lcd_cmd_bits;
+  int lcd_param_bits;
+} esp_lcd_panel_io_spi_config_t;
+
+esp_err_t esp_lcd_new_panel_io_spi(esp_lcd_spi_bus_handle_t bus, const esp_lcd_panel_io_spi_config_t* config,
+                                   esp_lcd_panel_io_handle_t* io);
+esp_err_t esp_lcd_panel_io_tx_param(esp_lcd_panel_io_handle_t io, int cmd, const void* param, size_t size);
+esp_err_t esp_lcd_panel_io_tx_color(esp_lcd_panel_io_handle_t io, int cmd, const void* color, size_t size);
+
+// ---- Host-only access to the simulated panel ----
+const int16_t HOST_LCD_WIDTH = 240;
+const int16_t HOST_LCD_HEIGHT = 240;
+
+struct HostLcdPanel {
+  uint16_t pixels[HOST_LCD_WIDTH * HOST_LCD_HEIGHT];  // Host-order RGB565 on the glass
+  uint32_t colorWrites;       // Color transfers completed
+  uint32_t paramWrites;       // Command/parameter writes
+  uint32_t modifiedInFlight;  // Color transfers whose source changed before they completed
+  uint32_t busyUs;            // Simulated time the bus spent transferring
+};
+
+HostLcdPanel& hostLcdPanel();
+void hostLcdReset();
+
+// Complete every queued transfer (advancing the clock as needed)
+void hostLcdDrain();
+
+#endif // HOST_SHIM_ESP_LCD_PANEL_IO_H
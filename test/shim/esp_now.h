@@ -0,0 +1,15 @@
+#ifndef HOST_SHIM_ESP_NOW_H
+#define HOST_SHIM_ESP_NOW_H
+
+// Host ESP-NOW: types only (the protocol headers need them to compile)
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef enum { ESP_NOW_SEND_SUCCESS, ESP_NOW_SEND_FAIL } esp_now_send_status_t;
+
+#endif // HOST_SHIM_ESP_NOW_H
@@ -0,0 +1,120 @@
+#include <Arduino.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <condition_variable>
+#include <thread>
+
+struct HostSemaphore {
+  std::mutex lock;
+  std::condition_variable given;
+  UBaseType_t count;
+  UBaseType_t maxCount;
+};
+
+SemaphoreHandle_t xSemaphoreCreateBinary() { return xSemaphoreCreateCounting(1, 0); }
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+  HostSemaphore* semaphore = new HostSemaphore();
+  semaphore->count = initialCount;
+  semaphore->maxCount = maxCount;
+  return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> guard(semaphore->lock);
+      if (semaphore->count > 0) {
+        semaphore->count--;
+        return pdTRUE;
+      }
+    }
+    if (hostIdle()) continue;  // A simulated peripheral made progress
+
+    std::unique_lock<std::mutex> guard(semaphore->lock);
+    semaphore->given.wait_for(guard, std::chrono::milliseconds(1), [&] { return semaphore->count > 0; });
+    if (semaphore->count > 0) {
+      semaphore->count--;
+      return pdTRUE;
+    }
+    if (ticks != portMAX_DELAY) {
+      hostAdvanceMicros(ticks * 1000);
+      return pdFALSE;
+    }
+  }
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  std::lock_guard<std::mutex> guard(semaphore->lock);
+  if (semaphore->count >= semaphore->maxCount) return pdFALSE;
+  semaphore->count++;
+  semaphore->given.notify_one();
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken) {
+  if (woken) *woken = pdFALSE;
+  return xSemaphoreGive(semaphore);
+}
+
+// ---- Tasks ----
+
+struct HostTask {
+  std::mutex lock;
+  std::condition_variable notified;
+  uint32_t count = 0;
+  BaseType_t core = 1;
+};
+
+static thread_local HostTask* currentTask = nullptr;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  HostTask* created = new HostTask();
+  created->core = core;
+  if (handle) *handle = created;
+  std::thread thread([=] {
+    currentTask = created;
+    task(param);
+  });
+  thread.detach();
+  return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  if (!currentTask) currentTask = new HostTask();  // loop() runs on core 1, like the Arduino core
+  return currentTask;
+}
+
+BaseType_t xPortGetCoreID() { return xTaskGetCurrentTaskHandle()->core; }
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  std::lock_guard<std::mutex> guard(task->lock);
+  task->count++;
+  task->notified.notify_one();
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  HostTask* task = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> guard(task->lock);
+  auto pending = [&] { return task->count > 0; };
+  if (ticks == portMAX_DELAY) {
+    task->notified.wait(guard, pending);
+  } else {
+    task->notified.wait_for(guard, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), pending);
+  }
+
+  uint32_t count = task->count;
+  if (count > 0) task->count = clearOnExit ? 0 : count - 1;
+  return count;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth, void* param,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(task, name, stackDepth, param, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
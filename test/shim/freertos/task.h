@@ -0,0 +1,25 @@
+#ifndef HOST_SHIM_TASK_H
+#define HOST_SHIM_TASK_H
+
+// Host tasks: each task is a detached host thread with its own notification
+// count. Notification waits and vTaskDelay() block in real time and leave the
+// simulated clock alone, so a background task never moves the time a test is
+// stepping through. Threads that were not created here (the test's main thread)
+// get a handle on their first xTaskGetCurrentTaskHandle().
+
+#include "FreeRTOS.h"
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth, void* param,
+                       UBaseType_t priority, TaskHandle_t* handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xPortGetCoreID();
+void vTaskDelay(TickType_t ticks);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+
+#endif // HOST_SHIM_TASK_H
@@ -0,0 +1,236 @@
+// Async log: what one SET_ANGLES packet costs its handler with blocking Serial
+// prints against ring records, the drain task's formatting, and full-ring drops
+
+#include <thread>
+#include <vector>
+#include "host_test.h"
+#include <AsyncLog.h>
+
+// UART at 115200 baud with a 128-byte TX FIFO: a write blocks (moves the
+// simulated clock) until the FIFO has room, as Serial.print() does on the ESP32
+class UartModel : public Print {
+public:
+  static const uint32_t FIFO_BYTES = 128;
+  static const uint64_t BYTE_NS = 86806;  // 10 bits at 115200 baud
+
+  size_t write(uint8_t c) override {
+    uint64_t now = (uint64_t)micros() * 1000;
+    if (freeAtNs < now) freeAtNs = now;
+    // Room for this byte once all but FIFO_BYTES - 1 queued bytes are out
+    uint64_t roomAt = freeAtNs - min<uint64_t>(freeAtNs, (FIFO_BYTES - 1) * BYTE_NS);
+    if (roomAt > now) hostAdvanceMicros((uint32_t)((roomAt - now + 999) / 1000));
+    freeAtNs += BYTE_NS;
+    return 1;
+  }
+  using Print::write;
+
+  // Let the FIFO run empty (packets arrive ~100 ms apart)
+  void drain() { freeAtNs = 0; }
+
+private:
+  uint64_t freeAtNs = 0;
+};
+
+// Collects the drain task's lines
+class LineCapture : public Print {
+public:
+  size_t write(uint8_t c) override {
+    std::lock_guard<std::mutex> guard(lock);
+    if (c == '\n') {
+      lines.push_back(current);
+      current.clear();
+    } else if (c != '\r') {
+      current += (char)c;
+    }
+    return 1;
+  }
+  using Print::write;
+
+  // Wait (real time) until at least `count` lines arrived; the lines so far
+  std::vector<std::string> waitFor(size_t count) {
+    for (int i = 0; i < 500; i++) {
+      {
+        std::lock_guard<std::mutex> guard(lock);
+        if (lines.size() >= count) return lines;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    return lines;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> guard(lock);
+    lines.clear();
+  }
+
+private:
+  std::mutex lock;
+  std::vector<std::string> lines;
+  std::string current;
+};
+
+static LineCapture& capture() {
+  static LineCapture lines;
+  static bool started = AsyncLog::begin(lines);
+  (void)started;
+  return lines;
+}
+
+// Values of one SET_ANGLES packet
+static const uint8_t pixelId = 7;
+static const float targets[3] = {90, 180, 270};
+static const float current[3] = {45, 135, 315};
+static const uint8_t dirs[3] = {1, 2, 0};
+static const int8_t resolved[3] = {1, -1, 1};
+static const float durationSec = 2.5f;
+static const char* easingName = "Ease In-Out";
+static const uint8_t colorIndex = 3;
+static const uint8_t targetOpacity = 255;
+
+// The handler's prints before AsyncLog (debug dump and summary line)
+static void logPacketBlocking(Print& out) {
+  out.print("Pixel ");
+  out.print(pixelId);
+  out.print(": Targets=(");
+  out.print(targets[0], 0);
+  out.print(",");
+  out.print(targets[1], 0);
+  out.print(",");
+  out.print(targets[2], 0);
+  out.print(") Dirs=(");
+  out.print(dirs[0]);
+  out.print(",");
+  out.print(dirs[1]);
+  out.print(",");
+  out.print(dirs[2]);
+  out.print(") -> (");
+  out.print(resolved[0]);
+  out.print(",");
+  out.print(resolved[1]);
+  out.print(",");
+  out.print(resolved[2]);
+  out.print(") Current=(");
+  out.print(current[0], 0);
+  out.print(",");
+  out.print(current[1], 0);
+  out.print(",");
+  out.print(current[2], 0);
+  out.println(")");
+  out.print("ESP-NOW: Angles [");
+  out.print(targets[0], 0);
+  out.print("°, ");
+  out.print(targets[1], 0);
+  out.print("°, ");
+  out.print(targets[2], 0);
+  out.print("°] dur=");
+  out.print(durationSec, 2);
+  out.print("s ease=");
+  out.print(easingName);
+  out.print(" color=");
+  out.print(colorIndex);
+  out.print(" opacity=");
+  out.println(targetOpacity);
+}
+
+// The same output as ring records
+static void logPacketAsync() {
+  logRecord(LOG_LEVEL_DEBUG, "Pixel %u: Targets=(%.0f,%.0f,%.0f) Dirs=(%u,%u,%u) -> (%d,%d,%d)", pixelId,
+            targets[0], targets[1], targets[2], dirs[0], dirs[1], dirs[2], resolved[0], resolved[1], resolved[2]);
+  logRecord(LOG_LEVEL_DEBUG, "Pixel %u: Current=(%.0f,%.0f,%.0f)", pixelId, current[0], current[1], current[2]);
+  logRecord(LOG_LEVEL_INFO, "ESP-NOW: Angles [%.0f°, %.0f°, %.0f°] dur=%.2fs ease=%s color=%u opacity=%u",
+            targets[0], targets[1], targets[2], durationSec, easingName, colorIndex, targetOpacity);
+}
+
+TEST_CASE(handlerLatencyPerPacket) {
+  capture();
+  UartModel uart;
+  const int packets = 20;
+
+  // FIFO empty when the packet arrives
+  uint32_t blockedUs = 0;
+  for (int p = 0; p < packets; p++) {
+    uart.drain();
+    uint32_t start = micros();
+    logPacketBlocking(uart);
+    blockedUs += micros() - start;
+  }
+
+  // FIFO still full from the previous packet
+  uart.drain();
+  logPacketBlocking(uart);
+  uint32_t start = micros();
+  logPacketBlocking(uart);
+  uint32_t backlogUs = micros() - start;
+
+  uint32_t simulatedStart = micros();
+  HostStopwatch ringClock;
+  for (int p = 0; p < packets; p++) logPacketAsync();
+  double ringNs = ringClock.elapsedNs() / packets;
+
+  REPORT("blocking Serial: %5.2f ms/packet (FIFO empty), %5.2f ms/packet (FIFO full)", blockedUs / 1000.0 / packets,
+         backlogUs / 1000.0);
+  REPORT("ring records:    %5.0f ns/packet (host time), 0 UART waits", ringNs);
+  // Logging never waits on the UART
+  CHECK_EQ(micros() - simulatedStart, 0u);
+  CHECK(blockedUs / packets > 1000);
+  CHECK(capture().waitFor(3 * packets).size() >= 3u * packets);
+  capture().clear();
+}
+
+TEST_CASE(drainTaskFormatsLikePrintf) {
+  capture();
+  LOG_INFO("int %d unsigned %u hex %04x char %c float %7.3f string %-6s| percent %%", -42, 42u, 0xBEEF & 0xFF, 'Z',
+           3.14159f, "abc");
+  LOG_WARN("level tag, long %ld", 123456L);
+  LOG_ERROR("missing argument %d");
+  std::vector<std::string> lines = capture().waitFor(3);
+  CHECK_EQ(lines.size(), 3u);
+  if (lines.size() < 3) return;
+
+  char expected[128];
+  snprintf(expected, sizeof(expected), "int %d unsigned %u hex %04x char %c float %7.3f string %-6s| percent %%", -42,
+           42u, 0xEF, 'Z', 3.14159, "abc");
+  CHECK(lines[0] == expected);
+  CHECK(lines[1] == "[W] level tag, long 123456");
+  CHECK(lines[2] == "[E] missing argument 0");
+  capture().clear();
+}
+
+TEST_CASE(fullRingDropsAndReports) {
+  capture();
+  const uint32_t records = 200;
+  uint32_t droppedBefore = AsyncLog::dropped();
+  uint32_t stored = 0;
+  for (uint32_t i = 0; i < records; i++) {
+    LogArg arg(i);
+    stored += AsyncLog::write(LOG_LEVEL_INFO, "burst %u", &arg, 1);
+  }
+  uint32_t dropped = AsyncLog::dropped() - droppedBefore;
+  REPORT("%u records in one burst: %u kept, %u dropped", records, stored, dropped);
+  // The ring holds LOG_RING_RECORDS - 1; the drain task may empty it mid-burst
+  CHECK(stored >= LOG_RING_RECORDS - 1);
+  CHECK_EQ(stored + dropped, records);
+
+  // Every kept record comes out in order, and the drop notices add up
+  uint32_t burstLines = 0;
+  uint32_t outOfOrder = 0;
+  uint32_t reported = 0;
+  for (size_t wait = stored + (dropped ? 1 : 0); ; wait++) {
+    std::vector<std::string> lines = capture().waitFor(wait);
+    burstLines = outOfOrder = reported = 0;
+    uint32_t last = 0;
+    for (const std::string& line : lines) {
+      unsigned n;
+      if (sscanf(line.c_str(), "[log] %u records dropped", &n) == 1) reported += n;
+      if (sscanf(line.c_str(), "burst %u", &n) != 1) continue;
+      if (burstLines && n <= last) outOfOrder++;
+      last = n;
+      burstLines++;
+    }
+    if (lines.size() < wait || (burstLines == stored && reported == dropped)) break;
+  }
+  CHECK_EQ(burstLines, stored);
+  CHECK_EQ(outOfOrder, 0u);
+  CHECK_EQ(reported, dropped);
+}
@@ -0,0 +1,265 @@
+// Band renderer (pixel_c3): mode screens recorded in a display list and clock
+// frames rasterized per band must reach the panel exactly as the framebuffer
+// builds draw them, including screens too big for the display list
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/band_renderer.h"
+#include "pixel/panel_canvas.h"
+#include "pixel/dma_bus.h"
+
+static const uint8_t PIXEL_ID = 7;
+static const char* MAC_TEXT = "24:6F:28:AB:CD:EF";
+
+// ---- Mode screens, drawn as loop() draws them ----
+
+static void drawHighlightIdle(Adafruit_GFX& gfx) {
+  gfx.fillScreen(GC9A01A_BLACK);
+  fillRing(gfx, CENTER_X, CENTER_Y, 115, 119, 0x001F);
+  gfx.setTextColor(GC9A01A_WHITE);
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 60);
+  gfx.print("MAC:");
+  gfx.setCursor(10, 85);
+  gfx.print(MAC_TEXT);
+  gfx.setCursor(50, 130);
+  gfx.print("ID: ");
+  gfx.print(PIXEL_ID);
+}
+
+static void drawHighlightSelected(Adafruit_GFX& gfx) {
+  gfx.fillScreen(0x07E0);
+  gfx.setTextColor(GC9A01A_BLACK);
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 60);
+  gfx.print("MAC:");
+  gfx.setCursor(10, 85);
+  gfx.print(MAC_TEXT);
+  gfx.setCursor(50, 130);
+  gfx.print("ID: ");
+  gfx.print("?");
+}
+
+static void drawHighlightAssigned(Adafruit_GFX& gfx) {
+  gfx.fillScreen(GC9A01A_BLACK);
+  gfx.setTextColor(0x07E0);
+  gfx.setTextSize(4);
+  gfx.setCursor(80, 60);
+  gfx.print("OK");
+  gfx.setTextSize(2);
+  gfx.setCursor(20, 110);
+  gfx.print("MAC:");
+  gfx.setCursor(10, 135);
+  gfx.print(MAC_TEXT);
+  gfx.setCursor(40, 180);
+  gfx.print("ID: ");
+  gfx.print(PIXEL_ID);
+}
+
+static void drawBigSymbol(Adafruit_GFX& gfx, uint16_t bg, uint8_t size, int16_t x, const char* text) {
+  gfx.fillScreen(bg);
+  gfx.setTextColor(GC9A01A_WHITE);
+  gfx.setTextSize(size);
+  gfx.setCursor(x, 90);
+  gfx.print(text);
+}
+
+static void drawVersion(Adafruit_GFX& gfx) {
+  gfx.fillScreen(GC9A01A_MAGENTA);
+  gfx.setTextColor(GC9A01A_WHITE);
+  gfx.setTextSize(3);
+  gfx.setCursor(60, 80);
+  gfx.print("Pixel ");
+  gfx.println(PIXEL_ID);
+  gfx.setCursor(80, 130);
+  gfx.print("v");
+  gfx.print(1);
+  gfx.print(".");
+  gfx.println(34);
+}
+
+static void drawIdFlash(Adafruit_GFX& gfx) {
+  gfx.fillScreen(0x07E0);
+  gfx.setTextColor(0x0000);
+  gfx.setTextSize(8);
+  gfx.setCursor(95, 85);
+  gfx.print(PIXEL_ID);
+}
+
+static void drawOtaProgress(Adafruit_GFX& gfx) {
+  gfx.fillScreen(GC9A01A_BLUE);
+  gfx.setTextColor(GC9A01A_WHITE);
+  gfx.setTextSize(2);
+  gfx.setCursor(30, 80);
+  gfx.print("Downloading");
+  gfx.fillRect(30, 120, 180, 20, GC9A01A_BLACK);
+  gfx.fillRect(30, 120, (180 * 42) / 100, 20, GC9A01A_GREEN);
+  gfx.setCursor(90, 150);
+  gfx.print(42);
+  gfx.print("%");
+  gfx.setTextSize(1);
+  gfx.setCursor(20, 180);
+  gfx.print("HTTP error -1: connection refused");
+}
+
+// The HIGHLIGHT_IDLE border as it used to be drawn: one op per outline pixel
+static void drawConcentricRings(Adafruit_GFX& gfx) {
+  drawHighlightIdle(gfx);
+  for (int r = 115; r < 120; r++) gfx.drawCircle(CENTER_X, CENTER_Y, r, 0x001F);
+}
+
+struct ModeScreen {
+  const char* name;
+  void (*draw)(Adafruit_GFX& gfx);
+};
+
+static const ModeScreen SCREENS[] = {
+  {"highlight idle", drawHighlightIdle},
+  {"highlight selected", drawHighlightSelected},
+  {"highlight assigned", drawHighlightAssigned},
+  {"discovery waiting", [](Adafruit_GFX& gfx) { drawBigSymbol(gfx, GC9A01A_BLACK, 15, 85, "?"); }},
+  {"discovery found", [](Adafruit_GFX& gfx) { drawBigSymbol(gfx, GC9A01A_BLACK, 15, 95, "!"); }},
+  {"unprovisioned", [](Adafruit_GFX& gfx) { drawBigSymbol(gfx, 0x07E0, 15, 85, "?"); }},
+  {"error", [](Adafruit_GFX& gfx) { drawBigSymbol(gfx, GC9A01A_RED, 10, 95, "!"); }},
+  {"version", drawVersion},
+  {"id flash", drawIdFlash},
+  {"ota progress", drawOtaProgress},
+  {"concentric rings", drawConcentricRings},
+};
+
+// Stream a screen through the band renderer and count visible pixels that differ
+// from the same screen drawn on a framebuffer canvas
+static int32_t bandMismatches(const ModeScreen& screen, DisplayBus& bus, const uint16_t* panelPixels,
+                              BandRenderer& renderer, DisplayList& list, bool& complete) {
+  static uint16_t reference[DISPLAY_PIXELS];
+  PanelCanvas canvas(DISPLAY_WIDTH, DISPLAY_HEIGHT, reference);
+  screen.draw(canvas);
+
+  complete = renderer.presentScreen(bus, list, panelMask(), [&]() { screen.draw(list); });
+  bus.waitFence(bus.insertFence());
+  return countVisibleMismatches(panelPixels, reference);
+}
+
+TEST_CASE(modeScreensMatchTheFramebufferCanvas) {
+  static Adafruit_GC9A01A panel;
+  GC9A01ABus bus(panel);
+  BandRenderer renderer;
+  CHECK(renderer.begin(DISPLAY_WIDTH, DISPLAY_HEIGHT, 0));
+  static DisplayList list(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+
+  for (const ModeScreen& screen : SCREENS) {
+    // What one pass needs: the whole screen recorded into an unbounded count
+    list.setRows(0, DISPLAY_HEIGHT);
+    list.clear();
+    screen.draw(list);
+    uint16_t firstPassOps = list.size();
+    bool fitsOnce = !list.hasOverflowed();
+
+    bool complete = false;
+    int32_t mismatches = bandMismatches(screen, bus, panel.pixels, renderer, list, complete);
+    REPORT("%-18s %3u ops%s, %u pass(es), %d mismatches", screen.name, firstPassOps, fitsOnce ? "" : "+ (full)",
+           renderer.screenPasses, mismatches);
+    CHECK(complete);
+    CHECK_EQ(mismatches, 0);
+    if (fitsOnce) CHECK_EQ(renderer.screenPasses, 1);
+  }
+}
+
+TEST_CASE(highlightIdleFitsTheDisplayListOnce) {
+  static Adafruit_GC9A01A panel;
+  GC9A01ABus bus(panel);
+  BandRenderer renderer;
+  renderer.begin(DISPLAY_WIDTH, DISPLAY_HEIGHT, 0);
+  static DisplayList list(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+
+  renderer.presentScreen(bus, list, panelMask(), [&]() { drawHighlightIdle(list); });
+  CHECK_EQ(renderer.screenPasses, 1);
+  CHECK(!list.hasOverflowed());
+}
+
+TEST_CASE(overflowingScreensAreStreamedInPasses) {
+  for (uint8_t dma = 0; dma < 2; dma++) {
+    static Adafruit_GC9A01A panel;
+    GC9A01ABus adafruitBus(panel);
+    static DmaDisplayBus dmaBus(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    static bool dmaStarted = dmaBus.begin(12, 11, 10, 9, 80000000);
+    CHECK(dmaStarted);
+    hostLcdReset();
+
+    DisplayBus& bus = dma ? (DisplayBus&)dmaBus : (DisplayBus&)adafruitBus;
+    const uint16_t* pixels = dma ? hostLcdPanel().pixels : panel.pixels;
+    BandRenderer renderer;
+    renderer.begin(DISPLAY_WIDTH, DISPLAY_HEIGHT, 0);
+    static DisplayList list(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+
+    // Thousands of one-pixel ops: far more than the list holds
+    bool complete = false;
+    int32_t mismatches = bandMismatches(SCREENS[10], bus, pixels, renderer, list, complete);
+    if (dma) hostLcdDrain();
+    REPORT("%s bus: %u passes, %d mismatches", dma ? "DMA" : "Adafruit", renderer.screenPasses, mismatches);
+    CHECK(complete);
+    CHECK(renderer.screenPasses > 1);
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(list.firstRow(), 0);
+    CHECK_EQ(list.endRow(), DISPLAY_HEIGHT);
+  }
+}
+
+TEST_CASE(ringCoversTheRadiusRange) {
+  static uint16_t pixels[DISPLAY_PIXELS];
+  PanelCanvas canvas(DISPLAY_WIDTH, DISPLAY_HEIGHT, pixels);
+  canvas.fillScreen(0);
+  fillRing(canvas, CENTER_X, CENTER_Y, 115, 119, 0xFFFF);
+
+  int32_t wrong = 0;
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+    for (int16_t x = 0; x < DISPLAY_WIDTH; x++) {
+      float d = sqrtf((float)(x - CENTER_X) * (x - CENTER_X) + (float)(y - CENTER_Y) * (y - CENTER_Y));
+      bool inRing = d >= 114.5f && d < 119.5f;
+      if (inRing != (canvas.getPixel(x, y) == 0xFFFF)) wrong++;
+    }
+  }
+  CHECK_EQ(wrong, 0);
+}
+
+// Clock frames: rasterized band by band, pushed per damaged part or as full rows
+TEST_CASE(clockFramesMatchFullRedraws) {
+  for (uint8_t dma = 0; dma < 2; dma++) {
+    static Adafruit_GC9A01A panel;
+    GC9A01ABus adafruitBus(panel);
+    static DmaDisplayBus dmaBus(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    static bool dmaStarted = dmaBus.begin(12, 11, 10, 9, 80000000);
+    CHECK(dmaStarted);
+    hostLcdReset();
+
+    DisplayBus& bus = dma ? (DisplayBus&)dmaBus : (DisplayBus&)adafruitBus;
+    const uint16_t* pixels = dma ? hostLcdPanel().pixels : panel.pixels;
+    BandRenderer renderer;
+    renderer.begin(DISPLAY_WIDTH, DISPLAY_HEIGHT, 0);
+    DamageTracker panelTracker(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    CapsuleRasterizer rasterizer;
+    static uint16_t reference[DISPLAY_PIXELS];
+
+    ClockFrame frame = {{0, 90, 200}, 0x1234, 0xF800, 0xFFFF};
+    int32_t mismatches = 0;
+    for (uint16_t f = 0; f < 50; f++) {
+      frame.angles[0] = fmodf(f * 7.0f, 360);
+      frame.angles[1] = fmodf(90 + f * 13.0f, 360);
+      frame.angles[2] = fmodf(200 + f * 3.0f, 360);
+
+      FrameShapes shapes;
+      buildFrameShapes(frame, shapes);
+      DamageList damage;
+      panelTracker.computeDamage(shapes, damage);
+      panelTracker.commit(shapes);
+      prepareRasterizer(rasterizer, frame);
+      renderer.presentClock(bus, rasterizer, damage, panelMask());
+      if (dma) hostLcdDrain();
+
+      renderReference(frame, reference);
+      mismatches += countVisibleMismatches(pixels, reference);
+    }
+    REPORT("%s bus: %d mismatches over 50 frames", dma ? "DMA" : "Adafruit", mismatches);
+    CHECK_EQ(mismatches, 0);
+  }
+}
@@ -0,0 +1,172 @@
+// Capsule rasterizer: coverage follows the hands' distance field, every pixel is
+// written once, and the cost compared with the old triangle + circle drawHand()
+
+#include "host_test.h"
+#include "clock_frame.h"
+
+// Old drawHand(): two triangles and two round caps, overdrawing a full canvas
+static void drawHandLegacy(Adafruit_GFX& gfx, float cx, float cy, float angleDeg, float length, float thickness,
+                           uint16_t color) {
+  float angleRad = (angleDeg - 90.0) * PI / 180.0;
+  float perpRad = angleRad + PI / 2.0;
+  float halfThick = thickness / 2.0;
+
+  float x1 = cx + cos(perpRad) * halfThick;
+  float y1 = cy + sin(perpRad) * halfThick;
+  float x2 = cx - cos(perpRad) * halfThick;
+  float y2 = cy - sin(perpRad) * halfThick;
+  float endX = cx + cos(angleRad) * length;
+  float endY = cy + sin(angleRad) * length;
+  float x3 = endX + cos(perpRad) * halfThick;
+  float y3 = endY + sin(perpRad) * halfThick;
+  float x4 = endX - cos(perpRad) * halfThick;
+  float y4 = endY - sin(perpRad) * halfThick;
+
+  gfx.fillTriangle(x1, y1, x2, y2, x3, y3, color);
+  gfx.fillTriangle(x2, y2, x3, y3, x4, y4, color);
+  gfx.fillCircle(cx, cy, (int)halfThick, color);
+  gfx.fillCircle(endX, endY, (int)halfThick, color);
+}
+
+// Canvas that counts every pixel store
+class CountingCanvas : public GFXcanvas16 {
+public:
+  CountingCanvas() : GFXcanvas16(DISPLAY_WIDTH, DISPLAY_HEIGHT) {}
+  uint32_t written = 0;
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    written++;
+    GFXcanvas16::drawPixel(x, y, color);
+  }
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override {
+    written += abs(w);
+    GFXcanvas16::drawFastHLine(x, y, w, color);
+  }
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override {
+    written += abs(h);
+    GFXcanvas16::drawFastVLine(x, y, h, color);
+  }
+  void fillScreen(uint16_t color) override {
+    written += DISPLAY_PIXELS;
+    GFXcanvas16::fillScreen(color);
+  }
+};
+
+static void drawLegacyFrame(CountingCanvas& canvas, const ClockFrame& frame) {
+  canvas.fillScreen(frame.bg);
+  for (uint8_t i = 0; i < FRAME_HAND_COUNT; i++) {
+    drawHandLegacy(canvas, CENTER_X, CENTER_Y, frame.angles[i], HAND_LENGTH_NORMAL, HAND_THICKNESS[i],
+                   frame.handColor);
+  }
+  canvas.fillCircle(CENTER_X, CENTER_Y, CENTER_DOT_RADIUS, frame.fg);
+}
+
+// Coverage level of one capsule at a pixel, as the rasterizer defines it
+static uint8_t expectedCoverage(const Capsule& c, int16_t x, int16_t y) {
+  int16_t a = (int16_t)((c.radius + 0.5f - c.distance(x, y)) * COVERAGE_FULL + 0.5f);
+  return constrain(a, 0, COVERAGE_FULL);
+}
+
+TEST_CASE(coverageFollowsTheDistanceField) {
+  CapsuleRasterizer rasterizer;
+  static uint16_t pixels[DISPLAY_PIXELS];
+  const uint16_t bg = 0xFFFF, hand = 0x0000, fg = 0xF800;
+  int32_t wrong = 0;
+  int32_t checked = 0;
+
+  for (float angle = 0; angle < 360; angle += 7.3f) {
+    ClockFrame frame = {{angle, fmodf(angle * 2 + 40, 360), fmodf(angle * 3 + 90, 360)}, bg, fg, hand};
+    prepareRasterizer(rasterizer, frame);
+    rasterizer.render(pixels, DISPLAY_WIDTH, {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT}, panelMask());
+
+    Capsule capsules[FRAME_HAND_COUNT];
+    for (uint8_t i = 0; i < FRAME_HAND_COUNT; i++) {
+      capsules[i] = handCapsule(CENTER_X, CENTER_Y, frame.angles[i], HAND_LENGTH_NORMAL, HAND_THICKNESS[i]);
+    }
+    Capsule dot = {};
+    dot.ax = dot.bx = CENTER_X;
+    dot.ay = dot.by = CENTER_Y;
+    dot.radius = CENTER_DOT_RADIUS;
+    dot.prepare();
+
+    for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+      const CircleSpan& span = panelMask().row(y);
+      for (int16_t x = span.x; x < span.x + span.len; x++) {
+        uint8_t h = 0;
+        for (uint8_t i = 0; i < FRAME_HAND_COUNT; i++) h = max(h, expectedCoverage(capsules[i], x, y));
+        uint8_t d = expectedCoverage(dot, x, y);
+        uint16_t handOverBg = blend565(bg, hand, (h * BLEND_FULL + COVERAGE_FULL / 2) / COVERAGE_FULL);
+        uint16_t expected = blend565(handOverBg, fg, (d * BLEND_FULL + COVERAGE_FULL / 2) / COVERAGE_FULL);
+        if (fromPanelOrder(pixels[y * DISPLAY_WIDTH + x]) != expected) wrong++;
+        checked++;
+      }
+    }
+  }
+  // Span bounds come from a closed-form row intersection, the reference from
+  // per-pixel distances: they may disagree on a pixel sitting exactly on an edge
+  REPORT("%d of %d pixels differ from the per-pixel distance reference", wrong, checked);
+  CHECK((int64_t)wrong * 100000 < checked);
+}
+
+TEST_CASE(everyPixelIsWrittenOnce) {
+  CapsuleRasterizer rasterizer;
+  static uint16_t pixels[DISPLAY_PIXELS];
+  ClockFrame frame = {{30, 150, 270}, 0x0000, 0xFFFF, 0xFFFF};
+  prepareRasterizer(rasterizer, frame);
+
+  rasterizer.render(pixels, DISPLAY_WIDTH, {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT}, panelMask());
+  CHECK_EQ(rasterizer.pixelsWritten, panelMask().visiblePixels());
+
+  // A damaged rectangle: only its visible pixels, nothing outside it
+  static uint16_t guard[DISPLAY_PIXELS];
+  for (int32_t i = 0; i < DISPLAY_PIXELS; i++) pixels[i] = guard[i] = 0x5A5A;
+  Rect r = {100, 20, 50, 60};
+  rasterizer.resetStats();
+  rasterizer.render(pixels, DISPLAY_WIDTH, r, panelMask());
+  CHECK_EQ(rasterizer.pixelsWritten, (uint32_t)r.area());
+
+  int32_t outside = 0;
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+    for (int16_t x = 0; x < DISPLAY_WIDTH; x++) {
+      bool inside = x >= r.x && x < r.right() && y >= r.y && y < r.bottom();
+      if (!inside && pixels[y * DISPLAY_WIDTH + x] != guard[y * DISPLAY_WIDTH + x]) outside++;
+    }
+  }
+  CHECK_EQ(outside, 0);
+}
+
+TEST_CASE(benchmarkAgainstLegacyDrawHand) {
+  const int frames = 300;
+  static CountingCanvas canvas;
+  CapsuleRasterizer rasterizer;
+  static uint16_t pixels[DISPLAY_PIXELS];
+  ClockFrame frame = {{0, 0, 0}, 0x0000, 0xFFFF, 0xFFFF};
+
+  HostStopwatch legacyClock;
+  for (int f = 0; f < frames; f++) {
+    frame.angles[0] = f;
+    frame.angles[1] = f * 2.0f;
+    frame.angles[2] = f * 3.0f;
+    drawLegacyFrame(canvas, frame);
+  }
+  double legacyNs = legacyClock.elapsedNs() / frames;
+  uint32_t legacyWrites = canvas.written / frames;
+
+  HostStopwatch capsuleClock;
+  for (int f = 0; f < frames; f++) {
+    frame.angles[0] = f;
+    frame.angles[1] = f * 2.0f;
+    frame.angles[2] = f * 3.0f;
+    prepareRasterizer(rasterizer, frame);
+    rasterizer.render(pixels, DISPLAY_WIDTH, {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT}, panelMask());
+  }
+  double capsuleNs = capsuleClock.elapsedNs() / frames;
+  uint32_t capsuleWrites = rasterizer.pixelsWritten / frames;
+
+  REPORT("legacy drawHand: %8.0f ns/frame, %6u pixel writes/frame (aliased)", legacyNs, legacyWrites);
+  REPORT("capsule raster:  %8.0f ns/frame, %6u pixel writes/frame (anti-aliased)", capsuleNs, capsuleWrites);
+
+  // The old path fills the whole square and then overdraws the hands
+  CHECK(legacyWrites > (uint32_t)DISPLAY_PIXELS);
+  CHECK_EQ(capsuleWrites, panelMask().visiblePixels());
+}
@@ -0,0 +1,111 @@
+// Circle mask: spans cover exactly the visible disc, and masked pushes leave
+// the hidden corners off the wire
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/display_bus.h"
+
+// Bus that only counts what would go over the wire
+class CountingBus : public DisplayBus {
+public:
+  void pushWindow(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* src, int16_t stride) override {
+    if (w <= 0 || h <= 0) return;
+    bytesPushed += (uint32_t)w * h * 2 + WINDOW_OVERHEAD_BYTES;
+    windowsPushed++;
+  }
+};
+
+TEST_CASE(spansCoverExactlyTheDisc) {
+  const CircleMask& mask = panelMask();
+  int32_t wrong = 0;
+  uint32_t visible = 0;
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+    for (int16_t x = 0; x < DISPLAY_WIDTH; x++) {
+      float dx = x + 0.5f - CENTER_X;
+      float dy = y + 0.5f - CENTER_Y;
+      bool inside = dx * dx + dy * dy < (float)MAX_RADIUS * MAX_RADIUS;
+      int16_t sx = x;
+      int16_t sw = 1;
+      bool masked = mask.clipRow(y, sx, sw);
+      if (inside != masked) wrong++;
+      visible += masked;
+    }
+  }
+  CHECK_EQ(wrong, 0);
+  CHECK_EQ(mask.visiblePixels(), visible);
+  CHECK_NEAR((double)visible, PI * MAX_RADIUS * MAX_RADIUS, 2.0 * PI * MAX_RADIUS);
+  REPORT("visible %u of %d pixels (%.1f%% hidden)", visible, DISPLAY_PIXELS,
+         100.0 * (DISPLAY_PIXELS - visible) / DISPLAY_PIXELS);
+}
+
+TEST_CASE(clipRowTrimsRuns) {
+  const CircleMask& mask = panelMask();
+  const CircleSpan& top = mask.row(0);
+  CHECK(top.len > 0);
+
+  int16_t x = 0;
+  int16_t w = DISPLAY_WIDTH;
+  CHECK(mask.clipRow(0, x, w));
+  CHECK_EQ(x, top.x);
+  CHECK_EQ(w, top.len);
+
+  // Entirely in a hidden corner
+  x = 0;
+  w = 10;
+  CHECK(!mask.clipRow(0, x, w));
+
+  // Above the panel
+  x = 0;
+  w = DISPLAY_WIDTH;
+  CHECK(!mask.clipRow(-1, x, w));
+}
+
+TEST_CASE(maskedPushSavesTheCorners) {
+  static uint16_t frame[DISPLAY_PIXELS];
+  CountingBus bus;
+
+  bus.pushWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, frame, DISPLAY_WIDTH);
+  uint32_t squareBytes = bus.bytesPushed;
+
+  bus.resetStats();
+  bus.pushMaskedWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, frame, DISPLAY_WIDTH, panelMask());
+  uint32_t maskedBytes = bus.bytesPushed;
+
+  REPORT("bytes on wire per full frame: %u square, %u masked (%u windows), %.1f%% saved", squareBytes,
+         maskedBytes, bus.windowsPushed, 100.0 * (squareBytes - maskedBytes) / squareBytes);
+  CHECK_EQ(maskedBytes, panelMask().visiblePixels() * 2 + bus.windowsPushed * WINDOW_OVERHEAD_BYTES);
+  CHECK(maskedBytes * 100 < squareBytes * 82);
+}
+
+TEST_CASE(maskedPushDeliversTheVisiblePixels) {
+  static Adafruit_GC9A01A panel;
+  GC9A01ABus bus(panel);
+  static uint16_t frame[DISPLAY_PIXELS];
+  for (int32_t i = 0; i < DISPLAY_PIXELS; i++) frame[i] = toPanelOrder((uint16_t)(i * 2654435761u >> 16));
+
+  // An off-center window with a stride: only its visible part arrives, unchanged
+  Rect r = {3, 5, 200, 120};
+  memset(panel.pixels, 0, sizeof(panel.pixels));
+  bus.pushMaskedWindow(r.x, r.y, r.w, r.h, frame + r.y * DISPLAY_WIDTH + r.x, DISPLAY_WIDTH, panelMask());
+
+  int32_t wrong = 0;
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+    for (int16_t x = 0; x < DISPLAY_WIDTH; x++) {
+      int16_t sx = x;
+      int16_t sw = 1;
+      bool expected = y >= r.y && y < r.bottom() && x >= r.x && x < r.right() && panelMask().clipRow(y, sx, sw);
+      uint16_t want = expected ? fromPanelOrder(frame[y * DISPLAY_WIDTH + x]) : 0;
+      if (panel.pixel(x, y) != want) wrong++;
+    }
+  }
+  CHECK_EQ(wrong, 0);
+}
+
+TEST_CASE(rasterizerSkipsHiddenPixels) {
+  CapsuleRasterizer rasterizer;
+  static uint16_t frame[DISPLAY_PIXELS];
+  ClockFrame clock = {{0, 135, 270}, 0x0000, 0xFFFF, 0xFFFF};
+  prepareRasterizer(rasterizer, clock);
+  rasterizer.render(frame, DISPLAY_WIDTH, {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT}, panelMask());
+  CHECK_EQ(rasterizer.pixelsWritten, panelMask().visiblePixels());
+}
@@ -0,0 +1,138 @@
+// Color kernels: the packed blend against per-channel math and the old /255
+// blendColor(), the paired span fill at every alignment, and the cost of both
+
+#include "host_test.h"
+#include "pixel/color_kernels.h"
+
+// Old blendColor() from main.cpp: per-channel unpack, /255 divide, repack
+static uint16_t blendColorLegacy(uint16_t bgColor, uint16_t fgColor, uint8_t opacity) {
+  if (opacity == 255) return fgColor;
+  if (opacity == 0) return bgColor;
+
+  uint8_t bgR = (bgColor >> 11) & 0x1F;
+  uint8_t bgG = (bgColor >> 5) & 0x3F;
+  uint8_t bgB = bgColor & 0x1F;
+
+  uint8_t fgR = (fgColor >> 11) & 0x1F;
+  uint8_t fgG = (fgColor >> 5) & 0x3F;
+  uint8_t fgB = fgColor & 0x1F;
+
+  uint8_t outR = ((fgR * opacity) + (bgR * (255 - opacity))) / 255;
+  uint8_t outG = ((fgG * opacity) + (bgG * (255 - opacity))) / 255;
+  uint8_t outB = ((fgB * opacity) + (bgB * (255 - opacity))) / 255;
+
+  return (outR << 11) | (outG << 5) | outB;
+}
+
+// Largest per-channel difference between two RGB565 colors
+static int channelError(uint16_t a, uint16_t b) {
+  int r = abs((a >> 11) - (b >> 11));
+  int g = abs(((a >> 5) & 0x3F) - ((b >> 5) & 0x3F));
+  int bl = abs((a & 0x1F) - (b & 0x1F));
+  return max(r, max(g, bl));
+}
+
+TEST_CASE(packedBlendMatchesPerChannelMath) {
+  int32_t wrong = 0;
+  for (uint32_t bg = 0; bg < 65536; bg += 97) {
+    for (uint32_t fg = 0; fg < 65536; fg += 89) {
+      for (uint8_t alpha = 0; alpha <= BLEND_FULL; alpha++) {
+        uint16_t r = ((fg >> 11) * alpha + (bg >> 11) * (BLEND_FULL - alpha)) >> 5;
+        uint16_t g = (((fg >> 5) & 0x3F) * alpha + ((bg >> 5) & 0x3F) * (BLEND_FULL - alpha)) >> 5;
+        uint16_t b = ((fg & 0x1F) * alpha + (bg & 0x1F) * (BLEND_FULL - alpha)) >> 5;
+        if (blend565(bg, fg, alpha) != ((r << 11) | (g << 5) | b)) wrong++;
+      }
+    }
+  }
+  CHECK_EQ(wrong, 0);
+  CHECK_EQ(pack565(spread565(0xA5C3)), 0xA5C3);
+}
+
+TEST_CASE(opacityBlendStaysWithinOneLevelOfBlendColor) {
+  int worst = 0;
+  int32_t cases = 0;
+  for (uint32_t bg = 0; bg < 65536; bg += 251) {
+    for (uint32_t fg = 0; fg < 65536; fg += 241) {
+      for (uint16_t opacity = 0; opacity < 256; opacity++) {
+        worst = max(worst, channelError(blend565Opacity(bg, fg, opacity), blendColorLegacy(bg, fg, opacity)));
+        cases++;
+      }
+    }
+  }
+  REPORT("max channel error %d LSB over %d blends", worst, cases);
+  CHECK(worst <= 1);
+
+  // Both ends are exact, so fades start and finish on their colors
+  CHECK_EQ(opacityToBlend(0), 0);
+  CHECK_EQ(opacityToBlend(255), BLEND_FULL);
+  for (uint16_t opacity = 1; opacity < 256; opacity++) CHECK(opacityToBlend(opacity) >= opacityToBlend(opacity - 1));
+  CHECK_EQ(blend565Opacity(0x1234, 0xFEDC, 0), 0x1234);
+  CHECK_EQ(blend565Opacity(0x1234, 0xFEDC, 255), 0xFEDC);
+}
+
+TEST_CASE(spanFillStaysInsideItsSpan) {
+  const uint16_t guard = 0x5A5A;
+  const uint16_t color = 0xC0DE;
+  alignas(4) uint16_t row[48];
+  int32_t wrong = 0;
+  // Both 2-byte alignments of the first pixel, odd and even widths
+  for (int16_t start = 1; start <= 4; start++) {
+    for (int16_t w = -1; w <= 40; w++) {
+      for (uint16_t& p : row) p = guard;
+      fillSpan565(row + start, w, color);
+      for (int16_t i = 0; i < 48; i++) {
+        bool inside = i >= start && i < start + w;
+        if (row[i] != (inside ? color : guard)) wrong++;
+      }
+    }
+  }
+  CHECK_EQ(wrong, 0);
+}
+
+// Keeps benchmark results alive without printing them
+static volatile uint32_t sink;
+
+TEST_CASE(benchmarkAgainstScalarKernels) {
+  // Fill the visible rows of a 240x240 circle, as the band and mode screens do
+  const int frames = 2000;
+  static uint16_t pixels[240 * 240];
+  int16_t starts[240];
+  int16_t widths[240];
+  for (int16_t y = 0; y < 240; y++) {
+    float dy = y + 0.5f - 120;
+    widths[y] = 2 * (int16_t)sqrtf(120 * 120 - dy * dy);
+    starts[y] = 120 - widths[y] / 2;
+  }
+
+  HostStopwatch scalarFill;
+  for (int f = 0; f < frames; f++) {
+    for (int16_t y = 0; y < 240; y++) {
+      volatile uint16_t* row = pixels + y * 240 + starts[y];
+      for (int16_t x = 0; x < widths[y]; x++) row[x] = (uint16_t)f;
+    }
+  }
+  double scalarFillNs = scalarFill.elapsedNs() / frames;
+
+  HostStopwatch pairedFill;
+  for (int f = 0; f < frames; f++) {
+    for (int16_t y = 0; y < 240; y++) fillSpan565(pixels + y * 240 + starts[y], widths[y], (uint16_t)f);
+    sink = sink + pixels[f % (240 * 240)];
+  }
+  double pairedFillNs = pairedFill.elapsedNs() / frames;
+
+  const int32_t blends = 3000000;
+  uint32_t acc = 0;
+  HostStopwatch scalarBlend;
+  for (int32_t i = 0; i < blends; i++) acc += blendColorLegacy(i, i * 13, i & 255);
+  double scalarBlendNs = scalarBlend.elapsedNs() / blends;
+
+  HostStopwatch packedBlend;
+  for (int32_t i = 0; i < blends; i++) acc += blend565Opacity(i, i * 13, i & 255);
+  double packedBlendNs = packedBlend.elapsedNs() / blends;
+  sink = acc;
+
+  // The scalar fill goes through a volatile pointer so the host compiler cannot
+  // turn it into memset; on the ESP32 each 16-bit store is its own instruction
+  REPORT("circle fill: 16-bit stores %8.0f ns/frame, 32-bit pairs %8.0f ns/frame", scalarFillNs, pairedFillNs);
+  REPORT("blend:       blendColor %.2f ns, packed %.2f ns", scalarBlendNs, packedBlendNs);
+}
@@ -0,0 +1,206 @@
+// Color ramp: ramp lookups against the per-frame color math they replace, on
+// both the fixed-point (pixel_c3) and float (pixel_s3) paths
+
+#include "host_test.h"
+#include "pixel/easing.h"
+#include "pixel/color_kernels.h"
+#include "pixel/color_ramp.h"
+
+// Transition endpoints, as startTransition() leaves them
+struct RampEndpoints {
+  uint16_t startBg, targetBg;
+  uint16_t startFg, targetFg;
+  uint8_t startOpacity, targetOpacity;
+};
+
+// Old per-frame blendColor() from main.cpp, before the packed kernels
+static uint16_t blendColorLegacy(uint16_t bgColor, uint16_t fgColor, uint8_t opacity) {
+  if (opacity == 255) return fgColor;
+  if (opacity == 0) return bgColor;
+
+  uint8_t bgR = (bgColor >> 11) & 0x1F;
+  uint8_t bgG = (bgColor >> 5) & 0x3F;
+  uint8_t bgB = bgColor & 0x1F;
+
+  uint8_t fgR = (fgColor >> 11) & 0x1F;
+  uint8_t fgG = (fgColor >> 5) & 0x3F;
+  uint8_t fgB = fgColor & 0x1F;
+
+  uint8_t outR = ((fgR * opacity) + (bgR * (255 - opacity))) / 255;
+  uint8_t outG = ((fgG * opacity) + (bgG * (255 - opacity))) / 255;
+  uint8_t outB = ((fgB * opacity) + (bgB * (255 - opacity))) / 255;
+
+  return (outR << 11) | (outG << 5) | outB;
+}
+
+// main.cpp's colorsAt() on the fixed-point path
+static uint16_t lerpColorFx(uint16_t color1, uint16_t color2, q16_t t) {
+  int32_t r1 = (color1 >> 11) & 0x1F;
+  int32_t g1 = (color1 >> 5) & 0x3F;
+  int32_t b1 = color1 & 0x1F;
+
+  int32_t r = r1 + fxMul((int32_t)((color2 >> 11) & 0x1F) - r1, t);
+  int32_t g = g1 + fxMul((int32_t)((color2 >> 5) & 0x3F) - g1, t);
+  int32_t b = b1 + fxMul((int32_t)(color2 & 0x1F) - b1, t);
+
+  return ((r & 0x1F) << 11) | ((g & 0x3F) << 5) | (b & 0x1F);
+}
+
+static ColorRampEntry liveColorsFx(const RampEndpoints& e, q16_t t) {
+  q16_t easedT = fxEaseInOut(t);
+  ColorRampEntry entry;
+  entry.opacity = e.startOpacity + (e.targetOpacity - e.startOpacity) * easedT / Q16_ONE;
+  entry.bg = lerpColorFx(e.startBg, e.targetBg, easedT);
+  entry.fg = lerpColorFx(e.startFg, e.targetFg, easedT);
+  entry.hand = blendColorLegacy(entry.bg, entry.fg, entry.opacity);
+  return entry;
+}
+
+// main.cpp's colorsAt() on the float path
+static uint16_t lerpColor(uint16_t color1, uint16_t color2, float t) {
+  uint8_t r1 = (color1 >> 11) & 0x1F;
+  uint8_t g1 = (color1 >> 5) & 0x3F;
+  uint8_t b1 = color1 & 0x1F;
+
+  uint8_t r2 = (color2 >> 11) & 0x1F;
+  uint8_t g2 = (color2 >> 5) & 0x3F;
+  uint8_t b2 = color2 & 0x1F;
+
+  uint8_t r = r1 + (r2 - r1) * t;
+  uint8_t g = g1 + (g2 - g1) * t;
+  uint8_t b = b1 + (b2 - b1) * t;
+
+  return (r << 11) | (g << 5) | b;
+}
+
+static ColorRampEntry liveColors(const RampEndpoints& e, float t) {
+  float easedT = easeInOut(t);
+  ColorRampEntry entry;
+  entry.opacity = e.startOpacity + (e.targetOpacity - e.startOpacity) * easedT;
+  entry.bg = lerpColor(e.startBg, e.targetBg, easedT);
+  entry.fg = lerpColor(e.startFg, e.targetFg, easedT);
+  entry.hand = blendColorLegacy(entry.bg, entry.fg, entry.opacity);
+  return entry;
+}
+
+// Live colors at ramp half step h
+static ColorRampEntry halfStepColors(const RampEndpoints& e, bool fixedPoint, uint16_t h) {
+  ColorRampEntry entry = fixedPoint ? liveColorsFx(e, (q16_t)(((uint32_t)h << 15) / COLOR_RAMP_STEPS))
+                                    : liveColors(e, (float)h / (2 * COLOR_RAMP_STEPS));
+  entry.hand = blend565Exact(entry.bg, entry.fg, entry.opacity);
+  return entry;
+}
+
+// Ramp entries the way buildColorRamp() fills them: live math blended with
+// blend565Exact, hand colors centered on the surrounding half steps
+static void buildRamp(ColorRamp& ramp, const RampEndpoints& e, bool fixedPoint) {
+  ColorRampEntry before = halfStepColors(e, fixedPoint, 0);
+  for (uint16_t i = 0; i <= COLOR_RAMP_STEPS; i++) {
+    ColorRampEntry entry = halfStepColors(e, fixedPoint, 2 * i);
+    ColorRampEntry after = halfStepColors(e, fixedPoint, min(2 * i + 1, 2 * COLOR_RAMP_STEPS));
+    entry.hand = midrange565(before.hand, entry.hand, after.hand);
+    ramp.set(i, entry);
+    before = after;
+  }
+}
+
+// Largest per-channel difference between two RGB565 colors
+static int channelError(uint16_t a, uint16_t b) {
+  int r = abs((a >> 11) - (b >> 11));
+  int g = abs(((a >> 5) & 0x3F) - ((b >> 5) & 0x3F));
+  int bl = abs((a & 0x1F) - (b & 0x1F));
+  return max(r, max(g, bl));
+}
+
+TEST_CASE(exactBlendMatchesBlendColor) {
+  int32_t wrong = 0;
+  for (uint32_t bg = 0; bg < 65536; bg += 251) {
+    for (uint32_t fg = 0; fg < 65536; fg += 241) {
+      for (uint16_t opacity = 0; opacity < 256; opacity++) {
+        if (blend565Exact(bg, fg, opacity) != blendColorLegacy(bg, fg, opacity)) wrong++;
+      }
+    }
+  }
+  CHECK_EQ(wrong, 0);
+}
+
+TEST_CASE(rampStaysCloseToTheLiveColors) {
+  fxMathBegin();
+  srand(24);
+  static ColorRamp ramp;
+  const int transitions = 3000;
+  const int samples = 2000;
+
+  for (uint8_t fixedPoint = 0; fixedPoint < 2; fixedPoint++) {
+    int worstBg = 0, worstFg = 0, worstHand = 0, worstOpacity = 0;
+    int32_t wrongSteps = 0;
+    for (int n = 0; n < transitions; n++) {
+      RampEndpoints e = {(uint16_t)rand(), (uint16_t)rand(), (uint16_t)rand(), (uint16_t)rand(),
+                         (uint8_t)rand(), (uint8_t)rand()};
+      // A third of them fade black to white, the widest per-channel sweep
+      if (n % 3 == 0) {
+        e.startBg = 0x0000;
+        e.targetBg = 0xFFFF;
+      }
+      buildRamp(ramp, e, fixedPoint);
+
+      // Every step is the live value at its own progress (the hand is centered instead)
+      for (uint16_t i = 0; i <= COLOR_RAMP_STEPS; i++) {
+        ColorRampEntry live = fixedPoint ? liveColorsFx(e, (q16_t)(((uint32_t)i << 16) / COLOR_RAMP_STEPS))
+                                         : liveColors(e, (float)i / COLOR_RAMP_STEPS);
+        const ColorRampEntry& step = fixedPoint ? ramp.at((q16_t)(((uint32_t)i << 16) / COLOR_RAMP_STEPS))
+                                                : ramp.at((float)i / COLOR_RAMP_STEPS);
+        if (step.bg != live.bg || step.fg != live.fg || step.opacity != live.opacity) {
+          wrongSteps++;
+        }
+      }
+
+      // Anywhere in between, the nearest step
+      for (int k = 0; k <= samples; k++) {
+        ColorRampEntry live;
+        ColorRampEntry step;
+        if (fixedPoint) {
+          q16_t t = (q16_t)((int64_t)k * Q16_ONE / samples);
+          live = liveColorsFx(e, t);
+          step = ramp.at(t);
+        } else {
+          float t = (float)k / samples;
+          live = liveColors(e, t);
+          step = ramp.at(t);
+        }
+        worstBg = max(worstBg, channelError(step.bg, live.bg));
+        worstFg = max(worstFg, channelError(step.fg, live.fg));
+        worstHand = max(worstHand, channelError(step.hand, live.hand));
+        worstOpacity = max(worstOpacity, abs(step.opacity - live.opacity));
+      }
+    }
+    REPORT("%s: max difference bg %d, fg %d, hand %d levels, opacity %d", fixedPoint ? "fixed" : "float",
+           worstBg, worstFg, worstHand, worstOpacity);
+    CHECK_EQ(wrongSteps, 0);
+    CHECK(worstBg <= 1 && worstFg <= 1 && worstOpacity <= 1);
+    CHECK(worstHand <= 1);
+  }
+}
+
+TEST_CASE(midrangeCentersEachChannel) {
+  CHECK_EQ(midrange565(0x0000, 0x0000, 0x0000), 0x0000);
+  CHECK_EQ(midrange565(0xFFFF, 0x0000, 0x0000), (16 << 11) | (32 << 5) | 16);
+  CHECK_EQ(midrange565((3 << 11) | (10 << 5) | 7, (5 << 11) | (8 << 5) | 7, (4 << 11) | (9 << 5) | 8),
+           (4 << 11) | (9 << 5) | 8);
+}
+
+TEST_CASE(rampEndsOnTheTargets) {
+  fxMathBegin();
+  static ColorRamp ramp;
+  RampEndpoints e = {0x0000, 0xFFFF, 0xF800, 0x001F, 255, 40};
+  for (uint8_t fixedPoint = 0; fixedPoint < 2; fixedPoint++) {
+    buildRamp(ramp, e, fixedPoint);
+    const ColorRampEntry& end = fixedPoint ? ramp.at(Q16_ONE) : ramp.at(1.0f);
+    CHECK_EQ(end.bg, e.targetBg);
+    CHECK_EQ(end.fg, e.targetFg);
+    CHECK_EQ(end.opacity, e.targetOpacity);
+    CHECK(channelError(end.hand, blendColorLegacy(e.targetBg, e.targetFg, e.targetOpacity)) <= 1);
+    // Past the end still reads the last step
+    CHECK_EQ((fixedPoint ? ramp.at(Q16_ONE + 1000) : ramp.at(1.5f)).bg, e.targetBg);
+  }
+}
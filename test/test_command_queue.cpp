@@ -0,0 +1,101 @@
+// Command queue: a producer thread flooding the ring while the consumer drains
+// it, the way the WiFi task and loop() share it, plus the capacity limit
+
+#include <thread>
+#include "host_test.h"
+#include "pixel/command_queue.h"
+
+// Packet-sized command whose every byte is derivable from its sequence number,
+// so a torn or reordered copy shows up
+struct TestCommand {
+  uint32_t seq;
+  uint8_t body[248];
+  uint32_t check;
+};
+
+static TestCommand makeCommand(uint32_t seq) {
+  TestCommand c;
+  c.seq = seq;
+  memset(c.body, seq & 0xFF, sizeof(c.body));
+  c.check = ~seq;
+  return c;
+}
+
+static bool isIntact(const TestCommand& c, uint32_t seq) {
+  if (c.seq != seq || c.check != ~seq) return false;
+  for (uint8_t b : c.body) {
+    if (b != (seq & 0xFF)) return false;
+  }
+  return true;
+}
+
+TEST_CASE(everyCommandArrivesIntactAndInOrder) {
+  static CommandQueue<TestCommand, 16> queue;
+  const uint32_t commands = 200000;
+
+  // Producer: retries a full ring, like a sender that resends lost packets
+  std::thread producer([&]() {
+    for (uint32_t i = 0; i < commands; i++) {
+      TestCommand c = makeCommand(i);
+      while (!queue.push(c)) std::this_thread::yield();
+    }
+  });
+
+  uint32_t received = 0;
+  uint32_t broken = 0;
+  TestCommand c;
+  HostStopwatch clock;
+  while (received < commands) {
+    if (!queue.pop(c)) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (!isIntact(c, received)) broken++;
+    received++;
+  }
+  double ns = clock.elapsedNs() / commands;
+  producer.join();
+
+  REPORT("%u commands, %u torn or out of order, %u pushes hit a full ring, %.0f ns/command", received, broken,
+         (uint32_t)queue.dropped, ns);
+  CHECK_EQ(broken, 0u);
+  CHECK(queue.isEmpty());
+}
+
+TEST_CASE(fullRingRejectsAndCounts) {
+  static CommandQueue<TestCommand, 16> queue;
+  uint8_t accepted = 0;
+  for (uint32_t i = 0; i < 16; i++) accepted += queue.push(makeCommand(i));
+  CHECK_EQ(accepted, 16);
+  CHECK(!queue.push(makeCommand(16)));
+  CHECK_EQ((uint32_t)queue.dropped, 1u);
+
+  // The rejected push did not overwrite anything; one pop makes room again
+  TestCommand c;
+  CHECK(queue.pop(c));
+  CHECK(isIntact(c, 0));
+  CHECK(queue.push(makeCommand(16)));
+  for (uint32_t i = 1; i <= 16; i++) {
+    CHECK(queue.pop(c));
+    CHECK(isIntact(c, i));
+  }
+  CHECK(!queue.pop(c));
+}
+
+TEST_CASE(indicesWrapPastTheirWidth) {
+  // uint8_t indices roll over every 256 pushes; keep the ring part-full across it
+  static CommandQueue<TestCommand, 16> queue;
+  TestCommand c;
+  uint32_t next = 0;
+  uint32_t wrong = 0;
+  for (uint32_t i = 0; i < 1000; i++) {
+    queue.push(makeCommand(i));
+    if (i % 3 != 2) continue;
+    while (queue.pop(c)) {
+      if (!isIntact(c, next)) wrong++;
+      next++;
+    }
+  }
+  CHECK_EQ(wrong, 0u);
+  CHECK_EQ(next, 999u);
+}
@@ -0,0 +1,158 @@
+// Damage tracking: partial pushes leave the panel identical to full frames
+// while sending a fraction of the bytes
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/frame_buffers.h"
+
+static const uint32_t FULL_FRAME_BYTES = (uint32_t)DISPLAY_PIXELS * 2 + WINDOW_OVERHEAD_BYTES;
+
+TEST_CASE(damageListKeepsRectanglesDisjoint) {
+  DamageList list;
+  list.screen = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+  list.clear();
+
+  list.add({10, 10, 20, 20});
+  list.add({100, 100, 10, 10});
+  CHECK_EQ(list.count, 2);
+
+  // Overlaps the first: merged into its bounding box
+  list.add({25, 25, 10, 10});
+  CHECK_EQ(list.count, 2);
+  for (uint8_t i = 0; i < list.count; i++) {
+    for (uint8_t j = i + 1; j < list.count; j++) CHECK(!list.rects[i].intersects(list.rects[j]));
+  }
+  CHECK_EQ(list.area(), 25 * 25 + 10 * 10);
+
+  // Clipped to the screen, empty rectangles ignored
+  list.add({230, -5, 20, 10});
+  CHECK(list.rects[list.count - 1] == (Rect{230, 0, 10, 5}));
+  uint8_t before = list.count;
+  list.add({300, 300, 10, 10});
+  CHECK_EQ(list.count, before);
+}
+
+TEST_CASE(damageListFallsBackToFullScreen) {
+  DamageList list;
+  list.screen = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+  list.clear();
+  for (int16_t i = 0; i <= MAX_DAMAGE_RECTS; i++) list.add({(int16_t)(i * 30), 0, 10, 10});
+  CHECK(list.full);
+  CHECK_EQ(list.count, 1);
+  CHECK_EQ(list.area(), DISPLAY_PIXELS);
+}
+
+TEST_CASE(trackerReportsOnlyWhatChanged) {
+  DamageTracker tracker(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  ClockFrame frame = {{0, 120, 240}, 0x0000, 0xFFFF, 0xFFFF};
+  FrameShapes shapes;
+  DamageList damage;
+
+  // Unknown panel contents: everything
+  buildFrameShapes(frame, shapes);
+  tracker.computeDamage(shapes, damage);
+  CHECK(damage.full);
+  tracker.commit(shapes);
+
+  // Same frame again: nothing
+  tracker.computeDamage(shapes, damage);
+  CHECK(damage.isEmpty());
+
+  // One hand moves: the union of its old and new boxes
+  FrameShapes moved;
+  frame.angles[1] = 125;
+  buildFrameShapes(frame, moved);
+  tracker.computeDamage(moved, damage);
+  CHECK_EQ(damage.count, 1);
+  CHECK(damage.rects[0] == shapes.handRects[1].unite(moved.handRects[1]));
+
+  // Background change: everything
+  frame.bg = 0x1234;
+  buildFrameShapes(frame, moved);
+  tracker.computeDamage(moved, damage);
+  CHECK(damage.full);
+}
+
+// Draw and present frames the way loop() does, through the real GC9A01A bus
+// into the shim panel, and compare every visible pixel with a full redraw
+static void runSweep(uint8_t bufferCount, uint16_t frames, float degreesPerFrame,
+                     uint32_t& bytesPerFrame, int32_t& mismatches) {
+  static Adafruit_GC9A01A panel;
+  GC9A01ABus bus(panel);
+  FrameBuffers buffers;
+  CHECK_EQ(buffers.begin(bufferCount, DISPLAY_WIDTH, DISPLAY_HEIGHT, 0), bufferCount);
+
+  DamageTracker panelTracker(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  static uint16_t reference[DISPLAY_PIXELS];
+  const CircleMask& mask = panelMask();
+  CapsuleRasterizer rasterizer;
+
+  ClockFrame frame = {{0, 90, 200}, 0x0000, 0xFFFF, 0xC618};
+  uint32_t sweepBytes = 0;
+  mismatches = 0;
+
+  for (uint16_t f = 0; f < frames; f++) {
+    frame.angles[0] = fmodf(f * degreesPerFrame, 360.0f);
+    frame.angles[1] = fmodf(90 + f * degreesPerFrame * 0.5f, 360.0f);
+    if (f == frames / 2) frame.handColor = 0x07E0;  // Color change mid-way repaints all hands
+
+    FrameShapes shapes;
+    buildFrameShapes(frame, shapes);
+    DamageList pushDamage;
+    panelTracker.computeDamage(shapes, pushDamage);
+    if (pushDamage.isEmpty()) continue;
+
+    DamageList drawDamage;
+    buffers.contents().computeDamage(shapes, drawDamage);
+    prepareRasterizer(rasterizer, frame);
+    for (uint8_t i = 0; i < drawDamage.count; i++) {
+      rasterizer.render(buffers.canvas()->getBuffer(), DISPLAY_WIDTH, drawDamage.rects[i], mask);
+    }
+    buffers.contents().commit(shapes);
+    panelTracker.commit(shapes);
+
+    bus.resetStats();
+    buffers.present(bus, pushDamage, mask);
+    if (f > 0) sweepBytes += bus.bytesPushed;
+
+    renderReference(frame, reference);
+    mismatches += countVisibleMismatches(panel.pixels, reference);
+  }
+  bytesPerFrame = sweepBytes / (frames - 1);
+}
+
+TEST_CASE(partialPushesMatchFullFrames) {
+  for (uint8_t buffers = 1; buffers <= MAX_FRAME_BUFFERS; buffers++) {
+    uint32_t bytesPerFrame;
+    int32_t mismatches;
+    runSweep(buffers, 120, 3.0f, bytesPerFrame, mismatches);
+    CHECK_EQ(mismatches, 0);
+    REPORT("%u buffer(s): %u bytes/frame vs %u full frame (%.1f%%)", buffers, bytesPerFrame,
+           FULL_FRAME_BYTES, 100.0 * bytesPerFrame / FULL_FRAME_BYTES);
+
+    // Two hands moving a few degrees: well under a quarter of a full frame
+    CHECK(bytesPerFrame * 4 < FULL_FRAME_BYTES);
+  }
+}
+
+TEST_CASE(idleFramesPushNothing) {
+  static Adafruit_GC9A01A panel;
+  GC9A01ABus bus(panel);
+  FrameBuffers buffers;
+  buffers.begin(1, DISPLAY_WIDTH, DISPLAY_HEIGHT, 0);
+  DamageTracker panelTracker(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+
+  ClockFrame frame = {{10, 20, 30}, 0x0000, 0xFFFF, 0xFFFF};
+  FrameShapes shapes;
+  buildFrameShapes(frame, shapes);
+  DamageList damage;
+  panelTracker.computeDamage(shapes, damage);
+  buffers.present(bus, damage, panelMask());
+  panelTracker.commit(shapes);
+
+  bus.resetStats();
+  panelTracker.computeDamage(shapes, damage);
+  buffers.present(bus, damage, panelMask());
+  CHECK_EQ(bus.bytesPushed, 0);
+  CHECK_EQ(bus.windowsPushed, 0);
+}
@@ -0,0 +1,150 @@
+// DMA bus and double buffering against a simulated SPI panel (shim/esp_lcd_panel_io)
+// Transfers take real bus time in simulated microseconds, so the overlap of
+// rendering and pushing can be measured, and a buffer reused before its fence
+// would be caught.
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/dma_bus.h"
+#include "pixel/frame_buffers.h"
+
+static const uint32_t SPI_CLOCK_HZ = 80000000;
+
+static DmaDisplayBus& dmaBus() {
+  static DmaDisplayBus bus(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  static bool started = false;
+  if (!started) {
+    CHECK(bus.begin(12, 11, 10, 9, SPI_CLOCK_HZ));
+    started = true;
+  }
+  hostLcdReset();
+  bus.resetStats();
+  return bus;
+}
+
+static void fillPattern(uint16_t* pixels, int32_t count, uint32_t seed) {
+  for (int32_t i = 0; i < count; i++) pixels[i] = (uint16_t)((i + seed) * 2654435761u >> 13);
+}
+
+TEST_CASE(stridedSourcesArriveIntact) {
+  DmaDisplayBus& bus = dmaBus();
+  const int16_t stride = 256;  // Rows padded beyond the panel width
+  static uint16_t source[stride * DISPLAY_HEIGHT];
+  fillPattern(source, stride * DISPLAY_HEIGHT, 7);
+
+  // A window in the middle of the screen: the bus widens it to full rows
+  Rect r = {17, 30, 100, 50};
+  bus.pushMaskedWindow(r.x, r.y, r.w, r.h, source + r.y * stride + r.x, stride, panelMask());
+  bus.waitFence(bus.insertFence());
+
+  int32_t wrong = 0;
+  for (int16_t y = r.y; y < r.bottom(); y++) {
+    for (int16_t x = 0; x < DISPLAY_WIDTH; x++) {
+      if (hostLcdPanel().pixels[y * DISPLAY_WIDTH + x] != fromPanelOrder(source[y * stride + x])) wrong++;
+    }
+  }
+  CHECK_EQ(wrong, 0);
+  CHECK_EQ(bus.bytesPushed, (uint32_t)DISPLAY_WIDTH * r.h * 2 + WINDOW_OVERHEAD_BYTES);
+  CHECK_EQ(hostLcdPanel().modifiedInFlight, 0);
+}
+
+TEST_CASE(fullyHiddenRowsAreNotSent) {
+  DmaDisplayBus& bus = dmaBus();
+  static CircleMask small;
+  small.build(CENTER_X, CENTER_Y, 60, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  static uint16_t source[DISPLAY_PIXELS];
+
+  bus.pushMaskedWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, source, DISPLAY_WIDTH, small);
+  bus.waitFence(bus.insertFence());
+
+  int16_t visibleRows = 0;
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) visibleRows += small.row(y).len > 0;
+  CHECK_EQ(visibleRows, 120);
+  CHECK_EQ(bus.bytesPushed, (uint32_t)DISPLAY_WIDTH * visibleRows * 2 + WINDOW_OVERHEAD_BYTES);
+}
+
+// Full frames with a simulated render time, through FrameBuffers as loop() uses them
+// Returns the simulated microseconds per frame
+static uint32_t runFullFrames(uint8_t bufferCount, uint32_t renderUs, uint16_t frames) {
+  DmaDisplayBus& bus = dmaBus();
+  FrameBuffers buffers;
+  CHECK_EQ(buffers.begin(bufferCount, DISPLAY_WIDTH, DISPLAY_HEIGHT, 0), bufferCount);
+
+  DamageList all;
+  all.screen = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+  all.setFull();
+  ClockFrame frame = {{0, 120, 240}, 0x0000, 0xFFFF, 0xFFFF};
+  CapsuleRasterizer rasterizer;
+
+  uint32_t start = micros();
+  for (uint16_t f = 0; f < frames; f++) {
+    frame.bg = (uint16_t)(f * 0x0841);
+    frame.angles[0] = f * 6.0f;
+    prepareRasterizer(rasterizer, frame);
+    rasterizer.render(buffers.canvas()->getBuffer(), DISPLAY_WIDTH, all.screen, panelMask());
+    hostAdvanceMicros(renderUs);
+    buffers.present(bus, all, panelMask());
+  }
+  uint32_t perFrame = (micros() - start) / frames;
+
+  // Every frame was read by the bus only after it was complete, and the last one is on the glass
+  hostLcdDrain();
+  static uint16_t reference[DISPLAY_PIXELS];
+  renderReference(frame, reference);
+  CHECK_EQ(countVisibleMismatches(hostLcdPanel().pixels, reference), 0);
+  CHECK_EQ(hostLcdPanel().modifiedInFlight, 0);
+  return perFrame;
+}
+
+TEST_CASE(doubleBufferingOverlapsRenderAndTransfer) {
+  const uint32_t renderUs = 9000;
+  uint32_t transferUs = (uint32_t)((uint64_t)DISPLAY_PIXELS * 16 * 1000000 / SPI_CLOCK_HZ);
+
+  uint32_t single = runFullFrames(1, renderUs, 30);
+  uint32_t dual = runFullFrames(2, renderUs, 30);
+  REPORT("render %.1f ms + transfer %.1f ms per full frame @ %u MHz", renderUs / 1000.0, transferUs / 1000.0,
+         SPI_CLOCK_HZ / 1000000);
+  REPORT("1 buffer: %.2f ms/frame (%.1f FPS), 2 buffers: %.2f ms/frame (%.1f FPS)", single / 1000.0,
+         1e6 / single, dual / 1000.0, 1e6 / dual);
+
+  // Serial: render + transfer. Overlapped: bounded by the slower of the two
+  CHECK(single >= renderUs + transferUs);
+  CHECK(dual < max(renderUs, transferUs) * 11 / 10);
+}
+
+TEST_CASE(partialFramesMatchFullFrames) {
+  DmaDisplayBus& bus = dmaBus();
+  FrameBuffers buffers;
+  buffers.begin(2, DISPLAY_WIDTH, DISPLAY_HEIGHT, 0);
+  DamageTracker panelTracker(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  static uint16_t reference[DISPLAY_PIXELS];
+  CapsuleRasterizer rasterizer;
+
+  ClockFrame frame = {{0, 90, 200}, 0x0000, 0xFFFF, 0xC618};
+  int32_t mismatches = 0;
+  for (uint16_t f = 0; f < 60; f++) {
+    frame.angles[0] = f * 4.0f;
+    frame.angles[2] = 200 - f * 2.0f;
+
+    FrameShapes shapes;
+    buildFrameShapes(frame, shapes);
+    DamageList pushDamage;
+    panelTracker.computeDamage(shapes, pushDamage);
+    DamageList drawDamage;
+    buffers.contents().computeDamage(shapes, drawDamage);
+    prepareRasterizer(rasterizer, frame);
+    for (uint8_t i = 0; i < drawDamage.count; i++) {
+      rasterizer.render(buffers.canvas()->getBuffer(), DISPLAY_WIDTH, drawDamage.rects[i], panelMask());
+    }
+    buffers.contents().commit(shapes);
+    panelTracker.commit(shapes);
+    buffers.present(bus, pushDamage, panelMask());
+    hostAdvanceMicros(2000);
+
+    hostLcdDrain();
+    renderReference(frame, reference);
+    mismatches += countVisibleMismatches(hostLcdPanel().pixels, reference);
+  }
+  CHECK_EQ(mismatches, 0);
+  CHECK_EQ(hostLcdPanel().modifiedInFlight, 0);
+}
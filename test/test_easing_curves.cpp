@@ -0,0 +1,134 @@
+// Uploaded easing curves (built twice: float, and Q16 tables with
+// USE_FIXED_POINT_MATH): baked Bezier and sampled curves against their analytic
+// definitions, rejected uploads and empty slots
+
+#include "host_test.h"
+#include "pixel/easing_curves.h"
+
+// CSS cubic-bezier(x1, y1, x2, y2), solved to double precision
+static double bezierAt(double s, double p1, double p2) {
+  double u = 1 - s;
+  return 3 * u * u * s * p1 + 3 * u * s * s * p2 + s * s * s;
+}
+
+static double cssBezier(double x, double x1, double y1, double x2, double y2) {
+  double lo = 0;
+  double hi = 1;
+  for (uint8_t i = 0; i < 60; i++) {
+    double mid = (lo + hi) / 2;
+    (bezierAt(mid, x1, x2) < x ? lo : hi) = mid;
+  }
+  return bezierAt((lo + hi) / 2, y1, y2);
+}
+
+static double toDouble(easing_value_t v) {
+#ifdef USE_FIXED_POINT_MATH
+  return v / 65536.0;
+#else
+  return v;
+#endif
+}
+
+static easing_value_t fromDouble(double t) {
+#ifdef USE_FIXED_POINT_MATH
+  return (easing_value_t)lround(t * 65536);
+#else
+  return (easing_value_t)t;
+#endif
+}
+
+static double ease(double x) { return cssBezier(x, 0.25, 0.1, 0.25, 1.0); }
+static double sharpOut(double x) { return cssBezier(x, 0.16, 1.0, 0.3, 1.0); }
+static double overshoot(double x) { return cssBezier(x, 0.34, 1.56, 0.64, 1.0); }
+static double sineInOut(double x) { return -(cos(M_PI * x) - 1) / 2; }
+static double backOut(double x) {
+  const double c1 = 1.70158;
+  return 1 + (c1 + 1) * pow(x - 1, 3) + c1 * pow(x - 1, 2);
+}
+static double threeTicks(double t) {
+  double x = 3 * t;
+  double k = min(floor(x), 2.0);
+  double f = x - k;
+  return (k + f * f * (3 - 2 * f)) / 3;
+}
+
+// Worst error of a slot against its definition at 10001 points
+static double worstError(const EasingCurves& curves, TransitionType transition, double (*curve)(double)) {
+  double worst = 0;
+  for (uint16_t i = 0; i <= 10000; i++) {
+    double t = i / 10000.0;
+    worst = max(worst, fabs(toDouble(curves.evaluate(transition, fromDouble(t))) - curve(t)));
+  }
+  return worst;
+}
+
+TEST_CASE(bakedCurvesMatchTheirDefinitions) {
+  EasingCurves curves;
+  ESPNowPacket packet;
+  struct BezierCurve {
+    const char* name;
+    float x1, y1, x2, y2;
+    double (*curve)(double);
+  };
+  const BezierCurve beziers[] = {
+    {"Bezier ease (0.25,0.1,0.25,1)", 0.25f, 0.1f, 0.25f, 1.0f, ease},
+    {"Bezier sharp out (0.16,1,0.3,1)", 0.16f, 1.0f, 0.3f, 1.0f, sharpOut},
+    {"Bezier overshoot (0.34,1.56,0.64,1)", 0.34f, 1.56f, 0.64f, 1.0f, overshoot},
+  };
+  double worst = 0;
+  for (uint8_t slot = 0; slot < 3; slot++) {
+    const BezierCurve& b = beziers[slot];
+    packet.easingUpload.setBezier(slot, b.x1, b.y1, b.x2, b.y2);
+    CHECK(curves.upload(packet.easingUpload));
+    double error = worstError(curves, (TransitionType)(TRANSITION_CUSTOM_1 + slot), b.curve);
+    REPORT("%-38s max %.5f (%.2f deg on a full turn)", b.name, error, error * 360);
+    worst = max(worst, error);
+  }
+
+  struct SampledCurve {
+    const char* name;
+    double (*curve)(double);
+  };
+  const SampledCurve sampled[] = {
+    {"64 samples: ease-in-out sine", sineInOut},
+    {"64 samples: back-out", backOut},
+    {"64 samples: three ticks", threeTicks},
+  };
+  for (const SampledCurve& s : sampled) {
+    packet.easingUpload.setSampled(3);
+    for (uint8_t i = 0; i < EASING_CURVE_SAMPLES; i++) {
+      packet.easingUpload.setSample(i, s.curve(i / (double)(EASING_CURVE_SAMPLES - 1)));
+    }
+    CHECK(curves.upload(packet.easingUpload));
+    double error = worstError(curves, TRANSITION_CUSTOM_4, s.curve);
+    REPORT("%-38s max %.5f (%.2f deg on a full turn)", s.name, error, error * 360);
+    worst = max(worst, error);
+  }
+  CHECK(worst < 0.001);
+}
+
+TEST_CASE(invalidUploadsAreRejected) {
+  EasingCurves curves;
+  ESPNowPacket packet;
+  packet.easingUpload.setBezier(0, 1.5f, 0, 0.5f, 1);  // x1 outside 0..1
+  CHECK(!curves.upload(packet.easingUpload));
+  packet.easingUpload.setBezier(EASING_SLOTS, 0.5f, 0, 0.5f, 1);
+  CHECK(!curves.upload(packet.easingUpload));
+  packet.easingUpload.setBezier(0, 0.5f, 0, 0.5f, 1);
+  packet.easingUpload.format = (EasingCurveFormat)7;  // Unknown format
+  CHECK(!curves.upload(packet.easingUpload));
+  for (uint8_t slot = 0; slot < EASING_SLOTS; slot++) CHECK(!curves.isLoaded(slot));
+}
+
+TEST_CASE(emptySlotEasesLinearly) {
+  EasingCurves curves;
+  ESPNowPacket packet;
+  packet.easingUpload.setBezier(0, 0.25f, 0.1f, 0.25f, 1.0f);
+  CHECK(curves.upload(packet.easingUpload));
+  for (double t : {0.0, 0.3, 0.75, 1.0}) {
+    CHECK(fabs(toDouble(curves.evaluate(TRANSITION_CUSTOM_2, fromDouble(t))) - t) < 1e-4);
+  }
+  // Progress outside 0..1 clamps to the curve's ends
+  CHECK(fabs(toDouble(curves.evaluate(TRANSITION_CUSTOM_1, fromDouble(-0.5)))) < 1e-3);
+  CHECK(fabs(toDouble(curves.evaluate(TRANSITION_CUSTOM_1, fromDouble(1.5))) - 1) < 1e-3);
+}
@@ -0,0 +1,109 @@
+// Fixed-point math (built with USE_FIXED_POINT_MATH, as pixel_c3): trig and
+// easing against the float code they replace, angle wrapping, and the cost of both
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/easing.h"
+#include "pixel/fixed_math.h"
+
+static const TransitionType EASINGS[] = {
+  TRANSITION_LINEAR, TRANSITION_EASE_IN_OUT, TRANSITION_ELASTIC, TRANSITION_BOUNCE,
+  TRANSITION_BACK_IN, TRANSITION_BACK_OUT, TRANSITION_BACK_IN_OUT, TRANSITION_INSTANT,
+};
+
+TEST_CASE(sinAndCosMatchTheLibrary) {
+  fxMathBegin();
+  double worst = 0;
+  // Several turns either side of zero, off the table steps
+  for (int32_t a = -4 * FX_FULL_TURN; a < 4 * FX_FULL_TURN; a += 13) {
+    double rad = a / (double)FX_ANGLE_ONE * M_PI / 180.0;
+    worst = max(worst, fabs(fxToFloat(fxSin(a)) - sin(rad)));
+    worst = max(worst, fabs(fxToFloat(fxCos(a)) - cos(rad)));
+  }
+  REPORT("sin/cos max error %.2e", worst);
+  CHECK(worst < 2.5e-5);
+
+  // Exact at the quadrant boundaries
+  CHECK_EQ(fxSin(0), 0);
+  CHECK_EQ(fxSin(FX_QUARTER_TURN), Q16_ONE);
+  CHECK_EQ(fxSin(2 * FX_QUARTER_TURN), 0);
+  CHECK_EQ(fxSin(3 * FX_QUARTER_TURN), -Q16_ONE);
+  CHECK_EQ(fxCos(0), Q16_ONE);
+}
+
+TEST_CASE(easingMatchesTheFloatCurves) {
+  fxMathBegin();
+  double overall = 0;
+  for (TransitionType easing : EASINGS) {
+    double worst = 0;
+    for (q16_t t = 0; t <= Q16_ONE; t += 7) {
+      worst = max(worst, (double)fabsf(fxToFloat(fxApplyEasing(t, easing)) - applyEasing(fxToFloat(t), easing)));
+    }
+    // Both ends land exactly, so a transition finishes on its target
+    CHECK_EQ(fxApplyEasing(Q16_ONE, easing), Q16_ONE);
+    REPORT("%-12s max error %.2e", getTransitionName(easing), worst);
+    overall = max(overall, worst);
+  }
+  CHECK(overall < 1.4e-4);
+}
+
+TEST_CASE(angleWrapMatchesTheFloatLoop) {
+  int32_t wrong = 0;
+  for (int32_t a = -10 * FX_FULL_TURN; a <= 10 * FX_FULL_TURN; a += 37) {
+    // The float code this replaces
+    float deg = fxAngleToDegrees(a);
+    while (deg < 0) deg += 360;
+    while (deg >= 360) deg -= 360;
+
+    int32_t w = fxWrapAngle(a);
+    if (w < 0 || w >= FX_FULL_TURN || fabsf(fxAngleToDegrees(w) - deg) > 1e-3f) wrong++;
+  }
+  CHECK_EQ(wrong, 0);
+  CHECK_EQ(fxWrapAngle(-1), FX_FULL_TURN - 1);
+  CHECK_EQ(fxWrapAngle(FX_FULL_TURN), 0);
+}
+
+TEST_CASE(handEndpointsStayOnTheFloatGeometry) {
+  fxMathBegin();
+  double worst = 0;
+  for (float angle = 0; angle < 360; angle += 0.37f) {
+    Capsule c = handCapsule(CENTER_X, CENTER_Y, angle, HAND_LENGTH_NORMAL, HAND_THICKNESS_NORMAL);
+    float rad = (angle - 90.0f) * PI / 180.0f;
+    worst = max(worst, (double)fabsf(c.bx - (CENTER_X + cosf(rad) * HAND_LENGTH_NORMAL)));
+    worst = max(worst, (double)fabsf(c.by - (CENTER_Y + sinf(rad) * HAND_LENGTH_NORMAL)));
+  }
+  // Far below the 1/15 pixel coverage step
+  REPORT("hand tip max offset %.4f px", worst);
+  CHECK(worst < 0.01);
+}
+
+// Keeps benchmark results alive without printing them
+static volatile int64_t sink;
+
+TEST_CASE(benchmarkAgainstFloat) {
+  fxMathBegin();
+  const int32_t calls = 1000000;
+
+  HostStopwatch floatTrig;
+  float fsum = 0;
+  for (int32_t i = 0; i < calls; i++) fsum += sinf(((i * 7) % 36000) * 0.01f * (float)PI / 180.0f);
+  double floatTrigNs = floatTrig.elapsedNs() / calls;
+
+  HostStopwatch fixedTrig;
+  int64_t xsum = 0;
+  for (int32_t i = 0; i < calls; i++) xsum += fxSin(i * 7);
+  double fixedTrigNs = fixedTrig.elapsedNs() / calls;
+
+  HostStopwatch floatEase;
+  for (int32_t i = 0; i < calls; i++) fsum += applyEasing((i & 0xFFFF) / 65536.0f, EASINGS[i & 7]);
+  double floatEaseNs = floatEase.elapsedNs() / calls;
+
+  HostStopwatch fixedEase;
+  for (int32_t i = 0; i < calls; i++) xsum += fxApplyEasing(i & 0xFFFF, EASINGS[i & 7]);
+  double fixedEaseNs = fixedEase.elapsedNs() / calls;
+
+  sink = xsum + (int64_t)fsum;
+  // The host has an FPU: on the C3 every float operation above is a library call
+  REPORT("sin:    float %.1f ns, fixed %.1f ns", floatTrigNs, fixedTrigNs);
+  REPORT("easing: float %.1f ns, fixed %.1f ns", floatEaseNs, fixedEaseNs);
+}
@@ -0,0 +1,141 @@
+// Frame pipeline with the render and transfer stages on two host threads
+// The test thread plays loop(): it draws into the back buffer and submits it,
+// while FramePipeline's transfer task pushes through the simulated DMA panel.
+// The bus is wrapped to catch a buffer drawn into before its release, and to
+// record which frame each push carried.
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/dma_bus.h"
+#include "pixel/frame_buffers.h"
+#include "pixel/frame_pipeline.h"
+#include <thread>
+#include <vector>
+
+static const uint32_t SPI_CLOCK_HZ = 80000000;
+static const int16_t BAND_ROWS = 10;
+
+// Forwards to the DMA bus and tracks, per framebuffer, whether the bus may still read it
+class CheckedBus : public DisplayBus {
+public:
+  // Learns where each framebuffer lives by walking the buffer ring once
+  CheckedBus(DisplayBus& target, FrameBuffers& buffers) : inner(target), count(buffers.size()) {
+    for (uint8_t i = 0; i < count; i++) {
+      pixels[buffers.backIndex()] = buffers.canvas()->getBuffer();
+      buffers.advance();
+    }
+  }
+
+  void pushWindow(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* src, int16_t stride) override {
+    markInFlight(src);
+    inner.pushWindow(x, y, w, h, src, stride);
+  }
+
+  void pushMaskedWindow(int16_t x, int16_t y, int16_t w, int16_t h,
+                        const uint16_t* src, int16_t stride, const CircleMask& mask) override {
+    markInFlight(src);
+    pushedFrames.push_back(src[0]);  // Bands are filled with the frame's id
+    inner.pushMaskedWindow(x, y, w, h, src, stride, mask);
+  }
+
+  uint32_t insertFence() override { return inner.insertFence(); }
+
+  void waitFence(uint32_t fence) override {
+    inner.waitFence(fence);
+    for (uint8_t i = 0; i < MAX_FRAME_BUFFERS; i++) inFlight[i].store(false, std::memory_order_release);
+    fencesWaited.fetch_add(1, std::memory_order_release);
+  }
+
+  bool pushesFullRows() const override { return inner.pushesFullRows(); }
+
+  bool isInFlight(uint8_t index) const { return inFlight[index].load(std::memory_order_acquire); }
+
+  std::vector<uint16_t> pushedFrames;  // Written by the transfer task only
+  std::atomic<uint32_t> fencesWaited{0};
+
+private:
+  void markInFlight(const uint16_t* src) {
+    for (uint8_t i = 0; i < count; i++) {
+      if (src >= pixels[i] && src < pixels[i] + DISPLAY_PIXELS) inFlight[i].store(true, std::memory_order_release);
+    }
+  }
+
+  DisplayBus& inner;
+  uint8_t count;
+  const uint16_t* pixels[MAX_FRAME_BUFFERS] = {};
+  std::atomic<bool> inFlight[MAX_FRAME_BUFFERS] = {};
+};
+
+static DmaDisplayBus& dmaBus() {
+  static DmaDisplayBus bus(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  static bool started = false;
+  if (!started) {
+    CHECK(bus.begin(12, 11, 10, 9, SPI_CLOCK_HZ));
+    started = true;
+  }
+  hostLcdReset();
+  return bus;
+}
+
+// Frame ids are byte-symmetric, so they read the same in host and panel order
+static uint16_t frameColor(uint16_t frame) { return (uint16_t)((frame & 0xFF) * 0x0101); }
+
+// Submit `frames` frames, each a full-width band filled with its id
+// The stages run unsynchronized except through the pipeline; every few frames the
+// render stage takes a while, so both the stalled and the idle transfer task get exercised.
+static void runPipeline(uint8_t bufferCount, uint16_t frames) {
+  // The transfer task never exits, so everything it touches lives for the whole run
+  FrameBuffers* buffers = new FrameBuffers();
+  CHECK_EQ(buffers->begin(bufferCount, DISPLAY_WIDTH, DISPLAY_HEIGHT, 0), bufferCount);
+  CheckedBus* bus = new CheckedBus(dmaBus(), *buffers);
+  FramePipeline* pipeline = new FramePipeline(*buffers, panelMask());
+  CHECK(pipeline->begin(*bus));
+  CHECK(pipeline->isPipelined());
+
+  int32_t reusedInFlight = 0;
+  for (uint16_t f = 0; f < frames; f++) {
+    uint8_t index = buffers->backIndex();
+    if (bus->isInFlight(index)) reusedInFlight++;
+
+    DamageList band;
+    band.screen = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+    band.add({0, (int16_t)(60 + (f * 7) % 100), DISPLAY_WIDTH, BAND_ROWS});
+    const Rect& r = band.rects[0];
+    buffers->canvas()->fillRect(r.x, r.y, r.w, r.h, frameColor(f));
+    if (f % 5 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+    pipeline->submit(band);
+  }
+
+  // Let the transfer task finish the frames still in flight
+  HostStopwatch timeout;
+  while (bus->fencesWaited.load(std::memory_order_acquire) < frames && timeout.elapsedNs() < 10e9) {
+    std::this_thread::yield();
+  }
+
+  CHECK_EQ(reusedInFlight, 0);
+  CHECK_EQ(hostLcdPanel().modifiedInFlight, 0);
+  CHECK_EQ(pipeline->takeStats().frames, frames);
+
+  // Every frame was pushed exactly once, in submission order
+  CHECK_EQ(bus->fencesWaited.load(), frames);
+  CHECK_EQ(bus->pushedFrames.size(), frames);
+  int32_t outOfOrder = 0;
+  for (size_t i = 0; i < bus->pushedFrames.size(); i++) {
+    if (bus->pushedFrames[i] != frameColor(i)) outOfOrder++;
+  }
+  CHECK_EQ(outOfOrder, 0);
+
+  // And the last band made it to the glass
+  hostLcdDrain();
+  int16_t lastRow = 60 + ((frames - 1) * 7) % 100;
+  CHECK_EQ(hostLcdPanel().pixels[(lastRow + BAND_ROWS / 2) * DISPLAY_WIDTH + CENTER_X], frameColor(frames - 1));
+}
+
+TEST_CASE(singleBufferPipelineRunsInLockstep) {
+  runPipeline(1, 120);
+}
+
+TEST_CASE(doubleBufferPipelineNeverReusesABufferInFlight) {
+  runPipeline(2, 240);
+}
@@ -0,0 +1,155 @@
+// Grid patterns: every pixel's view of a random GridPatternPacket against the
+// explicit AngleCommandPacket a master would build for the same pattern, and the
+// angles against the exact linear field
+
+#include <random>
+#include "host_test.h"
+#include <ESPNowComm.h>
+
+// Linear angle field over the grid
+struct AngleField {
+  float base;
+  float row;
+  float column;
+
+  float at(uint8_t pixel) const { return base + (pixel / GRID_COLUMNS) * row + (pixel % GRID_COLUMNS) * column; }
+};
+
+static double angleDifference(double a, double b) {
+  double d = fmod(a - b, 360.0);
+  if (d < -180) d += 360;
+  if (d > 180) d -= 360;
+  return fabs(d);
+}
+
+TEST_CASE(gridPatternMatchesExplicitPackets) {
+  REPORT("packet sizes: grid pattern %u bytes, angle command %u bytes", (unsigned)sizeof(GridPatternPacket),
+         (unsigned)sizeof(AngleCommandPacket));
+  std::mt19937 rng(3);
+  const uint16_t patterns = 2000;
+  uint32_t mismatches = 0;
+  uint32_t alignedHands = 0;
+  uint32_t alignedIdentical = 0;
+  double worstVsExplicit = 0;
+  double worstVsExact = 0;
+  for (uint16_t trial = 0; trial < patterns; trial++) {
+    // Every other pattern steps on the angle command's 1/256-turn grid
+    bool aligned = trial % 2 == 0;
+    auto pickAngle = [&]() {
+      return aligned ? (int)(rng() % 512 - 256) * (360.0f / 256) : (rng() % 72000) / 100.0f - 360.0f;
+    };
+    AngleField fields[HANDS_PER_PIXEL];
+    RotationDirection dirs[HANDS_PER_PIXEL];
+    bool flipColumns[HANDS_PER_PIXEL];
+    bool flipRows[HANDS_PER_PIXEL];
+    uint8_t turns[HANDS_PER_PIXEL];
+    GridPatternPacket grid;
+    grid.clear();
+    grid.transition = (TransitionType)(rng() % 7);
+    grid.duration = rng() % 240;
+    for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+      fields[h].base = pickAngle();
+      fields[h].row = pickAngle();
+      fields[h].column = pickAngle();
+      dirs[h] = (RotationDirection)(rng() % 3);
+      flipColumns[h] = rng() % 2;
+      flipRows[h] = rng() % 2;
+      turns[h] = rng() % 16;
+      grid.setHandAngles(h, fields[h].base, fields[h].row, fields[h].column);
+      grid.setHandDirection(h, dirs[h], flipColumns[h], flipRows[h]);
+      grid.setHandTurns(h, turns[h]);
+    }
+    int baseColor = rng() % COLOR_PALETTE_SIZE;
+    int rowColor = (int)(rng() % 11) - 5;
+    int columnColor = (int)(rng() % 11) - 5;
+    grid.setColors(baseColor, rowColor, columnColor);
+    grid.opacity = rng() % 256;
+    // Delays the angle command can carry: a slot (0-7) per column, either way round
+    uint16_t stepMs = 2 * (rng() % 128);
+    bool reversed = rng() % 2;
+    grid.setStartDelays(reversed ? 7 * stepMs : 0, 0, reversed ? -stepMs : stepMs);
+
+    AngleCommandPacket explicitPacket = {};
+    explicitPacket.command = CMD_SET_ANGLES;
+    explicitPacket.transition = grid.transition;
+    explicitPacket.duration = grid.duration;
+    explicitPacket.clearTargetMask();
+    explicitPacket.clearExtensions();
+    explicitPacket.setStartDelayStep(stepMs);
+    for (uint8_t p = 0; p < MAX_PIXELS; p++) {
+      uint8_t row = p / GRID_COLUMNS;
+      uint8_t column = p % GRID_COLUMNS;
+      RotationDirection pixelDirs[HANDS_PER_PIXEL];
+      for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+        bool flip = (flipColumns[h] && column % 2) != (flipRows[h] && row % 2);
+        pixelDirs[h] = (!flip || dirs[h] == DIR_SHORTEST) ? dirs[h] : (dirs[h] == DIR_CW ? DIR_CCW : DIR_CW);
+      }
+      explicitPacket.setPixelAngles(p, fields[0].at(p), fields[1].at(p), fields[2].at(p), pixelDirs[0], pixelDirs[1],
+                                    pixelDirs[2]);
+      explicitPacket.setPixelTurns(p, turns[0], turns[1], turns[2]);
+      int color = ((baseColor + row * rowColor + column * columnColor) % COLOR_PALETTE_SIZE + COLOR_PALETTE_SIZE) %
+                  COLOR_PALETTE_SIZE;
+      explicitPacket.setPixelStyle(p, color, grid.opacity);
+      explicitPacket.setPixelStartSlot(p, reversed ? 7 - column : column);
+    }
+
+    // Each pixel's view of both packets
+    for (uint8_t p = 0; p < MAX_PIXELS; p++) {
+      float angles[HANDS_PER_PIXEL];
+      RotationDirection pixelDirs[HANDS_PER_PIXEL];
+      explicitPacket.getPixelAngles(p, angles[0], angles[1], angles[2]);
+      explicitPacket.getPixelDirections(p, pixelDirs[0], pixelDirs[1], pixelDirs[2]);
+      for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+        float gridAngle = grid.getPixelAngle(p, h);
+        worstVsExplicit = max(worstVsExplicit, angleDifference(gridAngle, angles[h]));
+        worstVsExact = max(worstVsExact, angleDifference(gridAngle, fields[h].at(p)));
+        if (aligned) {
+          alignedHands++;
+          if (floatToAngle(gridAngle) == floatToAngle(angles[h]) && angleDifference(gridAngle, angles[h]) < 1e-3) {
+            alignedIdentical++;
+          }
+        }
+        if (grid.getPixelDirection(p, h) != pixelDirs[h] || grid.getHandTurns(h) != explicitPacket.getPixelTurns(p, h)) {
+          mismatches++;
+        }
+      }
+      if (grid.getPixelColorIndex(p) != explicitPacket.colorIndices[p] || grid.opacity != explicitPacket.opacities[p] ||
+          grid.getPixelStartDelayMs(p) != explicitPacket.getPixelStartDelayMs(p) ||
+          grid.transition != explicitPacket.transition || grid.duration != explicitPacket.duration) {
+        mismatches++;
+      }
+    }
+  }
+  REPORT("%u patterns x %u pixels: %u direction/turn/color/opacity/delay/timing mismatches", patterns, MAX_PIXELS,
+         mismatches);
+  REPORT("angles on the 1/256-turn grid identical in %u/%u hands; max %.3f deg from the angle command, %.4f deg "
+         "from the exact field", alignedIdentical, alignedHands, worstVsExplicit, worstVsExact);
+  CHECK_EQ(mismatches, 0u);
+  CHECK_EQ(alignedIdentical, alignedHands);
+  // The angle command rounds to the nearest 1/256 turn (up to 0.70 deg); the
+  // pattern's 1/65536-turn steps stay close to the exact field
+  CHECK(worstVsExplicit < 0.75);
+  CHECK(worstVsExact < 0.03);
+}
+
+TEST_CASE(gridPatternIsSmallerThanAnAngleCommand) {
+  CHECK(sizeof(GridPatternPacket) < sizeof(AngleCommandPacket) / 4);
+  GridPatternPacket grid;
+  grid.clear();
+  CHECK(grid.isPixelTargeted(0));
+  CHECK(grid.isPixelTargeted(MAX_PIXELS - 1));
+}
+
+TEST_CASE(startDelaysRoundTheSameBothWays) {
+  GridPatternPacket grid;
+  grid.clear();
+  // Odd steps round half away from zero: a mirrored wave keeps the same spacing
+  for (int16_t stepMs = 1; stepMs <= 9; stepMs += 2) {
+    grid.setStartDelays(7 * stepMs, stepMs, -stepMs);
+    CHECK_EQ(grid.rowDelayStep, -grid.columnDelayStep);
+    CHECK_EQ(grid.baseDelay, (uint16_t)(7 * stepMs + 1) / START_DELAY_UNIT_MS);
+  }
+  grid.setStartDelays(0, -300, 300);  // Beyond +/-254 ms
+  CHECK_EQ(grid.rowDelayStep, -128);
+  CHECK_EQ(grid.columnDelayStep, 127);
+}
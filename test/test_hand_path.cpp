@@ -0,0 +1,109 @@
+// Hand paths (built twice: float, and fixed-point with USE_FIXED_POINT_MATH):
+// multi-turn and waypoint transitions played at 1 ms for every TransitionType,
+// final angle, net unwrapped displacement and distance travelled against the
+// request. The hands run through hand_motion.h, as in main.cpp.
+
+#include "host_test.h"
+#include "pixel/hand_motion.h"
+
+static EasingCurves easingCurves;
+
+struct PathRequest {
+  float start;
+  float target;
+  RotationDirection dir;
+  uint8_t turns;
+  bool viaWaypoint;
+  float waypoint;
+  RotationDirection dirAfter;
+};
+
+// All three hands on the same path, directions resolved as startKeyframe() does
+static void startPath(HandStates& hands, const PathRequest& r, TransitionType easing, uint32_t durationMs) {
+  HandMotion motion = {};
+  motion.waypointMask = r.viaWaypoint ? ALL_HANDS_MASK : 0;
+  motion.springFrequencyHz = SPRING_DEFAULT_FREQUENCY_HZ;
+  motion.springDampingRatio = SPRING_DEFAULT_DAMPING_RATIO;
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    hands.currentAngle[i] = r.start;
+    motion.targets[i] = r.target;
+    motion.dirs[i] = resolveDirection(r.dir, r.viaWaypoint ? r.waypoint : r.target, r.start);
+    motion.turns[i] = r.turns;
+    motion.waypoints[i] = r.waypoint;
+    motion.waypointDirs[i] = r.viaWaypoint ? resolveDirection(r.dirAfter, r.target, r.waypoint) : motion.dirs[i];
+    motion.easings[i] = easing;
+    motion.durationsMs[i] = durationMs;
+  }
+  startHands(hands, motion, 0);
+}
+
+TEST_CASE(pathsEndWhereRequested) {
+  fxMathBegin();
+  ESPNowPacket packet;
+  packet.easingUpload.setBezier(0, 0.16f, 1.0f, 0.3f, 1.0f);
+  CHECK(easingCurves.upload(packet.easingUpload));
+
+  struct PathCase {
+    const char* name;
+    PathRequest request;
+    double net;     // Unwrapped displacement
+    double travel;  // Path length
+  };
+  const PathCase cases[] = {
+    {"2.5 turns CCW", {0, 180, DIR_CCW, 2, false, 0, DIR_SHORTEST}, -900, 900},
+    {"same angle, full turn", {45, 45, DIR_CW, 0, false, 0, DIR_SHORTEST}, 360, 360},
+    {"same angle, 3 turns", {45, 45, DIR_CW, 3, false, 0, DIR_SHORTEST}, 1080, 1080},
+    {"shortest + 1 turn", {350, 20, DIR_SHORTEST, 1, false, 0, DIR_SHORTEST}, 390, 390},
+    {"waypoint, reverse", {10, 100, DIR_CW, 1, true, 300, DIR_CCW}, 450, 850},
+    {"waypoint, same way", {200, 190, DIR_CCW, 0, true, 90, DIR_CCW}, -370, 370},
+    {"15 turns", {0, 350, DIR_CW, 15, false, 0, DIR_SHORTEST}, 5750, 5750},
+  };
+
+  double worstFinal = 0;
+  double worstNet = 0;
+  double worstTravel = 0;
+  for (const PathCase& c : cases) {
+    for (uint8_t e = 0; e <= TRANSITION_CUSTOM_2; e++) {
+      TransitionType easing = (TransitionType)e;
+      HandStates hands = {};
+      startPath(hands, c.request, easing, 3000);
+      float previous = c.request.start;
+      double net = 0;
+      double distance = 0;
+      for (uint32_t t = 1; hands.activeMask && t < 60000; t++) {
+        updateHands(hands, easingCurves, t);
+        float angle = hands.currentAngle[0];
+        double d = angle - previous;
+        while (d > 180) d -= 360;
+        while (d < -180) d += 360;
+        net += d;
+        distance += fabs(d);
+        previous = angle;
+      }
+      CHECK_EQ(hands.activeMask, 0);
+      worstFinal = max(worstFinal, (double)fabsf(previous - wrapDegrees(c.request.target)));
+      // Instant jumps (no visible travel); overshooting easings travel further
+      if (easing != TRANSITION_INSTANT) worstNet = max(worstNet, fabs(net - c.net));
+      bool monotonic = easing == TRANSITION_LINEAR || easing == TRANSITION_EASE_IN_OUT || easing >= TRANSITION_SPRING;
+      if (monotonic) worstTravel = max(worstTravel, fabs(distance - c.travel));
+    }
+  }
+  REPORT("%u paths x %u easings: final angle error %.6f deg, net displacement error %.4f deg,",
+         (unsigned)(sizeof(cases) / sizeof(cases[0])), TRANSITION_CUSTOM_2 + 1, worstFinal, worstNet);
+  REPORT("  distance error (monotonic easings) %.4f deg", worstTravel);
+  CHECK(worstFinal < 0.001);
+  CHECK(worstNet < 0.001);
+  // 1 ms frames cut the corner where a waypoint reverses the hand
+  CHECK(worstTravel < 1.0);
+}
+
+TEST_CASE(emptyPathMakesAFullTurn) {
+  HandPath path = HandPath::plan(90, 90.05f, 1, 0, false, 0, 1);
+  CHECK_EQ(path.travel, 360.0f);
+  CHECK_EQ(path.leg, 360.0f);
+  // A waypoint leg: the first leg with its turns, then the rest the other way
+  path = HandPath::plan(10, 100, 1, 1, true, 300, -1);
+  CHECK(fabsf(path.leg - 650) < 0.001f);
+  CHECK(fabsf(path.travel - 850) < 0.001f);
+  CHECK(fabsf(pathAngle(10, 1, -1, path.leg, path.travel) - (10 + 650 - 200)) < 0.001f);
+}
@@ -0,0 +1,141 @@
+// Hand span cache: cached hands against the live capsule coverage at every angle
+// step, the pool size a full cache needs, and the cost of a cached frame
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/hand_span_cache.h"
+
+const uint32_t POOL_BYTES = 400 * 1024;  // main.cpp's HAND_SPAN_POOL_BYTES
+
+static bool beginCache(HandSpanCache& cache, uint32_t poolBytes) {
+  if (!cache.begin(CENTER_X, CENTER_Y, poolBytes, 0)) return false;
+  cache.addShape(HAND_LENGTH_NORMAL, HAND_THICKNESS_NORMAL);  // HAND_SHAPE_NORMAL
+  cache.addShape(HAND_LENGTH_NORMAL, HAND_THICKNESS_THIN);    // HAND_SHAPE_THIN
+  return true;
+}
+
+TEST_CASE(cachedCoverageMatchesTheCapsule) {
+  static HandSpanCache cache;
+  CHECK(beginCache(cache, POOL_BYTES));
+
+  int32_t wrong = 0;
+  int32_t covered = 0;
+  int worst = 0;
+  uint8_t cached[DISPLAY_WIDTH];
+  uint8_t live[DISPLAY_WIDTH];
+  for (uint8_t shape = 0; shape < 2; shape++) {
+    float thickness = shape == HAND_SHAPE_THIN ? HAND_THICKNESS_THIN : HAND_THICKNESS_NORMAL;
+    for (uint16_t step = 0; step < HAND_SPAN_ANGLE_STEPS; step++) {
+      HandSpanRef ref = cache.lookup(shape, step);
+      CHECK(ref.spans != nullptr);
+      Capsule c = handCapsule(CENTER_X, CENTER_Y, HandSpanCache::stepAngle(step), HAND_LENGTH_NORMAL, thickness);
+      for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+        memset(cached, 0, sizeof(cached));
+        memset(live, 0, sizeof(live));
+        cache.coverRow(ref, y, 0, DISPLAY_WIDTH, cached);
+        coverCapsuleRow(c, y, 0, DISPLAY_WIDTH, live);
+        for (int16_t x = 0; x < DISPLAY_WIDTH; x++) {
+          int d = abs(cached[x] - live[x]);
+          if (d) wrong++;
+          worst = max(worst, d);
+          if (cached[x] || live[x]) covered++;
+        }
+      }
+    }
+  }
+  // The mirrored quadrants reuse the [0, 90] records; float trig of the mirrored
+  // angle can put a pixel on the other side of a coverage level
+  REPORT("%d of %d covered pixels differ, by at most %d coverage level(s)", wrong, covered, worst);
+  CHECK(worst <= 1);
+  CHECK(wrong * 100000 < covered);
+
+  // Both shapes at every step fit in the pool main.cpp allocates
+  REPORT("full cache: %u bytes in a %u byte pool", cache.bytesUsed(), POOL_BYTES);
+  CHECK(cache.bytesUsed() <= POOL_BYTES);
+}
+
+TEST_CASE(clippedRowsMatchFullRows) {
+  static HandSpanCache cache;
+  CHECK(beginCache(cache, POOL_BYTES));
+  uint8_t full[DISPLAY_WIDTH];
+  uint8_t clipped[DISPLAY_WIDTH];
+  int32_t wrong = 0;
+  for (uint16_t step = 0; step < HAND_SPAN_ANGLE_STEPS; step += 17) {
+    HandSpanRef ref = cache.lookup(HAND_SHAPE_NORMAL, step);
+    for (int16_t y = 0; y < DISPLAY_HEIGHT; y += 3) {
+      memset(full, 0, sizeof(full));
+      cache.coverRow(ref, y, 0, DISPLAY_WIDTH, full);
+      // Band and damage rectangles cover part of a row
+      for (int16_t x0 = 0; x0 < DISPLAY_WIDTH; x0 += 37) {
+        int16_t x1 = min<int16_t>(x0 + 50, DISPLAY_WIDTH);
+        memset(clipped, 0, sizeof(clipped));
+        cache.coverRow(ref, y, x0, x1, clipped);
+        for (int16_t x = 0; x < DISPLAY_WIDTH; x++) {
+          uint8_t expected = (x >= x0 && x < x1) ? full[x] : 0;
+          if (clipped[x] != expected) wrong++;
+        }
+      }
+    }
+  }
+  CHECK_EQ(wrong, 0);
+}
+
+TEST_CASE(fullPoolFallsBackToLiveRaster) {
+  static HandSpanCache cache;
+  CHECK(beginCache(cache, 16 * 1024));
+  uint16_t built = 0;
+  for (uint16_t step = 0; step <= HAND_SPAN_QUARTER_STEPS; step++) {
+    if (cache.lookup(HAND_SHAPE_NORMAL, step).spans) built++;
+  }
+  CHECK(built > 0);
+  CHECK(built < HAND_SPAN_QUARTER_STEPS);
+  CHECK(cache.bytesUsed() <= 16 * 1024);
+  // Records already built keep working
+  CHECK(cache.lookup(HAND_SHAPE_NORMAL, 0).spans != nullptr);
+}
+
+TEST_CASE(benchmarkCachedFrames) {
+  const int frames = 500;
+  static HandSpanCache cache;
+  CHECK(beginCache(cache, POOL_BYTES));
+  CapsuleRasterizer liveRaster;
+  CapsuleRasterizer cachedRaster;
+  static uint16_t livePixels[DISPLAY_PIXELS];
+  static uint16_t cachedPixels[DISPLAY_PIXELS];
+
+  // Hands on step angles, as drawnHandAngle() snaps them when the cache is in use
+  auto frameAt = [](int f) {
+    ClockFrame frame = {{HandSpanCache::stepAngle((f * 5) & 1023), HandSpanCache::stepAngle((f * 11 + 300) & 1023),
+                         HandSpanCache::stepAngle((f * 3 + 700) & 1023)},
+                        0x0000, 0xFFFF, 0xFFE0};
+    return frame;
+  };
+  // Build every record before timing
+  for (int f = 0; f < frames; f++) {
+    prepareRasterizer(cachedRaster, frameAt(f));
+    useCachedHands(cachedRaster, cache, frameAt(f));
+  }
+
+  HostStopwatch liveClock;
+  for (int f = 0; f < frames; f++) {
+    prepareRasterizer(liveRaster, frameAt(f));
+    liveRaster.render(livePixels, DISPLAY_WIDTH, {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT}, panelMask());
+  }
+  double liveNs = liveClock.elapsedNs() / frames;
+
+  HostStopwatch cachedClock;
+  for (int f = 0; f < frames; f++) {
+    prepareRasterizer(cachedRaster, frameAt(f));
+    useCachedHands(cachedRaster, cache, frameAt(f));
+    cachedRaster.render(cachedPixels, DISPLAY_WIDTH, {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT}, panelMask());
+  }
+  double cachedNs = cachedClock.elapsedNs() / frames;
+
+  // Last frame of each: same image apart from the rare off-by-one edge pixel
+  int32_t different = 0;
+  for (int32_t i = 0; i < DISPLAY_PIXELS; i++) {
+    if (cachedPixels[i] != livePixels[i]) different++;
+  }
+  CHECK(different < 10);
+  REPORT("full frame: live %8.0f ns, cached %8.0f ns", liveNs, cachedNs);
+}
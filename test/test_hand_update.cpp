@@ -0,0 +1,208 @@
+// Per-hand transition update: hand_motion.h's structure-of-arrays update against
+// the three updateHandAngle() calls it replaced (kept below as they were), same
+// angles and the cost per frame. Built twice, as test_hand_update (float, like
+// pixel_s3) and test_hand_update_fixed (USE_FIXED_POINT_MATH, like pixel_c3).
+
+#include "host_test.h"
+#include "pixel/hand_motion.h"
+
+#ifdef USE_FIXED_POINT_MATH
+const char* const MATH_PATH = "fixed-point";
+#else
+const char* const MATH_PATH = "float";
+#endif
+
+// ---- Before: one HandState per hand, one shared transition ----
+
+struct HandState {
+  float currentAngle;
+  float targetAngle;
+  float startAngle;
+  int direction;
+  int32_t startFx;
+  int32_t sweepFx;
+};
+
+struct TransitionState {
+  float duration;       // Seconds
+  uint32_t durationMs;
+  TransitionType easing;
+};
+
+static TransitionState transition;
+
+static float oldHandSweep(const HandState& hand) {
+  float diff = hand.targetAngle - hand.startAngle;
+  if (abs(diff) < 359.0) {
+    while (diff < 0) diff += 360.0;
+    while (diff >= 360.0) diff -= 360.0;
+    if (hand.direction < 0) diff = diff - 360.0;
+  }
+  return diff;
+}
+
+#ifdef USE_FIXED_POINT_MATH
+__attribute__((noinline)) static void updateHandAngle(HandState& hand, q16_t t) {
+  q16_t easedT = fxApplyEasing(t, transition.easing);
+  hand.currentAngle = fxAngleToDegrees(fxWrapAngle(hand.startFx + fxMul(hand.sweepFx, easedT)));
+}
+
+// Progress the old loop() computed once per frame
+static q16_t oldProgress(uint32_t elapsedMs, uint32_t durationMs) {
+  return (q16_t)(((uint64_t)elapsedMs << 16) / durationMs);
+}
+#else
+__attribute__((noinline)) static void updateHandAngle(HandState& hand, float t) {
+  float easedT = applyEasing(t, transition.easing);
+  hand.currentAngle = wrapDegrees(hand.startAngle + oldHandSweep(hand) * easedT);
+}
+
+static float oldProgress(uint32_t elapsedMs, uint32_t durationMs) {
+  return (elapsedMs / 1000.0f) / (durationMs / 1000.0f);
+}
+#endif
+
+static HandState oldHands[HANDS_PER_PIXEL];
+
+// ---- After: hand_motion.h ----
+
+static HandStates hands;
+static EasingCurves curves;  // None uploaded
+
+__attribute__((noinline)) static void updateAllHands(uint32_t now) {
+  updateHands(hands, curves, now);
+}
+
+// Same three moves in both layouts (the old layout has one easing and duration)
+static void startBoth(const TransitionType easings[HANDS_PER_PIXEL], const uint32_t durationsMs[HANDS_PER_PIXEL]) {
+  const float starts[HANDS_PER_PIXEL] = {10, 300, 45};
+  const float targets[HANDS_PER_PIXEL] = {90, 200, 330};
+  const int8_t directions[HANDS_PER_PIXEL] = {1, -1, 1};
+  transition = {durationsMs[0] / 1000.0f, durationsMs[0], easings[0]};
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    HandState& h = oldHands[i];
+    h = {starts[i], targets[i], starts[i], directions[i], fxAngleFromDegrees(starts[i]), 0};
+    h.sweepFx = fxAngleFromDegrees(oldHandSweep(h));
+    hands.currentAngle[i] = starts[i];
+  }
+  HandMotion motion = {};
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    motion.targets[i] = targets[i];
+    motion.dirs[i] = directions[i];
+    motion.easings[i] = easings[i];
+    motion.durationsMs[i] = durationsMs[i];
+  }
+  startHands(hands, motion, 0);
+}
+
+static void startShared(TransitionType easing, uint32_t durationMs) {
+  const TransitionType easings[HANDS_PER_PIXEL] = {easing, easing, easing};
+  const uint32_t durationsMs[HANDS_PER_PIXEL] = {durationMs, durationMs, durationMs};
+  startBoth(easings, durationsMs);
+}
+
+static double angleDistance(float a, float b) {
+  double d = fabs(a - b);
+  return min(d, 360 - d);
+}
+
+static const TransitionType EASINGS[] = {
+  TRANSITION_LINEAR, TRANSITION_EASE_IN_OUT, TRANSITION_ELASTIC, TRANSITION_BOUNCE,
+  TRANSITION_BACK_IN, TRANSITION_BACK_OUT, TRANSITION_BACK_IN_OUT,
+};
+
+TEST_CASE(sharedTimingGivesTheSameAngles) {
+  fxMathBegin();
+  double worst = 0;
+  for (TransitionType easing : EASINGS) {
+    const uint32_t durationMs = 2500;
+    startShared(easing, durationMs);
+    CHECK(hands.sharedTiming);
+    for (uint32_t now = 0; now < durationMs; now += 7) {
+      updateAllHands(now);
+      for (HandState& h : oldHands) updateHandAngle(h, oldProgress(now, durationMs));
+      for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+        worst = max(worst, angleDistance(hands.currentAngle[i], oldHands[i].currentAngle));
+      }
+    }
+    updateAllHands(durationMs);
+    CHECK_EQ(hands.activeMask, 0);
+    for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) CHECK_EQ(hands.currentAngle[i], oldHands[i].targetAngle);
+  }
+  // Progress by reciprocal multiply instead of a divide: last-bit differences
+  REPORT("%s: max angle difference %.5f deg", MATH_PATH, worst);
+  CHECK(worst < 0.01);
+}
+
+TEST_CASE(eachHandKeepsItsOwnTiming) {
+  fxMathBegin();
+  const TransitionType easings[HANDS_PER_PIXEL] = {TRANSITION_LINEAR, TRANSITION_BOUNCE, TRANSITION_BACK_OUT};
+  const uint32_t durationsMs[HANDS_PER_PIXEL] = {800, 2500, 1600};
+  startBoth(easings, durationsMs);
+  CHECK(!hands.sharedTiming);
+
+  double worst = 0;
+  for (uint32_t now = 0; now <= 2600; now += 11) {
+    updateAllHands(now);
+    for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+      // The old update, one hand at a time with that hand's easing and progress
+      transition.easing = easings[i];
+      HandState& h = oldHands[i];
+      if (now < durationsMs[i]) {
+        updateHandAngle(h, oldProgress(now, durationsMs[i]));
+        worst = max(worst, angleDistance(hands.currentAngle[i], h.currentAngle));
+      } else {
+        CHECK_EQ(hands.currentAngle[i], h.targetAngle);
+        CHECK(!(hands.activeMask & (1 << i)));
+      }
+    }
+  }
+  // Reciprocal progress is off by up to a Q16 step, which the steepest easings
+  // (bounce, back) scale up: still a few hundredths of a degree
+  REPORT("%s: max angle difference %.5f deg", MATH_PATH, worst);
+  CHECK(worst < 0.05);
+  CHECK_EQ(hands.activeMask, 0);
+}
+
+// Keeps benchmark results alive without printing them
+static volatile float sink;
+
+TEST_CASE(benchmarkAgainstPerHandUpdates) {
+  fxMathBegin();
+  const int32_t frames = 5000000;
+  const uint32_t durationMs = 1000000000u;  // Never finishes during the run
+  const TransitionType staggeredEasings[HANDS_PER_PIXEL] = {
+    TRANSITION_EASE_IN_OUT, TRANSITION_EASE_IN_OUT, TRANSITION_EASE_IN_OUT};
+  const uint32_t staggeredDurations[HANDS_PER_PIXEL] = {durationMs, durationMs - 1, durationMs - 2};
+
+  startShared(TRANSITION_EASE_IN_OUT, durationMs);
+  float sum = 0;
+  HostStopwatch oldClock;
+  for (int32_t f = 0; f < frames; f++) {
+    auto t = oldProgress(f * 37u, transition.durationMs);
+    for (HandState& h : oldHands) updateHandAngle(h, t);
+    sum += oldHands[1].currentAngle;
+  }
+  double oldNs = oldClock.elapsedNs() / frames;
+
+  HostStopwatch sharedClock;
+  for (int32_t f = 0; f < frames; f++) {
+    updateAllHands(f * 37u);
+    sum += hands.currentAngle[1];
+  }
+  double sharedNs = sharedClock.elapsedNs() / frames;
+
+  // Same moves, but every hand with its own duration: the per-hand loop
+  startBoth(staggeredEasings, staggeredDurations);
+  HostStopwatch perHandClock;
+  for (int32_t f = 0; f < frames; f++) {
+    updateAllHands(f * 37u);
+    sum += hands.currentAngle[1];
+  }
+  double perHandNs = perHandClock.elapsedNs() / frames;
+  sink = sum;
+
+  REPORT("%s: three updateHandAngle() %5.1f ns/frame", MATH_PATH, oldNs);
+  REPORT("%s: shared timing         %5.1f ns/frame (%.2fx)", MATH_PATH, sharedNs, oldNs / sharedNs);
+  REPORT("%s: per-hand timing       %5.1f ns/frame (%.2fx)", MATH_PATH, perHandNs, oldNs / perHandNs);
+}
@@ -0,0 +1,109 @@
+// Indexed framebuffers (built with USE_INDEXED_FRAMEBUFFER, as pixel_s3): frames
+// stored as palette indices and expanded while pushing must put the same bytes
+// on the panel as frames rendered straight to RGB565
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/frame_buffers.h"
+#include "pixel/dma_bus.h"
+
+// Push a clock frame the way loop() does in indexed builds and compare the panel
+// with the frame rendered directly to RGB565
+static int32_t indexedMismatches(FrameBuffers& buffers, DisplayBus& bus, const uint16_t* panelPixels,
+                                 const ClockFrame& frame) {
+  CapsuleRasterizer rasterizer;
+  prepareRasterizer(rasterizer, frame);
+  DamageList all;
+  all.screen = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
+  all.setFull();
+
+  buffers.canvas()->usePalette(rasterizer.palette());
+  rasterizer.renderIndexed(buffers.canvas()->getBuffer(), DISPLAY_WIDTH, all.rects[0], panelMask());
+  buffers.present(bus, all, panelMask());
+  bus.waitFence(bus.insertFence());
+  hostLcdDrain();
+
+  static uint16_t reference[DISPLAY_PIXELS];
+  renderReference(frame, reference);
+  return countVisibleMismatches(panelPixels, reference);
+}
+
+TEST_CASE(indexedFramesMatchRgb565OnBothBuses) {
+  static Adafruit_GC9A01A panel;
+  GC9A01ABus adafruitBus(panel);
+  static DmaDisplayBus dmaBus(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  CHECK(dmaBus.begin(12, 11, 10, 9, 80000000));
+
+  for (uint8_t dma = 0; dma < 2; dma++) {
+    DisplayBus& bus = dma ? (DisplayBus&)dmaBus : (DisplayBus&)adafruitBus;
+    const uint16_t* pixels = dma ? hostLcdPanel().pixels : panel.pixels;
+    FrameBuffers buffers;
+    CHECK_EQ(buffers.begin(2, DISPLAY_WIDTH, DISPLAY_HEIGHT, 0), 2);
+
+    int32_t mismatches = 0;
+    int32_t frames = 0;
+    for (uint8_t p = 0; p < paletteSize; p++) {
+      // Hand colors part-way between background and foreground (faded hands)
+      for (uint8_t alpha = 0; alpha <= 32; alpha += 8) {
+        uint16_t bg = colorPalette[p].bg;
+        uint16_t fg = colorPalette[p].fg;
+        ClockFrame frame = {{p * 23.0f + alpha, p * 41.0f, p * 7.0f + 90}, bg, fg, blend565(bg, fg, alpha)};
+        mismatches += indexedMismatches(buffers, bus, pixels, frame);
+        frames++;
+      }
+    }
+    REPORT("%s bus: %d frames, %d differing pixels (%u bytes per buffer instead of %u)", dma ? "DMA" : "Adafruit",
+           frames, mismatches, (uint32_t)(DISPLAY_PIXELS * sizeof(FramePixel)), (uint32_t)DISPLAY_PIXELS * 2);
+    CHECK_EQ(mismatches, 0);
+  }
+}
+
+TEST_CASE(everyPaletteEntryExpandsToItsBlend) {
+  CapsuleRasterizer rasterizer;
+  for (uint8_t p = 0; p < paletteSize; p++) {
+    uint16_t bg = colorPalette[p].bg;
+    uint16_t fg = colorPalette[p].fg;
+    ClockFrame frame = {{0, 0, 0}, bg, fg, fg};
+    prepareRasterizer(rasterizer, frame);
+    const uint16_t* palette = rasterizer.palette();
+
+    int32_t wrong = 0;
+    for (uint16_t i = 0; i < FRAME_PALETTE_SIZE; i++) {
+      uint8_t h = i >> 4;
+      uint8_t d = i & 0x0F;
+      uint16_t handOverBg = blend565(bg, fg, (h * BLEND_FULL + COVERAGE_FULL / 2) / COVERAGE_FULL);
+      uint16_t expected = blend565(handOverBg, fg, (d * BLEND_FULL + COVERAGE_FULL / 2) / COVERAGE_FULL);
+      if (fromPanelOrder(palette[i]) != expected) wrong++;
+    }
+    CHECK_EQ(wrong, 0);
+  }
+}
+
+TEST_CASE(modeScreensKeepTheirColors) {
+  static uint8_t indexed[DISPLAY_PIXELS];
+  static uint16_t direct[DISPLAY_PIXELS];
+  FrameCanvas canvas(DISPLAY_WIDTH, DISPLAY_HEIGHT, indexed);
+  PanelCanvas reference(DISPLAY_WIDTH, DISPLAY_HEIGHT, direct);
+
+  // Up to 256 colors are stored exactly
+  Adafruit_GFX* targets[2] = {&canvas, &reference};
+  for (Adafruit_GFX* gfx : targets) {
+    gfx->fillScreen(GC9A01A_BLUE);
+    for (uint16_t i = 0; i < 250; i++) gfx->drawFastHLine(0, i % DISPLAY_HEIGHT, i + 1, (uint16_t)(i * 257 + 1));
+    gfx->setTextColor(GC9A01A_WHITE);
+    gfx->setTextSize(2);
+    gfx->setCursor(30, 80);
+    gfx->print("Downloading");
+  }
+  int32_t wrong = 0;
+  for (int32_t i = 0; i < DISPLAY_PIXELS; i++) {
+    if (canvas.palette()[indexed[i]] != direct[i]) wrong++;
+  }
+  CHECK_EQ(wrong, 0);
+
+  // Beyond that, new colors fall back to the closest stored one
+  canvas.fillScreen(0x0000);
+  for (uint16_t i = 1; i < FRAME_PALETTE_SIZE; i++) canvas.drawPixel(i % DISPLAY_WIDTH, i / DISPLAY_WIDTH, i << 6);
+  canvas.drawPixel(0, 2, (100 << 6) | 1);
+  CHECK_EQ(fromPanelOrder(canvas.palette()[indexed[2 * DISPLAY_WIDTH]]), 100 << 6);
+}
@@ -0,0 +1,113 @@
+// Keyframe queue: a sequence played under a jittery loop() keeps every keyframe
+// on the ideal timeline, where chaining from millis() drifts; capacity and clear
+
+#include "host_test.h"
+#include "pixel/keyframe_queue.h"
+
+const uint8_t SEQUENCE_LENGTH = 20;
+
+static Keyframe makeKeyframe(uint32_t durationMs, uint16_t delayMs) {
+  Keyframe keyframe = {};
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    keyframe.easings[i] = TRANSITION_EASE_IN_OUT;
+    keyframe.durationsMs[i] = durationMs;
+  }
+  keyframe.colorDurationMs = durationMs;
+  keyframe.delayMs = delayMs;
+  return keyframe;
+}
+
+// loop() period: 16-40 ms frames with an occasional 150 ms stall
+static uint32_t nextLoopStep() {
+  uint32_t step = 16 + random(25);
+  if (random(50) == 0) step += 150;
+  return step;
+}
+
+TEST_CASE(sequenceStaysOnTheIdealTimeline) {
+  randomSeed(7);
+  const uint32_t t0 = 1000;
+  Keyframe keyframes[SEQUENCE_LENGTH];
+  uint32_t ideal[SEQUENCE_LENGTH];
+  uint32_t end = t0;
+  KeyframeQueue queue;
+  for (uint8_t i = 0; i < SEQUENCE_LENGTH; i++) {
+    keyframes[i] = makeKeyframe(100 + random(700), (i % 3 == 0) ? random(200) : 0);
+    ideal[i] = end + keyframes[i].delayMs;
+    end = ideal[i] + keyframes[i].spanMs();
+    CHECK(queue.push(keyframes[i], t0));
+  }
+
+  // Scheduled: start times come from the queue
+  randomSeed(11);
+  int32_t worstScheduled = 0;
+  uint8_t started = 0;
+  for (uint32_t now = t0; now < end + 2000; now += nextLoopStep()) {
+    Keyframe keyframe;
+    uint32_t startMs;
+    while (queue.popDue(now, keyframe, startMs)) {
+      worstScheduled = max(worstScheduled, abs((int32_t)(startMs - ideal[started])));
+      started++;
+    }
+  }
+  CHECK_EQ(started, SEQUENCE_LENGTH);
+
+  // Chained from millis(): each keyframe starts when loop() notices the previous one ended
+  randomSeed(11);
+  int32_t lastNaive = 0;
+  int32_t worstNaive = 0;
+  uint8_t naiveStarted = 0;
+  uint32_t naiveNext = t0 + keyframes[0].delayMs;
+  for (uint32_t now = t0; now < end + 2000 && naiveStarted < SEQUENCE_LENGTH; now += nextLoopStep()) {
+    while (naiveStarted < SEQUENCE_LENGTH && (int32_t)(now - naiveNext) >= 0) {
+      lastNaive = (int32_t)(now - ideal[naiveStarted]);
+      worstNaive = max(worstNaive, abs(lastNaive));
+      uint32_t gap = naiveStarted + 1 < SEQUENCE_LENGTH ? keyframes[naiveStarted + 1].delayMs : 0;
+      naiveNext = now + keyframes[naiveStarted].spanMs() + gap;
+      naiveStarted++;
+    }
+  }
+
+  REPORT("scheduled: worst start error %d ms", worstScheduled);
+  REPORT("millis() chaining: keyframe %u starts %d ms late, worst %d ms", SEQUENCE_LENGTH, lastNaive, worstNaive);
+  CHECK_EQ(worstScheduled, 0);
+  CHECK(worstNaive > 100);
+}
+
+TEST_CASE(missedKeyframesAllComeDue) {
+  KeyframeQueue queue;
+  for (uint8_t i = 0; i < 5; i++) queue.push(makeKeyframe(100, 10), 0);
+  // A 2 s stall: every keyframe is due at once, still in order and on schedule
+  Keyframe keyframe;
+  uint32_t startMs;
+  uint32_t expected = 10;
+  uint8_t popped = 0;
+  while (queue.popDue(2000, keyframe, startMs)) {
+    CHECK_EQ(startMs, expected);
+    expected += 110;
+    popped++;
+  }
+  CHECK_EQ(popped, 5);
+  CHECK(queue.isEmpty());
+}
+
+TEST_CASE(capacityAndClear) {
+  KeyframeQueue queue;
+  for (uint8_t i = 0; i < KEYFRAME_QUEUE_SIZE; i++) CHECK(queue.push(makeKeyframe(100, 0), 0));
+  CHECK(!queue.push(makeKeyframe(100, 0), 0));
+  CHECK_EQ(queue.size(), KEYFRAME_QUEUE_SIZE);
+
+  // A sequence queued after a clear waits for the running transition
+  queue.clear(5000);
+  CHECK(queue.isEmpty());
+  queue.push(makeKeyframe(100, 20), 1000);
+  CHECK_EQ(queue.nextStartMs(), 5020u);
+  Keyframe keyframe;
+  uint32_t startMs;
+  CHECK(!queue.popDue(5019, keyframe, startMs));
+  CHECK(queue.popDue(5020, keyframe, startMs));
+
+  // Queued while idle: counts from now
+  queue.push(makeKeyframe(100, 0), 9000);
+  CHECK_EQ(queue.nextStartMs(), 9000u);
+}
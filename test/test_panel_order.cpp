@@ -0,0 +1,99 @@
+// Panel byte order: PanelCanvas stores every primitive in wire order, and a
+// panel-order frame goes out as bulk rows with the same image as the old
+// per-pixel push that swapped each color on the way
+
+#include "host_test.h"
+#include "clock_frame.h"
+#include "pixel/panel_canvas.h"
+#include "pixel/display_bus.h"
+
+// Draw the same mix of primitives on any GFX target
+static void drawPrimitives(Adafruit_GFX& gfx) {
+  gfx.fillScreen(0x1234);
+  gfx.drawPixel(3, 4, 0xF800);
+  gfx.drawFastHLine(-5, 10, 40, 0x07E0);
+  gfx.drawFastVLine(20, 200, 80, 0x001F);
+  // Every start alignment and width around the 32-bit span fill's edges
+  for (int16_t x = 0; x < 4; x++) {
+    for (int16_t w = 1; w <= 7; w++) gfx.fillRect(x + w * 12, 30 + x * 3, w, 2, 0xABCD);
+  }
+  gfx.fillRect(230, 230, 20, 20, 0x5555);
+  gfx.fillCircle(120, 160, 30, 0x8410);
+  gfx.fillTriangle(10, 100, 60, 140, 5, 180, 0x3333);
+  gfx.setTextColor(0xFFFF);
+  gfx.setTextSize(2);
+  gfx.setCursor(30, 60);
+  gfx.print("Pixel 12");
+}
+
+TEST_CASE(panelCanvasStoresWireOrder) {
+  static uint16_t pixels[DISPLAY_PIXELS];
+  PanelCanvas canvas(DISPLAY_WIDTH, DISPLAY_HEIGHT, pixels);
+  GFXcanvas16 host(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  drawPrimitives(canvas);
+  drawPrimitives(host);
+
+  int32_t wrongBytes = 0;
+  int32_t wrongReads = 0;
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+    for (int16_t x = 0; x < DISPLAY_WIDTH; x++) {
+      uint16_t expected = host.getBuffer()[y * DISPLAY_WIDTH + x];
+      if (pixels[y * DISPLAY_WIDTH + x] != toPanelOrder(expected)) wrongBytes++;
+      if (canvas.getPixel(x, y) != expected) wrongReads++;
+    }
+  }
+  CHECK_EQ(wrongBytes, 0);
+  CHECK_EQ(wrongReads, 0);
+}
+
+// The push before panel order: host-order pixels, one drawPixel (and swap) each
+static void pushPerPixel(Adafruit_GC9A01A& tft, const uint16_t* hostPixels) {
+  tft.startWrite();
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+    const CircleSpan& span = panelMask().row(y);
+    for (int16_t x = span.x; x < span.x + span.len; x++) tft.drawPixel(x, y, hostPixels[y * DISPLAY_WIDTH + x]);
+  }
+  tft.endWrite();
+}
+
+TEST_CASE(bulkPushMatchesPerPixelPush) {
+  const int frames = 100;
+  static Adafruit_GC9A01A perPixelPanel;
+  static Adafruit_GC9A01A bulkPanel;
+  GC9A01ABus bus(bulkPanel);
+  static uint16_t frame[DISPLAY_PIXELS];
+  static uint16_t hostFrame[DISPLAY_PIXELS];
+
+  ClockFrame clock = {{10, 130, 250}, colorPalette[7].bg, colorPalette[7].fg, colorPalette[7].fg};
+  renderReference(clock, frame);
+  for (int32_t i = 0; i < DISPLAY_PIXELS; i++) hostFrame[i] = fromPanelOrder(frame[i]);
+
+  HostStopwatch perPixelClock;
+  for (int f = 0; f < frames; f++) pushPerPixel(perPixelPanel, hostFrame);
+  double perPixelNs = perPixelClock.elapsedNs() / frames;
+
+  HostStopwatch bulkClock;
+  for (int f = 0; f < frames; f++) {
+    bus.pushMaskedWindow(0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT, frame, DISPLAY_WIDTH, panelMask());
+  }
+  double bulkNs = bulkClock.elapsedNs() / frames;
+
+  int32_t different = 0;
+  for (int16_t y = 0; y < DISPLAY_HEIGHT; y++) {
+    const CircleSpan& span = panelMask().row(y);
+    for (int16_t x = span.x; x < span.x + span.len; x++) {
+      if (perPixelPanel.pixel(x, y) != bulkPanel.pixel(x, y)) different++;
+    }
+  }
+  CHECK_EQ(different, 0);
+  CHECK_EQ(countVisibleMismatches(bulkPanel.pixels, frame), 0);
+
+  // Host times include the shim panel storing every pixel, so only the gap matters
+  REPORT("per-pixel: %6u calls, %6u swaps, %8.0f ns/frame",
+         (perPixelPanel.pixelWrites + perPixelPanel.bulkWrites) / frames, perPixelPanel.pixelsSwapped / frames, perPixelNs);
+  REPORT("bulk rows: %6u calls, %6u swaps, %8.0f ns/frame",
+         (bulkPanel.pixelWrites + bulkPanel.bulkWrites) / frames, bulkPanel.pixelsSwapped / frames, bulkNs);
+  CHECK_EQ(perPixelPanel.pixelWrites / frames, panelMask().visiblePixels());
+  CHECK_EQ(bulkPanel.bulkWrites / frames, DISPLAY_HEIGHT);
+  CHECK_EQ(bulkPanel.pixelsSwapped, 0);
+}
@@ -0,0 +1,87 @@
+// Spin motion: a spinning hand's angle against the exact phase + velocity * t
+// over ten minutes of frames and over days (across a rebase and a millis()
+// wrap), compared with summing per-frame float increments. The hand spins
+// through hand_motion.h, as in main.cpp.
+
+#include <random>
+#include "host_test.h"
+#include "pixel/hand_motion.h"
+
+static EasingCurves curves;  // None uploaded (spinning hands do not use them)
+
+static double angleError(double a, double b) {
+  double d = fmod(a - b, 360.0);
+  if (d < -180) d += 360;
+  if (d > 180) d -= 360;
+  return fabs(d);
+}
+
+struct SpinCase {
+  float degreesPerSecond;
+  float phase;
+};
+
+static const SpinCase CASES[] = {{6.0f, 0}, {24.0f, 45}, {-24.123f, 200}, {0.1f, 90}, {1.0f / 120, 300}, {720.0f, 10}};
+
+struct SpinErrors {
+  double worst;       // Rendered spin angle
+  double naiveWorst;  // Per-frame float accumulation (frame runs only)
+};
+
+// Frames every frameMs..frameMs + jitterMs from a start just before millis() wraps
+static SpinErrors playSpin(const SpinCase& c, uint64_t durationMs, uint32_t frameMs, uint32_t jitterMs) {
+  int32_t arcsec = (int32_t)lround(c.degreesPerSecond * (double)SPIN_ARCSEC_PER_DEGREE);
+  double exactVelocity = arcsec / (double)SPIN_ARCSEC_PER_DEGREE;  // As sent
+  const uint32_t start = 4000000000u;
+  spin_angle_t phase = spinAngleFromDegrees(c.phase);
+  double phaseDegrees = phase * (360.0 / 4294967296.0);
+
+  HandStates hands = {};
+  startSpin(hands, 0, arcsec, true, phase, start, 0);
+
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> jitter(0, 1);
+  float naive = c.phase;
+  uint32_t last = start;
+  SpinErrors errors = {0, 0};
+  for (uint64_t t = 0; t <= durationMs; t += frameMs + (uint64_t)(jitter(rng) * jitterMs)) {
+    uint32_t now = start + (uint32_t)t;
+    updateHands(hands, curves, now);
+    float rendered = hands.currentAngle[0];
+    double ideal = fmod(phaseDegrees + exactVelocity * (t / 1000.0), 360.0);
+    errors.worst = max(errors.worst, angleError(rendered, ideal));
+
+    naive = wrapDegrees(naive + c.degreesPerSecond * ((now - last) / 1000.0f));
+    last = now;
+    errors.naiveWorst = max(errors.naiveWorst, angleError(naive, ideal));
+  }
+  return errors;
+}
+
+TEST_CASE(tenMinutesOfFramesStayExact) {
+  for (const SpinCase& c : CASES) {
+    SpinErrors e = playSpin(c, 10 * 60000ull, 16, 3);
+    REPORT("%9.4f deg/s: max error %.6f deg (per-frame float accumulation %.4f deg)", c.degreesPerSecond, e.worst,
+           e.naiveWorst);
+    CHECK(e.worst < 0.0001);
+  }
+}
+
+TEST_CASE(daysAcrossRebaseStayExact) {
+  const uint32_t days[] = {1, 20};  // 20 days passes SPIN_REBASE_MS
+  for (uint32_t d : days) {
+    double worst = 0;
+    for (const SpinCase& c : CASES) worst = max(worst, playSpin(c, d * 86400000ull, 997, 50).worst);
+    REPORT("%2u days, a frame a second: max error %.6f deg", d, worst);
+    CHECK(worst < 0.0001);
+  }
+}
+
+TEST_CASE(reverseSpinWrapsAndSpeedIsClamped) {
+  // Half a turn back from 90 degrees lands on 270
+  int64_t velocity = spinVelocityFromArcsec(-180 * SPIN_ARCSEC_PER_DEGREE);
+  CHECK(fabsf(spinAngleToDegrees(spinAngleAt(spinAngleFromDegrees(90), velocity, 1000)) - 270) < 0.001f);
+  // Beyond 100 turns/s the velocity is clamped
+  CHECK_EQ(spinVelocityFromArcsec(INT32_MAX), spinVelocityFromArcsec(SPIN_MAX_ARCSEC_PER_S));
+  CHECK_EQ(spinVelocityFromArcsec(-INT32_MAX), spinVelocityFromArcsec(-SPIN_MAX_ARCSEC_PER_S));
+}
@@ -0,0 +1,137 @@
+// Spring motion (built twice: float, and Q16 with USE_FIXED_POINT_MATH): the
+// hand's angle does not depend on the frame rate, a retarget carries the
+// velocity, and springSettleMs() against the measured settle time. The hands
+// run through hand_motion.h, as in main.cpp.
+
+#include <random>
+#include <vector>
+#include "host_test.h"
+#include "pixel/hand_motion.h"
+
+static EasingCurves curves;  // None uploaded (spring hands do not use them)
+
+// Start all three hands on a spring toward targetAngle (direction picked like
+// DIR_SHORTEST); a spring hand still moving carries its velocity
+static void startSpring(HandStates& hands, float targetAngle, uint32_t now, float hz, float zeta) {
+  HandMotion motion = {};
+  for (uint8_t i = 0; i < HANDS_PER_PIXEL; i++) {
+    motion.targets[i] = targetAngle;
+    motion.dirs[i] = (targetAngle >= hands.currentAngle[i]) ? 1 : -1;
+    motion.easings[i] = TRANSITION_SPRING;
+  }
+  motion.springFrequencyHz = hz;
+  motion.springDampingRatio = zeta;
+  startHands(hands, motion, now);
+}
+
+struct FrameAngle {
+  uint32_t ms;
+  double angle;
+};
+
+// 0 -> 170 degrees, retargeted to 20 degrees at 300 ms with the velocity carried,
+// rendered at fps with +/-15% frame jitter; the settle time, every frame's angle
+static uint32_t playRetarget(double fps, float hz, float zeta, uint32_t seed, std::vector<FrameAngle>& frames) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> jitter(-0.15, 0.15);
+  HandStates hands = {};
+  startSpring(hands, 170, 0, hz, zeta);
+  bool retargeted = false;
+  for (double t = 0; t <= 20000; t += 1000.0 / fps * (1 + jitter(rng))) {
+    uint32_t now = (uint32_t)t;
+    if (!retargeted && now >= 300) {
+      startSpring(hands, 20, 300, hz, zeta);
+      retargeted = true;
+    }
+    updateHands(hands, curves, now);
+    if (!(hands.activeMask & 1)) return now;
+    frames.push_back({now, hands.currentAngle[0]});
+  }
+  return 0;
+}
+
+struct SpringSetting {
+  float hz;
+  float zeta;
+};
+
+static const SpringSetting SETTINGS[] = {{1.5f, 1.0f}, {2.0f, 0.4f}, {0.8f, 1.5f}, {5.0f, 0.2f}};
+
+TEST_CASE(frameRateDoesNotChangeTheMotion) {
+  for (const SpringSetting& s : SETTINGS) {
+    std::vector<FrameAngle> reference;
+    uint32_t referenceSettle = playRetarget(1000, s.hz, s.zeta, 1, reference);
+    CHECK(referenceSettle > 0);
+    for (double fps : {20.0, 30.0, 60.0}) {
+      std::vector<FrameAngle> frames;
+      uint32_t settle = playRetarget(fps, s.hz, s.zeta, 7, frames);
+      // Each frame against the 1 kHz run at the same millisecond
+      double worst = 0;
+      size_t r = 0;
+      for (const FrameAngle& f : frames) {
+        while (r < reference.size() && reference[r].ms < f.ms) r++;
+        if (r < reference.size() && reference[r].ms == f.ms) worst = max(worst, fabs(reference[r].angle - f.angle));
+      }
+      REPORT("%.1f Hz zeta %.2f, %2.0f fps: settled at %u ms (1 kHz reference %+d), max deviation %.4f deg", s.hz,
+             s.zeta, fps, settle, (int)(settle - referenceSettle), worst);
+      CHECK_EQ(worst, 0.0);
+      // Settles on the first frame after the reference does
+      CHECK(settle >= referenceSettle);
+      CHECK(settle - referenceSettle < 1000.0 / fps * 1.15 + 1);
+    }
+  }
+}
+
+// Hand 0's spring velocity, clockwise (the spring runs along the hand's path)
+static float clockwiseDps(const HandStates& hands) {
+  return springToDegrees(hands.springVelocity[0]) * springHeading(hands, 0);
+}
+
+TEST_CASE(retargetCarriesVelocity) {
+  HandStates before = {};
+  startSpring(before, 170, 0, 1.5f, 1.0f);
+  updateHands(before, curves, 300);
+  HandStates carried = before;
+  startSpring(carried, 20, 300, 1.5f, 1.0f);
+  updateHands(carried, curves, 304);
+  HandStates fromRest = before;
+  fromRest.activeMask = 0;  // Same angle, but at rest
+  startSpring(fromRest, 20, 300, 1.5f, 1.0f);
+  updateHands(fromRest, curves, 304);
+  float beforeDps = clockwiseDps(before);
+  float carriedDps = clockwiseDps(carried);
+  float fromRestDps = clockwiseDps(fromRest);
+  REPORT("retarget at 300 ms: %.1f deg/s before, one step later %.1f carried, %.1f from rest",
+         beforeDps, carriedDps, fromRestDps);
+  // Still heading on toward 170 rather than snapping back toward 20
+  CHECK(carriedDps > 100);
+  CHECK(fromRestDps < 0);
+}
+
+TEST_CASE(settleEstimateTracksMeasurement) {
+  double shortest = 1;
+  double longest = 1;
+  for (float hz : {0.5f, 1.5f, 4.0f}) {
+    for (float zeta : {0.1f, 0.3f, 0.6f, 0.9f, 1.0f, 1.2f, 2.0f}) {
+      SpringCoefficients k = SpringCoefficients::of(hz, zeta);
+      spring_t position = 0;
+      spring_t velocity = 0;
+      spring_t target = springFromDegrees(180);
+      uint32_t steps = 0;
+      while (!springSettled(position, velocity, target) && steps < 100000) {
+        springStep(position, velocity, target, k.stiffness, k.damping);
+        steps++;
+      }
+      uint32_t measured = steps * SPRING_STEP_MS;
+      uint32_t estimate = springSettleMs(hz, zeta);
+      shortest = min(shortest, (double)estimate / measured);
+      longest = max(longest, (double)estimate / measured);
+      CHECK(steps < 100000);
+    }
+  }
+  REPORT("180 degree sweep from rest: springSettleMs() %.0f%% short to %.0f%% long of the measured settle time",
+         (1 - shortest) * 100, (longest - 1) * 100);
+  // Keyframes after a spring may start a little early, never much
+  CHECK(shortest > 0.9);
+  CHECK(longest < 1.5);
+}
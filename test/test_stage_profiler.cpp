@@ -0,0 +1,75 @@
+// Stage profiler (built with USE_STAGE_PROFILER): histogram percentiles against
+// the exact ones, timing through the PROFILE_* macros, and the cost of a record
+
+#include <random>
+#include <vector>
+#include "host_test.h"
+#include "pixel/stage_profiler.h"
+
+TEST_CASE(percentilesLandInTheRightBucket) {
+  StageProfiler::reset();
+  const uint32_t mhz = ESP.getCpuFreqMHz();
+  // Frame times around 5 ms with a long tail
+  std::mt19937 rng(1);
+  std::lognormal_distribution<double> frameCycles(log(5000.0 * mhz), 0.5);
+  std::vector<uint32_t> samples;
+  for (int i = 0; i < 100000; i++) {
+    uint32_t cycles = (uint32_t)frameCycles(rng);
+    samples.push_back(cycles);
+    StageProfiler::record(PROFILE_FRAME, cycles);
+  }
+  std::sort(samples.begin(), samples.end());
+  auto exactUs = [&](uint8_t percent) { return samples[(samples.size() * percent + 99) / 100 - 1] / mhz; };
+
+  StageSummary s = StageProfiler::summarize(PROFILE_FRAME);
+  REPORT("p50 %u us (exact %u), p95 %u us (exact %u), p99 %u us (exact %u), max %u us (exact %u)", s.p50Us,
+         exactUs(50), s.p95Us, exactUs(95), s.p99Us, exactUs(99), s.maxUs, samples.back() / mhz);
+  CHECK_EQ(s.samples, 100000u);
+  CHECK_EQ(s.maxUs, samples.back() / mhz);
+  // Reported as the bucket's upper bound: at or above the exact value, at most
+  // one bucket (25%) above it
+  const uint32_t reported[3] = {s.p50Us, s.p95Us, s.p99Us};
+  const uint8_t percents[3] = {50, 95, 99};
+  for (uint8_t i = 0; i < 3; i++) {
+    CHECK(reported[i] >= exactUs(percents[i]));
+    CHECK(reported[i] <= exactUs(percents[i]) * 5 / 4 + 1);
+  }
+}
+
+TEST_CASE(extremeSamplesStayInRange) {
+  // A single sample: every percentile is clamped to the max, which is exact
+  const uint32_t edges[] = {0, 1023, 1024, 1279, 1280, 2047, 2048, (1u << 30) - 1, 1u << 30, 0xFFFFFFFFu};
+  for (uint32_t cycles : edges) {
+    StageProfiler::reset();
+    StageProfiler::record(PROFILE_PUSH, cycles);
+    StageSummary s = StageProfiler::summarize(PROFILE_PUSH);
+    CHECK_EQ(s.samples, 1u);
+    CHECK_EQ(s.p50Us, cycles / ESP.getCpuFreqMHz());
+    CHECK_EQ(s.p99Us, s.maxUs);
+  }
+  // Other stages are untouched
+  CHECK_EQ(StageProfiler::summarize(PROFILE_RASTER).samples, 0u);
+}
+
+TEST_CASE(macrosTimeTheStage) {
+  StageProfiler::reset();
+  for (uint32_t us = 100; us <= 1000; us += 100) {
+    PROFILE_BEGIN(start);
+    hostAdvanceMicros(us);
+    PROFILE_END(PROFILE_UPDATE, start);
+  }
+  StageSummary s = StageProfiler::summarize(PROFILE_UPDATE);
+  CHECK_EQ(s.samples, 10u);
+  CHECK_EQ(s.maxUs, 1000u);
+  CHECK(s.p50Us >= 500 && s.p50Us <= 625);
+}
+
+TEST_CASE(benchmarkRecord) {
+  StageProfiler::reset();
+  const uint32_t records = 50000000;
+  HostStopwatch clock;
+  for (uint32_t i = 0; i < records; i++) StageProfiler::record(PROFILE_RASTER, (i * 2654435761u) >> 8);
+  double ns = clock.elapsedNs() / records;
+  CHECK_EQ(StageProfiler::summarize(PROFILE_RASTER).samples, records);
+  REPORT("record: %.2f ns", ns);
+}
@@ -0,0 +1,182 @@
+// Stream player: sampled motion over a lossy, jittery link played back as a
+// curve, against restarting a linear transition on every packet; sequence gaps,
+// clock offset and the end of a stream
+
+#include <random>
+#include <vector>
+#include "host_test.h"
+#include "pixel/stream_player.h"
+
+// Truth in degrees: a fast swing, a steady rotation through 0/360, a 1.2 Hz swing
+static float truth(double ms, uint8_t hand) {
+  double t = ms / 1000.0;
+  if (hand == 0) return 180 + 150 * sin(2 * M_PI * 0.5 * t);  // ~470 deg/s peak
+  if (hand == 1) return fmod(90 * t, 360.0);
+  return 90 + 60 * sin(2 * M_PI * 1.2 * t + 1);
+}
+
+static float angleError(float a, float b) {
+  float d = fmodf(a - b, 360.0f);
+  if (d < -180) d += 360;
+  if (d > 180) d -= 360;
+  return fabsf(d);
+}
+
+struct StreamErrors {
+  double mean[2];    // Stream player, per-packet restart
+  double worst[2];
+  uint32_t lost;     // Dropped by the link
+  uint32_t skipped;  // Counted by the player (also overtaken by a newer packet)
+};
+
+// 60 s at rateHz with lossRate random loss, 3-15 ms latency plus occasional
+// 30 ms stalls, rendered at a jittered ~60 fps on an unrelated local clock
+static StreamErrors playStream(double lossRate, uint32_t rateHz) {
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  const uint32_t masterBase = 50000;
+  const uint32_t localBase = 1234567;
+  const uint32_t interval = 1000 / rateHz;
+  const uint32_t durationMs = 60000;
+
+  struct Delivery {
+    uint32_t receivedMs;
+    uint16_t sequence;
+    uint32_t masterMs;
+  };
+  std::vector<Delivery> deliveries;
+  StreamErrors errors = {};
+  uint16_t sequence = 0;
+  for (uint32_t m = 0; m < durationMs; m += interval) {
+    uint16_t s = sequence++;
+    if (uniform(rng) < lossRate) {
+      errors.lost++;
+      continue;
+    }
+    uint32_t latency = 3 + (uint32_t)(uniform(rng) * 12) + (uniform(rng) < 0.05 ? 30 : 0);
+    deliveries.push_back({localBase + m + latency, s, masterBase + m});
+  }
+  std::sort(deliveries.begin(), deliveries.end(),
+            [](const Delivery& a, const Delivery& b) { return a.receivedMs < b.receivedMs; });
+
+  StreamPlayer player;
+  // Per-packet restart: a linear one-interval transition from the current angle
+  float naiveCurrent[HANDS_PER_PIXEL] = {};
+  float naiveStart[HANDS_PER_PIXEL] = {};
+  float naiveTarget[HANDS_PER_PIXEL] = {};
+  uint32_t naiveStartMs = 0;
+  bool naiveStarted = false;
+
+  double sum[2] = {0, 0};
+  uint32_t samples = 0;
+  size_t next = 0;
+  for (double frameMs = localBase; frameMs < localBase + durationMs; frameMs += 16.0 + uniform(rng) * 2.0) {
+    uint32_t now = (uint32_t)frameMs;
+    for (; next < deliveries.size() && deliveries[next].receivedMs <= now; next++) {
+      const Delivery& d = deliveries[next];
+      float angles[HANDS_PER_PIXEL];
+      for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+        angles[h] = streamAngleToFloat(floatToStreamAngle(truth(d.masterMs - masterBase, h)));
+      }
+      player.addSample(d.sequence, d.masterMs, d.receivedMs, angles);
+      for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+        if (!naiveStarted) naiveCurrent[h] = angles[h];
+        naiveStart[h] = naiveCurrent[h];
+        float delta = angles[h] - naiveCurrent[h];
+        delta -= 360 * floorf((delta + 180) / 360);
+        naiveTarget[h] = naiveCurrent[h] + delta;
+      }
+      naiveStarted = true;
+      naiveStartMs = d.receivedMs;
+    }
+
+    float angles[HANDS_PER_PIXEL];
+    if (!player.anglesAt(now, angles) || now <= localBase + 1000) continue;
+    float p = min(1.0f, (now - naiveStartMs) / (float)interval);
+    for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) {
+      naiveCurrent[h] = naiveStart[h] + (naiveTarget[h] - naiveStart[h]) * p;
+      // The player against the truth at its playback delay; the restart against
+      // the truth at its best-aligned lag (one interval plus mean latency)
+      float e0 = angleError(angles[h], truth(now - localBase - STREAM_PLAYBACK_DELAY_MS, h));
+      float e1 = angleError(naiveCurrent[h], truth((double)now - localBase - interval - 9, h));
+      sum[0] += e0;
+      sum[1] += e1;
+      errors.worst[0] = max(errors.worst[0], (double)e0);
+      errors.worst[1] = max(errors.worst[1], (double)e1);
+      samples++;
+    }
+  }
+  errors.mean[0] = sum[0] / samples;
+  errors.mean[1] = sum[1] / samples;
+  errors.skipped = player.lost();
+  return errors;
+}
+
+TEST_CASE(playbackFollowsLossyStream) {
+  const uint32_t rates[] = {30, 20};
+  for (uint32_t rateHz : rates) {
+    StreamErrors e = playStream(0.10, rateHz);
+    REPORT("%u Hz, 10%% loss (%u lost, %u skipped by the player):", rateHz, e.lost, e.skipped);
+    REPORT("  stream player mean %.2f max %.1f deg; per-packet restart mean %.2f max %.1f deg", e.mean[0],
+           e.worst[0], e.mean[1], e.worst[1]);
+    CHECK(e.mean[0] < e.mean[1]);
+    CHECK(e.worst[0] < e.worst[1]);
+    if (rateHz == 30) {
+      CHECK(e.mean[0] < 1.0);
+      CHECK(e.worst[0] < 10.0);
+    }
+  }
+}
+
+TEST_CASE(lateAndDuplicateSamplesAreSkipped) {
+  StreamPlayer player;
+  const float a[HANDS_PER_PIXEL] = {10, 20, 30};
+  const float b[HANDS_PER_PIXEL] = {50, 60, 70};
+  const float stale[HANDS_PER_PIXEL] = {300, 300, 300};
+  player.addSample(1, 0, 1000, a);
+  player.addSample(3, 100, 1100, b);      // Sequence 2 lost
+  player.addSample(2, 50, 1120, stale);   // Arrives after a newer one
+  player.addSample(3, 100, 1130, stale);  // Duplicate
+  CHECK_EQ(player.lost(), 1u);
+
+  // Offset 1000 from the fastest delivery; halfway between the two samples
+  float angles[HANDS_PER_PIXEL];
+  CHECK(player.anglesAt(1000 + 50 + STREAM_PLAYBACK_DELAY_MS, angles));
+  for (uint8_t h = 0; h < HANDS_PER_PIXEL; h++) CHECK(fabsf(angles[h] - (a[h] + b[h]) / 2) < 0.01f);
+}
+
+TEST_CASE(unwrapsThroughZero) {
+  StreamPlayer player;
+  const float first[HANDS_PER_PIXEL] = {350, 10, 180};
+  const float second[HANDS_PER_PIXEL] = {10, 350, 180};
+  player.addSample(0, 0, 0, first);
+  player.addSample(1, 100, 100, second);
+  float angles[HANDS_PER_PIXEL];
+  CHECK(player.anglesAt(50 + STREAM_PLAYBACK_DELAY_MS, angles));
+  CHECK(fabsf(angles[0] - 360) < 0.01f);
+  CHECK(fabsf(angles[1] - 0) < 0.01f);
+}
+
+TEST_CASE(extrapolatesThenHoldsThenEnds) {
+  StreamPlayer player;
+  const float first[HANDS_PER_PIXEL] = {0, 0, 0};
+  const float second[HANDS_PER_PIXEL] = {10, 20, 30};
+  player.addSample(0, 0, 0, first);
+  player.addSample(1, 100, 100, second);
+  float angles[HANDS_PER_PIXEL];
+
+  // 100 ms past the newest sample: along the last velocity
+  CHECK(player.anglesAt(200 + STREAM_PLAYBACK_DELAY_MS, angles));
+  CHECK(fabsf(angles[0] - 20) < 0.01f);
+  CHECK(fabsf(angles[2] - 60) < 0.01f);
+
+  // Past STREAM_EXTRAPOLATE_MS: held
+  CHECK(player.anglesAt(100 + STREAM_EXTRAPOLATE_MS + 300 + STREAM_PLAYBACK_DELAY_MS, angles));
+  CHECK(fabsf(angles[0] - (10 + STREAM_EXTRAPOLATE_MS * 0.1f)) < 0.01f);
+
+  // No sample for STREAM_TIMEOUT_MS: the stream is over
+  CHECK(player.isActive(100 + STREAM_TIMEOUT_MS - 1));
+  CHECK(!player.anglesAt(100 + STREAM_TIMEOUT_MS, angles));
+  player.reset();
+  CHECK(!player.isActive(101));
+}
@@ -0,0 +1,157 @@
+// Wave broadcast: group start times of a wave sent as one packet with per-pixel
+// start slots, against the old one packet per group from a jittery master loop
+
+#include "host_test.h"
+#include "pixel/keyframe_queue.h"
+
+const uint8_t WAVE_PATTERNS = 6;
+
+// Group order of each wave pattern: columns left/right, rows top/bottom, center out, edges in
+static const uint8_t WAVE_ORDERS[WAVE_PATTERNS][8] = {
+  {0, 1, 2, 3, 4, 5, 6, 7}, {7, 6, 5, 4, 3, 2, 1, 0}, {0, 1, 2}, {2, 1, 0},
+  {3, 4, 2, 5, 1, 6, 0, 7}, {0, 7, 1, 6, 2, 5, 3, 4},
+};
+static const uint8_t WAVE_GROUPS[WAVE_PATTERNS] = {8, 8, 3, 3, 8, 8};
+
+const uint32_t RADIO_LATENCY_MS = 3;
+
+// Position of a pixel's column (or row) in the wave order
+static uint8_t groupOf(uint8_t pattern, const uint8_t* order, uint8_t pixel) {
+  uint8_t line = (pattern == 2 || pattern == 3) ? pixel / GRID_COLUMNS : pixel % GRID_COLUMNS;
+  for (uint8_t k = 0; k < WAVE_GROUPS[pattern]; k++) {
+    if (order[k] == line) return k;
+  }
+  return 0;
+}
+
+// Time from receipt until loop() applies a command
+static uint32_t applyLatency() { return random(30); }
+
+struct WaveErrors {
+  int32_t worst[2] = {0, 0};  // Per stage (second stage: ping-pong reverse)
+};
+
+// Old master: one CMD_SET_ANGLES per group, sent when its loop (1-20 ms period)
+// sees baseGroupDelay elapsed since the previous send; pixels start on receipt
+static void playPerGroupPackets(uint8_t pattern, bool pingPong, uint32_t groupDelay, int32_t start[2][MAX_PIXELS]) {
+  uint8_t groups = WAVE_GROUPS[pattern];
+  uint8_t order[8];
+  memcpy(order, WAVE_ORDERS[pattern], groups);
+  uint8_t stage = 0;
+  auto send = [&](uint8_t group, uint32_t now) {
+    for (uint8_t p = 0; p < MAX_PIXELS; p++) {
+      if (groupOf(pattern, order, p) == group) start[stage][p] = now + RADIO_LATENCY_MS + applyLatency();
+    }
+  };
+
+  uint32_t now = 0;
+  uint32_t lastSend = 0;
+  uint8_t group = 0;
+  send(0, now);
+  while (true) {
+    now += 1 + random(20);
+    if (now - lastSend < groupDelay) continue;
+    if (++group < groups) {
+      send(group, now);
+    } else if (pingPong && stage == 0) {
+      stage = 1;
+      for (uint8_t k = 0; k < groups; k++) order[k] = WAVE_ORDERS[pattern][groups - 1 - k];
+      group = 0;
+      send(0, now);
+    } else {
+      break;
+    }
+    lastSend = now;
+  }
+}
+
+// New master: one packet per stage carrying every pixel's start slot; each pixel
+// queues the motion at receipt + its delay and its loop (16-40 ms) starts it
+static void playBroadcast(uint8_t pattern, bool pingPong, uint32_t groupDelay, int32_t start[2][MAX_PIXELS]) {
+  uint8_t groups = WAVE_GROUPS[pattern];
+  uint8_t order[8];
+  uint32_t now = 0;
+  uint32_t lastSend = 0;
+  for (uint8_t stage = 0; stage < (pingPong ? 2 : 1); stage++) {
+    if (stage == 1) {
+      // The reverse wave goes out totalGroups delays after the first
+      while (now - lastSend < groups * groupDelay) now += 1 + random(20);
+      lastSend = now;
+    }
+    for (uint8_t k = 0; k < groups; k++) order[k] = WAVE_ORDERS[pattern][stage ? groups - 1 - k : k];
+
+    AngleCommandPacket packet = {};
+    packet.clearExtensions();
+    packet.setStartDelayStep(groupDelay);
+    for (uint8_t p = 0; p < MAX_PIXELS; p++) packet.setPixelStartSlot(p, groupOf(pattern, order, p));
+
+    for (uint8_t p = 0; p < MAX_PIXELS; p++) {
+      // playCommandedMotion() for a delayed wave member
+      uint32_t receivedAt = now + RADIO_LATENCY_MS;
+      uint32_t appliedAt = receivedAt + applyLatency();
+      KeyframeQueue queue;
+      Keyframe motion = {};
+      motion.colorDurationMs = 8000;
+      queue.clear(receivedAt + packet.getPixelStartDelayMs(p));
+      queue.push(motion, appliedAt);
+
+      Keyframe keyframe;
+      uint32_t startMs;
+      uint32_t t = appliedAt;
+      while (!queue.popDue(t, keyframe, startMs)) t += 16 + random(25);
+      start[stage][p] = startMs;
+    }
+  }
+}
+
+TEST_CASE(broadcastWaveKeepsGroupTiming) {
+  randomSeed(3);
+  WaveErrors perGroup;
+  WaveErrors broadcast;
+  uint16_t waves = 0;
+  for (uint8_t pattern = 0; pattern < WAVE_PATTERNS; pattern++) {
+    for (uint8_t pingPong = 0; pingPong < 2; pingPong++) {
+      for (uint8_t rep = 0; rep < 50; rep++) {
+        // baseGroupDelay in 2 ms steps, as the master draws it
+        uint32_t groupDelay = (75 + random(176)) * 2;
+        int32_t oldStart[2][MAX_PIXELS];
+        int32_t newStart[2][MAX_PIXELS];
+        playPerGroupPackets(pattern, pingPong, groupDelay, oldStart);
+        playBroadcast(pattern, pingPong, groupDelay, newStart);
+        waves++;
+
+        // Ideal: group k of stage s starts at s * groups * delay + k * delay
+        uint8_t groups = WAVE_GROUPS[pattern];
+        for (uint8_t stage = 0; stage < (pingPong ? 2 : 1); stage++) {
+          uint8_t order[8];
+          for (uint8_t k = 0; k < groups; k++) order[k] = WAVE_ORDERS[pattern][stage ? groups - 1 - k : k];
+          for (uint8_t p = 0; p < MAX_PIXELS; p++) {
+            int32_t ideal = RADIO_LATENCY_MS + stage * groups * groupDelay + groupOf(pattern, order, p) * groupDelay;
+            perGroup.worst[stage] = max(perGroup.worst[stage], abs(oldStart[stage][p] - ideal));
+            broadcast.worst[stage] = max(broadcast.worst[stage], abs(newStart[stage][p] - ideal));
+          }
+        }
+      }
+    }
+  }
+  REPORT("%u waves, worst group start error against k * baseGroupDelay:", waves);
+  REPORT("  first stage:   per-group packets %4d ms, broadcast %4d ms", perGroup.worst[0], broadcast.worst[0]);
+  REPORT("  ping-pong back: per-group packets %4d ms, broadcast %4d ms", perGroup.worst[1], broadcast.worst[1]);
+  // The broadcast's first stage only sees the apply latency group 0 also sees
+  CHECK(broadcast.worst[0] < 30);
+  CHECK(broadcast.worst[0] < perGroup.worst[0]);
+  CHECK(broadcast.worst[1] < perGroup.worst[1]);
+}
+
+TEST_CASE(startSlotsRoundTrip) {
+  AngleCommandPacket packet = {};
+  packet.clearExtensions();
+  packet.setStartDelayStep(251);  // Rounds to the 2 ms unit
+  for (uint8_t p = 0; p < MAX_PIXELS; p++) packet.setPixelStartSlot(p, p % 8);
+  uint8_t wrong = 0;
+  for (uint8_t p = 0; p < MAX_PIXELS; p++) {
+    if (packet.getPixelStartSlot(p) != p % 8) wrong++;
+    if (packet.getPixelStartDelayMs(p) != (p % 8) * 252) wrong++;
+  }
+  CHECK_EQ(wrong, 0);
+}